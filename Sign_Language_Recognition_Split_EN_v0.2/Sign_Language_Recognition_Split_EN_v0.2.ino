@@ -6,6 +6,15 @@
  * 2. Calculates statistical features (average, min, max, RMS, stddev, skew, kurtosis)
  * 3. Uses Edge Impulse exported model to recognize digital and special gestures
  * 4. Displays recognition results on serial monitor and LCD2004 display
+ * 5. Runs sampling, inference, LCD, LED and serial commands as cooperative tasks
+ * 6. Optionally runs inference only when the hand settles into a pose (USE_MOTION_TRIGGER)
+ * 7. Calibrates the flex sensors on request and keeps the calibration in flash
+ * 8. Optionally follows flex sensor drift during long sessions (USE_ADAPTIVE_CALIBRATION)
+ * 9. Recognizes and releases gestures from classifier scores smoothed over time, with hysteresis
+ * 10. Optionally answers clear poses from the mean finger bends before running the model (USE_CASCADE)
+ * 11. Optionally runs the classifier as an in-tree int8 network instead of the Edge Impulse SDK (USE_MLP_ENGINE)
+ * 12. Optionally runs a streaming temporal model on every sample alongside the classifier (USE_TEMPORAL_MODEL)
+ * 13. Optionally recognizes motion signs recorded with the 'enroll' command by dynamic time warping (USE_DTW_MATCHER)
  * 
  * Usage:
  * 1. Export Arduino library from Edge Impulse and add it to the project
@@ -22,14 +31,128 @@
 #include "sensors.h"
 #include "gestures.h"
 #include "ui.h"
+#include "led.h"
+#include "scheduler.h"
+#ifdef USE_ADC_SAMPLER
+#include "adc_sampler.h"
+#endif
+#ifdef USE_MOTION_TRIGGER
+#include "motion.h"
+#endif
+#ifdef USE_TEMPORAL_MODEL
+#include "temporal.h"
+#endif
+#ifdef USE_DTW_MATCHER
+#include "dtw.h"
+#endif
 #ifdef USE_LCD
 #include "lcd_ui.h"
 #endif
 
-// Time tracking
-unsigned long lastInferenceTime = 0;
-unsigned long lastSampleTime = 0;
-unsigned long lastLcdUpdateTime = 0;
+// Task periods not covered by config.h
+#define LED_TASK_INTERVAL_MS 10     // LED flash resolution
+#define SERIAL_TASK_INTERVAL_MS 20  // Serial command polling
+#define LCD_FLUSH_INTERVAL_MS 5     // One changed LCD line is written per run
+
+// Task priorities - lower values run first when several tasks are due
+#define PRIORITY_SAMPLING 0
+#define PRIORITY_INFERENCE 1
+#define PRIORITY_LED 2
+#define PRIORITY_SERIAL 3
+#define PRIORITY_LCD 4
+
+// Index of the inference task, released early when the hand settles
+int inferenceTaskIndex = -1;
+
+/**
+ * @brief Hand the newest sample to a running calibration, the temporal model, the motion sign matcher and the
+ *        motion detector, releasing inference when the hand settles
+ */
+void onSampleUpdated() {
+  updateCalibrationPrompts();
+  
+  #ifdef USE_TEMPORAL_MODEL
+  stepTemporalModel(channelValues);
+  #endif
+  
+  #ifdef USE_DTW_MATCHER
+  pushDtwSample(channelValues);
+  updateEnrollmentPrompts();
+  updateMotionSigns();
+  #endif
+  
+  #ifdef USE_MOTION_TRIGGER
+  if (updateMotionDetector()) {
+    releaseTask(inferenceTaskIndex);
+  }
+  #endif
+}
+
+void samplingTask() {
+  #ifdef USE_ADC_SAMPLER
+  // Consume every block the sampler has completed since the last run
+  const SampleBlock* block;
+  while ((block = adcSamplerPeek()) != NULL) {
+    for (int scan = 0; scan < SAMPLER_BLOCK_SCANS; scan++) {
+      int flexRawValues[5];
+      for (int i = 0; i < 5; i++) {
+        flexRawValues[i] = block->values[scan][i];
+      }
+      processFlexReadings(flexRawValues);
+      readImu();
+      updateDataWindow();
+      lastSampleTimeUs = block->timeUs + scan * (SAMPLING_INTERVAL_MS * 1000UL);
+      onSampleUpdated();
+    }
+    adcSamplerRelease();
+  }
+  #else
+  // Read all sensor data
+  readAllSensors();
+  
+  // Update the data window with new readings
+  updateDataWindow();
+  lastSampleTimeUs = micros();
+  onSampleUpdated();
+  #endif
+}
+
+void inferenceTask() {
+  // Only run inference if we have a full data window and no calibration is running
+  if (windowFilled && !calibrationActive()) {
+    #ifdef USE_MOTION_TRIGGER
+    // Skip while the hand moves or holds a pose that has already been classified
+    if (!motionWantsInference()) return;
+    #endif
+    
+    // Run inference and process results
+    runInference();
+  }
+}
+
+void ledTask() {
+  updateLed();
+}
+
+void serialTask() {
+  // Process commands from serial
+  pollSerialCommands();
+}
+
+#ifdef USE_LCD
+void lcdTask() {
+  // Expire temporary messages, then prepare the gesture screen
+  updateTempMessage();
+  if (windowFilled) {
+    updateLCD(lastGestureLabel());
+  }
+}
+
+void lcdFlushTask() {
+  // Write at most one line per run so the I2C transfer never delays sampling for long
+  commitBufferLine();
+}
+#endif
 
 void setup() {
   // Initialize serial communication
@@ -44,11 +167,20 @@ void setup() {
   initLCD();
   #endif
   
+  // Load the flex calibration before the first reading is converted
+  loadCalibration();
+  
+  #ifdef USE_DTW_MATCHER
+  // Load the enrolled motion signs
+  initDtwMatcher();
+  #endif
+  
   // Initialize sensors
   if (!initSensors()) {
     Serial.println("Sensor initialization failed!");
     #ifdef USE_LCD
     showTempMessage("ERROR:", "Sensor initialization", "failed!", "", 0);
+    commitBuffer();
     #endif
     while (1) {
       digitalWrite(LED_BUILTIN, HIGH);
@@ -65,6 +197,7 @@ void setup() {
   Serial.println("Initializing data window with initial samples...");
   #ifdef USE_LCD
   showTempMessage("Initializing...", "Collecting data", "samples for window", "", 1000);
+  commitBuffer();
   #endif
   
   for (int i = 0; i < WINDOW_SIZE; i++) {
@@ -81,49 +214,41 @@ void setup() {
     digitalWrite(LED_BUILTIN, LOW);
     delay(100);
   }
-}
-
-void loop() {
-  // Current time
-  unsigned long currentMillis = millis();
   
-  // Sample data at fixed intervals
-  if (currentMillis - lastSampleTime >= SAMPLING_INTERVAL_MS) {
-    lastSampleTime = currentMillis;
-    
-    // Read all sensor data
-    readAllSensors();
-    
-    // Update the data window with new readings
-    updateDataWindow();
+  #ifdef USE_ADC_SAMPLER
+  // Hand the flex sensors over to the timer/DMA sampler
+  if (!adcSamplerBegin(FLEX_PINS, SAMPLING_INTERVAL_MS * 1000UL)) {
+    Serial.println("ADC sampler could not be started!");
   }
+  #endif
   
-  // Periodically perform inference
-  if (currentMillis - lastInferenceTime >= INFERENCE_INTERVAL_MS) {
-    lastInferenceTime = currentMillis;
-    
-    // Prepare statistical features for the model
-    prepareFeatures();
-    
-    // Only run inference if we have a full data window
-    if (windowFilled) {
-      // Run inference and process results
-      runInference();
-      
-      #ifdef USE_LCD
-      // Update LCD with current gesture information
-      if (currentMillis - lastLcdUpdateTime >= LCD_UPDATE_INTERVAL_MS) {
-        lastLcdUpdateTime = currentMillis;
-        updateLCD(lastRecognizedGesture.c_str());
-      }
-      #endif
-    }
-  }
+  #ifdef USE_MOTION_TRIGGER
+  // Start out moving - the first inference runs once the hand is still
+  initMotionDetector();
+  #endif
   
-  // Process commands from serial
-  if (Serial.available()) {
-    String command = Serial.readStringUntil('\n');
-    command.trim();
-    handleCommand(command);
-  }
-}
\ No newline at end of file
+  #ifdef USE_TEMPORAL_MODEL
+  // Start the streaming state with the first sampled reading
+  initTemporalModel();
+  #endif
+  
+  // Register tasks and start scheduling
+  addTask("sampling", samplingTask, SAMPLING_INTERVAL_MS, PRIORITY_SAMPLING);
+  #ifdef USE_MOTION_TRIGGER
+  inferenceTaskIndex = addTask("inference", inferenceTask, SETTLED_INFERENCE_INTERVAL_MS, PRIORITY_INFERENCE);
+  #else
+  inferenceTaskIndex = addTask("inference", inferenceTask, INFERENCE_INTERVAL_MS, PRIORITY_INFERENCE);
+  #endif
+  addTask("led", ledTask, LED_TASK_INTERVAL_MS, PRIORITY_LED);
+  addTask("serial", serialTask, SERIAL_TASK_INTERVAL_MS, PRIORITY_SERIAL);
+  #ifdef USE_LCD
+  addTask("lcd", lcdTask, LCD_UPDATE_INTERVAL_MS, PRIORITY_LCD);
+  addTask("lcd-flush", lcdFlushTask, LCD_FLUSH_INTERVAL_MS, PRIORITY_LCD);
+  #endif
+  startScheduler();
+}
+
+void loop() {
+  // Run the most urgent due task
+  runScheduler();
+}
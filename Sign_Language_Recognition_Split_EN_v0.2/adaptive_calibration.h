@@ -0,0 +1,199 @@
+/*
+ * adaptive_calibration.h - Adaptive Flex Calibration
+ *
+ * Lets the straight and bent endpoints of each finger follow sensor drift
+ * (temperature, glove stretch) during long sessions instead of waiting for
+ * the next 'calibrate'. Two kinds of evidence move them, at bounded rates:
+ * a confident classification of the same pose twice in a row while all
+ * fingers are still says where each finger's straight or bent endpoint now
+ * reads (GESTURE_FINGERS_BENT), and readings held beyond an endpoint pull it
+ * slowly out toward them. Endpoints stay within DRIFT_LIMIT of the
+ * calibration they started from and CALIBRATION_MIN_RANGE apart. Bend
+ * tables are rebuilt from the inference task, never while sampling, and the
+ * calibration in use is then CALIBRATION_ADAPTED; adapted endpoints are not
+ * written to flash.
+ */
+
+#ifndef ADAPTIVE_CALIBRATION_H
+#define ADAPTIVE_CALIBRATION_H
+
+#include <Arduino.h>
+#include <Sign-Language-Glove_inferencing.h>
+#include "config.h"
+#include "calibration.h"
+
+// Drift estimator state and counters
+struct DriftTracker {
+  uint16_t generation;        // calibrationGeneration the endpoints started from
+  bool primed;                // rawMean holds a reading
+  float rawMean[5];           // Smoothed raw reading of each finger
+  float rawActivity[5];       // Smoothed deviation of the readings from rawMean
+  float baseStraight[5];      // Calibration the endpoints started from
+  float baseBent[5];
+  float straight[5];          // Current endpoints, with sub-step resolution
+  float bent[5];
+  float tableStraight[5];     // Endpoints the bend tables were last built with
+  float tableBent[5];
+  int8_t labelPose[EI_CLASSIFIER_LABEL_COUNT];  // GESTURE_FINGERS_BENT row of each classifier label, -1 if none
+  bool posesMapped;           // labelPose is filled in
+
+  unsigned long poseUpdates;      // Classifications learned from
+  unsigned long extremeSamples;   // Samples that pulled an endpoint toward a reading beyond it
+  unsigned long tableRebuilds;    // Bend tables rebuilt for a moved endpoint
+};
+
+extern DriftTracker drift;
+
+/**
+ * @brief Feed one set of raw flex readings to the estimator
+ * @note Called for every sample; only moves endpoints, the bend tables follow in adaptCalibration()
+ */
+void trackFlexDrift(const int* flexRawValues);
+
+/**
+ * @brief Learn from a classification and rebuild the bend tables of fingers whose endpoints moved
+ * @param label Index of the top label, or -1 if no gesture was confident enough to be reported
+ * @param confidence Score of the top label
+ * @param stableCount Consecutive inferences that produced this label
+ */
+void adaptCalibration(int label, float confidence, int stableCount);
+
+/**
+ * @brief Print the adapted endpoints, their drift from the starting calibration and the update counters
+ */
+void printDriftStats();
+
+// Implementation section ---------------------------------
+
+DriftTracker drift;
+
+/**
+ * @brief Start over from the calibration in use
+ */
+void rebaseDriftTracker() {
+  drift.generation = calibrationGeneration;
+  for (int i = 0; i < 5; i++) {
+    drift.baseStraight[i] = drift.straight[i] = drift.tableStraight[i] = flexCalibration.straightAdc[i];
+    drift.baseBent[i] = drift.bent[i] = drift.tableBent[i] = flexCalibration.bentAdc[i];
+  }
+}
+
+/**
+ * @brief Move an endpoint, keeping it within DRIFT_LIMIT of its base and CALIBRATION_MIN_RANGE from the other endpoint
+ */
+void moveEndpoint(float* endpoint, float base, float other, float delta) {
+  float moved = constrain(*endpoint + delta, base - DRIFT_LIMIT, base + DRIFT_LIMIT);
+  if (fabsf(other - moved) >= CALIBRATION_MIN_RANGE) {
+    *endpoint = moved;
+  }
+}
+
+void trackFlexDrift(const int* flexRawValues) {
+  if (drift.generation != calibrationGeneration) {
+    rebaseDriftTracker();
+  }
+
+  for (int i = 0; i < 5; i++) {
+    float reading = flexRawValues[i];
+    if (!drift.primed) {
+      drift.rawMean[i] = reading;
+      drift.rawActivity[i] = 0;
+      continue;
+    }
+    float deviation = reading - drift.rawMean[i];
+    drift.rawMean[i] += DRIFT_SMOOTHING * deviation;
+    drift.rawActivity[i] += DRIFT_SMOOTHING * (fabsf(deviation) - drift.rawActivity[i]);
+    if (drift.rawActivity[i] >= DRIFT_STILL_ADC) continue;
+
+    // A still finger reading beyond an endpoint pulls it out, one small step per sample
+    float bendDirection = drift.bent[i] > drift.straight[i] ? 1.0F : -1.0F;
+    if ((drift.straight[i] - drift.rawMean[i]) * bendDirection > DRIFT_EXTREME_MARGIN) {
+      moveEndpoint(&drift.straight[i], drift.baseStraight[i], drift.bent[i], -bendDirection * DRIFT_EXTREME_STEP);
+      drift.extremeSamples++;
+    } else if ((drift.rawMean[i] - drift.bent[i]) * bendDirection > DRIFT_EXTREME_MARGIN) {
+      moveEndpoint(&drift.bent[i], drift.baseBent[i], drift.straight[i], bendDirection * DRIFT_EXTREME_STEP);
+      drift.extremeSamples++;
+    }
+  }
+  drift.primed = true;
+}
+
+/**
+ * @brief Find the GESTURE_FINGERS_BENT row of each classifier label, once - the model lists its labels in its
+ *        own order
+ */
+void mapLabelPoses() {
+  for (int label = 0; label < EI_CLASSIFIER_LABEL_COUNT; label++) {
+    drift.labelPose[label] = -1;
+    for (size_t g = 0; g < sizeof(GESTURE_LABELS) / sizeof(GESTURE_LABELS[0]); g++) {
+      if (strcmp(ei_classifier_inferencing_categories[label], GESTURE_LABELS[g]) == 0) drift.labelPose[label] = (int8_t)g;
+    }
+  }
+  drift.posesMapped = true;
+}
+
+/**
+ * @brief Move each finger's endpoint for the pose toward its smoothed reading
+ * @param label Index of the classifier label
+ * @return Whether the pose was learned from
+ */
+bool learnPose(int label) {
+  if (!drift.posesMapped) mapLabelPoses();
+  int gesture = drift.labelPose[label];
+  if (gesture < 0) return false;
+
+  // Only a held pose tells where the endpoints are - not one the fingers are moving into
+  for (int i = 0; i < 5; i++) {
+    if (drift.rawActivity[i] >= DRIFT_STILL_ADC) return false;
+  }
+
+  for (int i = 0; i < 5; i++) {
+    bool bent = GESTURE_FINGERS_BENT[gesture][i];
+    float* endpoint = bent ? &drift.bent[i] : &drift.straight[i];
+    float delta = constrain((drift.rawMean[i] - *endpoint) * DRIFT_RATE, -DRIFT_MAX_STEP, DRIFT_MAX_STEP);
+    moveEndpoint(endpoint, bent ? drift.baseBent[i] : drift.baseStraight[i],
+                 bent ? drift.straight[i] : drift.bent[i], delta);
+  }
+  drift.poseUpdates++;
+  return true;
+}
+
+void adaptCalibration(int label, float confidence, int stableCount) {
+  if (drift.generation != calibrationGeneration || !drift.primed) return;
+
+  if (label >= 0 && confidence >= DRIFT_CONFIDENCE && stableCount >= 2) {
+    learnPose(label);
+  }
+
+  // Rebuild the tables of fingers whose endpoints have moved far enough
+  for (int i = 0; i < 5; i++) {
+    if (fabsf(drift.straight[i] - drift.tableStraight[i]) < DRIFT_REBUILD_STEP &&
+        fabsf(drift.bent[i] - drift.tableBent[i]) < DRIFT_REBUILD_STEP) continue;
+
+    buildBendTable(drift.straight[i], drift.bent[i], flexCalibration.bendQ15[i]);
+    flexCalibration.straightAdc[i] = (int16_t)lroundf(drift.straight[i]);
+    flexCalibration.bentAdc[i] = (int16_t)lroundf(drift.bent[i]);
+    drift.tableStraight[i] = drift.straight[i];
+    drift.tableBent[i] = drift.bent[i];
+    drift.tableRebuilds++;
+    flexCalibration.source = CALIBRATION_ADAPTED;
+  }
+}
+
+void printDriftStats() {
+  const char* fingerNames[] = {"Thumb", "Index", "Middle", "Ring", "Pinky"};
+  char line[80];
+
+  Serial.println("Adaptive calibration (drift from the starting values):");
+  for (int i = 0; i < 5; i++) {
+    snprintf(line, sizeof(line), "%s: straight=%.1f (%+.1f), bent=%.1f (%+.1f)", fingerNames[i],
+             drift.straight[i], drift.straight[i] - drift.baseStraight[i],
+             drift.bent[i], drift.bent[i] - drift.baseBent[i]);
+    Serial.println(line);
+  }
+  snprintf(line, sizeof(line), "Learned poses: %lu, extreme samples: %lu, table rebuilds: %lu",
+           drift.poseUpdates, drift.extremeSamples, drift.tableRebuilds);
+  Serial.println(line);
+}
+
+#endif // ADAPTIVE_CALIBRATION_H
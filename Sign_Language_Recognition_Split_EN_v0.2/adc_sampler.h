@@ -0,0 +1,317 @@
+/*
+ * adc_sampler.h - Timer/DMA Flex Sensor Sampling
+ *
+ * Scans the five flex sensor channels at a fixed period independent of
+ * loop() timing. On the Nano 33 BLE a hardware timer triggers the SAADC
+ * through PPI and EasyDMA writes each block of scans straight into a slot of
+ * a lock-free single-producer/single-consumer ring, while the next slot is
+ * already latched (double buffering). On the host build a thread stands in
+ * for the hardware, producing blocks from the scripted ADC on the virtual clock.
+ *
+ * While the sampler runs it owns the ADC - use readFlexRaw() instead of analogRead().
+ */
+
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#if defined(NRF52840_XXAA)
+#define SAMPLER_USE_SAADC
+#else
+#include <thread>
+#endif
+
+#define SAMPLER_CHANNELS 5
+#define SAMPLER_BLOCK_SCANS 1      // Scans of all channels per DMA block
+#define SAMPLER_RING_BLOCKS 8      // Ring capacity in blocks
+
+// One block of scans, written by the producer and read in place by the consumer
+struct SampleBlock {
+  int16_t values[SAMPLER_BLOCK_SCANS][SAMPLER_CHANNELS];
+  uint32_t sequence;   // Index of the first scan since adcSamplerBegin()
+  uint32_t timeUs;     // Time of the first scan, derived from the sampling timer
+};
+
+/**
+ * @brief Start periodic scanning of the given analog pins
+ * @param pins SAMPLER_CHANNELS analog pins, in channel order
+ * @param periodUs Scan period in microseconds
+ * @return Whether the sampler could be started
+ */
+bool adcSamplerBegin(const int* pins, unsigned long periodUs);
+
+/**
+ * @brief Stop scanning
+ */
+void adcSamplerEnd();
+
+/**
+ * @brief Oldest complete block, or NULL if none is ready
+ * @note The block stays valid until adcSamplerRelease()
+ */
+const SampleBlock* adcSamplerPeek();
+
+/**
+ * @brief Hand the block returned by adcSamplerPeek() back to the producer
+ */
+void adcSamplerRelease();
+
+/**
+ * @brief Number of blocks dropped because the ring was full
+ */
+uint32_t adcSamplerOverruns();
+
+// Implementation section ---------------------------------
+
+SampleBlock samplerRing[SAMPLER_RING_BLOCKS];
+
+// Ring positions count up forever; the slot is position % SAMPLER_RING_BLOCKS
+std::atomic<uint32_t> samplerHead(0);   // Blocks published by the producer
+std::atomic<uint32_t> samplerTail(0);   // Blocks released by the consumer
+volatile uint32_t samplerOverrunCount = 0;
+
+unsigned long samplerPeriodUs = 0;
+uint32_t samplerStartUs = 0;
+std::atomic<uint32_t> samplerScanCount(0); // Scans completed, including dropped ones
+uint32_t samplerNextPosition = 0;       // Next ring position to hand to the producer
+
+const SampleBlock* adcSamplerPeek() {
+  uint32_t tail = samplerTail.load(std::memory_order_relaxed);
+  if (tail == samplerHead.load(std::memory_order_acquire)) return NULL;
+  return &samplerRing[tail % SAMPLER_RING_BLOCKS];
+}
+
+void adcSamplerRelease() {
+  uint32_t tail = samplerTail.load(std::memory_order_relaxed);
+  samplerTail.store(tail + 1, std::memory_order_release);
+}
+
+uint32_t adcSamplerOverruns() {
+  return samplerOverrunCount;
+}
+
+/**
+ * @brief Claim the next free ring position for the producer
+ * @return Ring position, or -1 if the ring is full
+ */
+int32_t samplerClaimPosition() {
+  if (samplerNextPosition - samplerTail.load(std::memory_order_acquire) >= SAMPLER_RING_BLOCKS) {
+    samplerOverrunCount++;
+    return -1;
+  }
+  return (int32_t)samplerNextPosition++;
+}
+
+/**
+ * @brief Stamp a filled block and make it visible to the consumer
+ */
+void samplerPublish(int32_t position) {
+  if (position >= 0) {
+    SampleBlock& block = samplerRing[position % SAMPLER_RING_BLOCKS];
+    block.sequence = samplerScanCount.load(std::memory_order_relaxed);
+    block.timeUs = samplerStartUs + block.sequence * samplerPeriodUs;
+    samplerHead.store((uint32_t)position + 1, std::memory_order_release);
+  }
+  samplerScanCount.fetch_add(SAMPLER_BLOCK_SCANS, std::memory_order_release);
+}
+
+void samplerResetRing() {
+  samplerHead.store(0);
+  samplerTail.store(0);
+  samplerOverrunCount = 0;
+  samplerScanCount.store(0);
+  samplerNextPosition = 0;
+}
+
+#if defined(SAMPLER_USE_SAADC)
+
+#define SAMPLER_TIMER NRF_TIMER4
+#define SAMPLER_PPI_CHANNEL 15
+
+// DMA target when the ring is full - its contents are discarded
+int16_t samplerScratch[SAMPLER_BLOCK_SCANS * SAMPLER_CHANNELS];
+
+// Ring positions the SAADC is filling now and has latched for the next block (-1 = scratch)
+volatile int32_t samplerFilling = -1;
+volatile int32_t samplerQueued = -1;
+
+/**
+ * @brief SAADC positive input for a Nano 33 BLE analog pin
+ */
+uint32_t samplerInputForPin(int pin) {
+  switch (digitalPinToPinName(pin)) {
+    case P0_2: return SAADC_CH_PSELP_PSELP_AnalogInput0;
+    case P0_3: return SAADC_CH_PSELP_PSELP_AnalogInput1;
+    case P0_4: return SAADC_CH_PSELP_PSELP_AnalogInput2;
+    case P0_5: return SAADC_CH_PSELP_PSELP_AnalogInput3;
+    case P0_28: return SAADC_CH_PSELP_PSELP_AnalogInput4;
+    case P0_29: return SAADC_CH_PSELP_PSELP_AnalogInput5;
+    case P0_30: return SAADC_CH_PSELP_PSELP_AnalogInput6;
+    case P0_31: return SAADC_CH_PSELP_PSELP_AnalogInput7;
+    default: return SAADC_CH_PSELP_PSELP_NC;
+  }
+}
+
+/**
+ * @brief Point the SAADC at the next free ring slot (or the scratch buffer)
+ */
+void samplerQueueNext() {
+  samplerQueued = samplerClaimPosition();
+  if (samplerQueued >= 0) {
+    NRF_SAADC->RESULT.PTR = (uint32_t)samplerRing[samplerQueued % SAMPLER_RING_BLOCKS].values;
+  } else {
+    NRF_SAADC->RESULT.PTR = (uint32_t)samplerScratch;
+  }
+}
+
+void samplerSaadcIrq() {
+  // Block complete - publish it (END_START has already restarted the DMA)
+  if (NRF_SAADC->EVENTS_END) {
+    NRF_SAADC->EVENTS_END = 0;
+    samplerPublish(samplerFilling);
+  }
+
+  // DMA now fills the latched slot - latch the one after it
+  if (NRF_SAADC->EVENTS_STARTED) {
+    NRF_SAADC->EVENTS_STARTED = 0;
+    samplerFilling = samplerQueued;
+    samplerQueueNext();
+  }
+}
+
+bool adcSamplerBegin(const int* pins, unsigned long periodUs) {
+  samplerResetRing();
+  samplerPeriodUs = periodUs;
+
+  // Same range as analogRead(): FLEX_ADC_BITS, gain 1/4 against VDD/4
+  NRF_SAADC->ENABLE = 0;
+  for (int i = 0; i < 8; i++) {
+    NRF_SAADC->CH[i].PSELP = SAADC_CH_PSELP_PSELP_NC;
+    NRF_SAADC->CH[i].PSELN = SAADC_CH_PSELN_PSELN_NC;
+  }
+  for (int i = 0; i < SAMPLER_CHANNELS; i++) {
+    uint32_t input = samplerInputForPin(pins[i]);
+    if (input == SAADC_CH_PSELP_PSELP_NC) return false;
+    NRF_SAADC->CH[i].CONFIG = (SAADC_CH_CONFIG_GAIN_Gain1_4 << SAADC_CH_CONFIG_GAIN_Pos) |
+                              (SAADC_CH_CONFIG_REFSEL_VDD1_4 << SAADC_CH_CONFIG_REFSEL_Pos) |
+                              (SAADC_CH_CONFIG_TACQ_10us << SAADC_CH_CONFIG_TACQ_Pos) |
+                              (SAADC_CH_CONFIG_MODE_SE << SAADC_CH_CONFIG_MODE_Pos);
+    NRF_SAADC->CH[i].PSELP = input;
+  }
+  NRF_SAADC->RESOLUTION = FLEX_ADC_BITS == 12 ? SAADC_RESOLUTION_VAL_12bit : SAADC_RESOLUTION_VAL_10bit;
+  NRF_SAADC->OVERSAMPLE = SAADC_OVERSAMPLE_OVERSAMPLE_Bypass;
+  NRF_SAADC->SAMPLERATE = SAADC_SAMPLERATE_MODE_Task << SAADC_SAMPLERATE_MODE_Pos;
+  NRF_SAADC->RESULT.MAXCNT = SAMPLER_BLOCK_SCANS * SAMPLER_CHANNELS;
+  NRF_SAADC->SHORTS = SAADC_SHORTS_END_START_Msk;
+  NRF_SAADC->INTENSET = SAADC_INTENSET_END_Msk | SAADC_INTENSET_STARTED_Msk;
+  NVIC_SetVector(SAADC_IRQn, (uint32_t)&samplerSaadcIrq);
+  NVIC_SetPriority(SAADC_IRQn, 2);
+  NVIC_EnableIRQ(SAADC_IRQn);
+  NRF_SAADC->ENABLE = 1;
+
+  // 1 MHz timer, compare 0 fires every period and clears the timer
+  SAMPLER_TIMER->TASKS_STOP = 1;
+  SAMPLER_TIMER->MODE = TIMER_MODE_MODE_Timer;
+  SAMPLER_TIMER->BITMODE = TIMER_BITMODE_BITMODE_32Bit;
+  SAMPLER_TIMER->PRESCALER = 4;
+  SAMPLER_TIMER->CC[0] = periodUs;
+  SAMPLER_TIMER->SHORTS = TIMER_SHORTS_COMPARE0_CLEAR_Msk;
+  SAMPLER_TIMER->TASKS_CLEAR = 1;
+
+  // Each compare event triggers one scan of all enabled channels
+  NRF_PPI->CH[SAMPLER_PPI_CHANNEL].EEP = (uint32_t)&SAMPLER_TIMER->EVENTS_COMPARE[0];
+  NRF_PPI->CH[SAMPLER_PPI_CHANNEL].TEP = (uint32_t)&NRF_SAADC->TASKS_SAMPLE;
+  NRF_PPI->CHENSET = 1UL << SAMPLER_PPI_CHANNEL;
+
+  // Latch the first slot and start the DMA; STARTED latches the second
+  samplerFilling = -1;
+  samplerQueueNext();
+  NRF_SAADC->TASKS_START = 1;
+
+  samplerStartUs = micros() + periodUs;
+  SAMPLER_TIMER->TASKS_START = 1;
+  return true;
+}
+
+void adcSamplerEnd() {
+  SAMPLER_TIMER->TASKS_STOP = 1;
+  NRF_PPI->CHENCLR = 1UL << SAMPLER_PPI_CHANNEL;
+  NRF_SAADC->TASKS_STOP = 1;
+  NVIC_DisableIRQ(SAADC_IRQn);
+  NRF_SAADC->INTENCLR = SAADC_INTENCLR_END_Msk | SAADC_INTENCLR_STARTED_Msk;
+  NRF_SAADC->SHORTS = 0;
+  NRF_SAADC->ENABLE = 0;
+}
+
+#else // Host stand-in
+
+int samplerPins[SAMPLER_CHANNELS];
+std::atomic<bool> samplerRunning(false);
+std::thread samplerThread;
+
+/**
+ * @brief Producer thread - emits each block once the virtual clock has passed its last scan
+ */
+void samplerThreadMain() {
+  while (samplerRunning.load()) {
+    uint32_t scans = samplerScanCount.load(std::memory_order_relaxed);
+    unsigned long long blockEndUs = samplerStartUs +
+      (unsigned long long)(scans + SAMPLER_BLOCK_SCANS - 1) * samplerPeriodUs;
+    if (hostTimeUs.load() < blockEndUs) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    int32_t position = samplerClaimPosition();
+    if (position >= 0) {
+      SampleBlock& block = samplerRing[position % SAMPLER_RING_BLOCKS];
+      for (int scan = 0; scan < SAMPLER_BLOCK_SCANS; scan++) {
+        unsigned long scanUs = samplerStartUs + (scans + scan) * samplerPeriodUs;
+        for (int ch = 0; ch < SAMPLER_CHANNELS; ch++) {
+          int pin = samplerPins[ch];
+          block.values[scan][ch] = hostAdcScript ? hostAdcScript(pin, scanUs) : hostAnalogValues[pin];
+        }
+      }
+    }
+    samplerPublish(position);
+  }
+}
+
+bool adcSamplerBegin(const int* pins, unsigned long periodUs) {
+  adcSamplerEnd();
+  samplerResetRing();
+  samplerPeriodUs = periodUs;
+  for (int ch = 0; ch < SAMPLER_CHANNELS; ch++) {
+    if (pins[ch] < 0 || pins[ch] >= HOST_PIN_COUNT) return false;
+    samplerPins[ch] = pins[ch];
+  }
+  samplerStartUs = micros() + periodUs;
+  samplerRunning.store(true);
+  samplerThread = std::thread(samplerThreadMain);
+  return true;
+}
+
+/**
+ * @brief Wait until the producer thread has caught up with the virtual clock
+ * @note Host only - lets a fast-forwarding virtual clock behave like real time
+ */
+void adcSamplerHostSync() {
+  while (samplerRunning.load()) {
+    uint32_t scans = samplerScanCount.load(std::memory_order_acquire);
+    unsigned long long blockEndUs = samplerStartUs +
+      (unsigned long long)(scans + SAMPLER_BLOCK_SCANS - 1) * samplerPeriodUs;
+    if (hostTimeUs.load() < blockEndUs) return;
+    std::this_thread::yield();
+  }
+}
+
+void adcSamplerEnd() {
+  samplerRunning.store(false);
+  if (samplerThread.joinable()) samplerThread.join();
+}
+
+#endif
+
+#endif // ADC_SAMPLER_H
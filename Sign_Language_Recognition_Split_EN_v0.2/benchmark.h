@@ -0,0 +1,426 @@
+/*
+ * benchmark.h - Hot Path Microbenchmarks
+ *
+ * Measures the cost of each stage between the flex sensors and the recognized
+ * gesture, and how much of the SAMPLING_INTERVAL_MS budget a loop() iteration
+ * spends in each. On the Nano 33 BLE the Cortex-M4 DWT cycle counter is used;
+ * on the host build the time stamp counter is used instead. The stages of the
+ * cascade, the int8 network, the temporal model and the motion sign matcher
+ * are timed only when the sketch is built with them.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+#include <Sign-Language-Glove_inferencing.h>
+#include "config.h"
+#include "sensors.h"
+#include "lcd_ui.h"
+#ifdef USE_CASCADE
+#include "cascade.h"
+#endif
+#ifdef USE_MLP_ENGINE
+#include "mlp_engine.h"
+#endif
+#ifdef USE_TEMPORAL_MODEL
+#include "temporal.h"
+#endif
+#ifdef USE_DTW_MATCHER
+#include "dtw.h"
+#endif
+
+#if defined(__arm__)
+#define BENCH_USE_DWT
+#else
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_USE_TSC
+#endif
+#endif
+
+#define BENCH_STAGE_COUNT 20     // Stages with every optional one built in
+#define BENCH_REPETITIONS 5     // Timed batches per stage, the fastest is reported
+
+// Timing result for one stage
+struct BenchResult {
+  const char* name;
+  const char* note;         // Why the stage is left out of the loop() budget, NULL if loop() calls it
+  float callsPerSample;     // Calls per SAMPLING_INTERVAL_MS in the running sketch
+  unsigned long iterations; // Calls measured
+  float cyclesPerCall;
+  float nsPerCall;
+};
+
+extern BenchResult benchResults[BENCH_STAGE_COUNT];
+extern int benchResultCount;  // Stages timed by the last runBenchmarks()
+
+/**
+ * @brief Start the cycle counter and determine its frequency
+ */
+void initBenchTimer();
+
+/**
+ * @brief Current value of the cycle counter
+ */
+uint64_t benchCycles();
+
+/**
+ * @brief Run all stage benchmarks, each for at least minTimeUs
+ * @note Pushes benchmark samples through the live data window, and with USE_DTW_MATCHER replaces the motion sign templates in RAM
+ *       until they are loaded from flash again at the end
+ */
+void runBenchmarks(unsigned long minTimeUs);
+
+/**
+ * @brief Print per-stage cost and the per-loop() budget breakdown
+ */
+void printBenchmarkReport();
+
+// Implementation section ---------------------------------
+
+BenchResult benchResults[BENCH_STAGE_COUNT];
+int benchResultCount = 0;
+
+// Counter frequency in cycles per microsecond
+float benchCyclesPerUs = 1;
+
+// Keeps benchmarked results alive so the calls are not optimized away
+volatile float benchSink = 0;
+
+/**
+ * @brief Bend conversion computed per sample with constrain() and an integer map(), for comparison with the lookup table
+ */
+float bendPercentageMap(int adcValue, int straightAdc, int bentAdc) {
+  adcValue = constrain(adcValue, min(straightAdc, bentAdc), max(straightAdc, bentAdc));
+  float bendPercentage = map(adcValue, straightAdc, bentAdc, 0, 100);
+  return constrain(bendPercentage, 0, 100);
+}
+
+/**
+ * @brief Resistance-model bend computed per sample with the float divisions of Basic.ino, for comparison with the lookup table
+ */
+float bendPercentageResistance(int adcValue, int straightAdc, int bentAdc) {
+  float straight = flexResistance(straightAdc);
+  float bendPercentage = (flexResistance(adcValue) - straight) * 100.0F / (flexResistance(bentAdc) - straight);
+  return constrain(bendPercentage, 0.0F, 100.0F);
+}
+
+// Window rows for the statistics kernels, independent of the live pipeline configuration
+alignas(32) float benchWindow[WINDOW_STRIDE];
+alignas(32) int16_t benchWindowQ15[WINDOW_STRIDE];
+
+// Flex filter chain for the benchmark, separate from the live one
+FLEX_FILTER benchFilter;
+
+// Held window and its running statistics for the early recomputation worst case
+alignas(32) float benchHeldWindow[WINDOW_STRIDE];
+RunningStats benchHeldStats;
+
+void initBenchTimer() {
+#if defined(BENCH_USE_DWT)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  benchCyclesPerUs = SystemCoreClock / 1000000.0F;
+#elif defined(BENCH_USE_TSC)
+  // Calibrate the TSC against the steady clock
+  auto start = std::chrono::steady_clock::now();
+  uint64_t startCycles = __rdtsc();
+  while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(20)) {
+  }
+  uint64_t cycles = __rdtsc() - startCycles;
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  benchCyclesPerUs = cycles / us;
+#else
+  benchCyclesPerUs = 1000;
+#endif
+}
+
+uint64_t benchCycles() {
+#if defined(BENCH_USE_DWT)
+  return DWT->CYCCNT;
+#elif defined(BENCH_USE_TSC)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @brief Cycles elapsed since start, allowing for the 32-bit DWT counter wrapping
+ */
+uint64_t benchElapsed(uint64_t start) {
+#if defined(BENCH_USE_DWT)
+  return (uint32_t)((uint32_t)benchCycles() - (uint32_t)start);
+#else
+  return benchCycles() - start;
+#endif
+}
+
+/**
+ * @brief Time a stage, doubling the batch size until a batch takes at least minTimeUs, and add it to benchResults
+ * @note The fastest of BENCH_REPETITIONS batches is kept to reject interrupts and preemption
+ */
+template <class Stage>
+void benchStage(const char* name, const char* note, float callsPerSample,
+                unsigned long minTimeUs, Stage stage) {
+  uint64_t minCycles = (uint64_t)(minTimeUs * benchCyclesPerUs);
+  unsigned long batch = 1;
+  uint64_t elapsed = 0;
+
+  while (true) {
+    uint64_t start = benchCycles();
+    for (unsigned long i = 0; i < batch; i++) {
+      stage(i);
+    }
+    elapsed = benchElapsed(start);
+    if (elapsed >= minCycles || batch >= (1UL << 24)) break;
+    batch *= 2;
+  }
+
+  for (int rep = 1; rep < BENCH_REPETITIONS; rep++) {
+    uint64_t start = benchCycles();
+    for (unsigned long i = 0; i < batch; i++) {
+      stage(i);
+    }
+    uint64_t repElapsed = benchElapsed(start);
+    if (repElapsed < elapsed) elapsed = repElapsed;
+  }
+
+  BenchResult& r = benchResults[benchResultCount++];
+  r.name = name;
+  r.note = note;
+  r.callsPerSample = callsPerSample;
+  r.iterations = batch;
+  r.cyclesPerCall = (float)elapsed / batch;
+  r.nsPerCall = r.cyclesPerCall * 1000.0F / benchCyclesPerUs;
+}
+
+void runBenchmarks(unsigned long minTimeUs) {
+  initBenchTimer();
+  benchResultCount = 0;
+
+  // How often each stage runs per sample period in loop()
+  const float perSample = 1.0F;
+  const float perInference = (float)SAMPLING_INTERVAL_MS / INFERENCE_INTERVAL_MS;
+
+  // Bend-like test pattern for the statistics kernels
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    benchWindow[i] = (float)((i * 37) % 101);
+    benchWindowQ15[i] = toQ15(benchWindow[i], CHANNEL_SCALE_SHIFT[CHANNEL_THUMB]);
+  }
+
+  benchStage("readAllSensors", NULL, perSample, minTimeUs, [](unsigned long) {
+    readAllSensors();
+  });
+
+  benchStage("calculateBendPercentage", "in readAllSensors", 0, minTimeUs, [](unsigned long i) {
+    int adc = flexCalibration.bentAdc[i % 5] + (int)(i % 128);
+    benchSink = calculateBendPercentage(flexCalibration.bendQ15[i % 5], adc);
+  });
+
+  benchStage("bendPercentageMap", "constrain/map() reference", 0, minTimeUs, [](unsigned long i) {
+    int adc = flexCalibration.bentAdc[i % 5] + (int)(i % 128);
+    benchSink = bendPercentageMap(adc, flexCalibration.straightAdc[i % 5], flexCalibration.bentAdc[i % 5]);
+  });
+
+  benchStage("bendPercentageResistance", "float resistance reference", 0, minTimeUs, [](unsigned long i) {
+    int adc = flexCalibration.bentAdc[i % 5] + (int)(i % 128);
+    benchSink = bendPercentageResistance(adc, flexCalibration.straightAdc[i % 5], flexCalibration.bentAdc[i % 5]);
+  });
+
+  benchStage("flexFilter.process", "in readAllSensors", 0, minTimeUs, [](unsigned long i) {
+    float values[5];
+    for (int finger = 0; finger < 5; finger++) values[finger] = (float)((i + finger * 29) & 127);
+    benchFilter.process(values);
+    benchSink = values[i % 5];
+  });
+
+  benchStage("updateDataWindow", NULL, perSample, minTimeUs, [](unsigned long i) {
+    filteredFlexValues[i % 5] = (float)(i % 101);
+    updateDataWindow();
+  });
+
+  // A held window a whole unit from its shift before every sample, as when the filter settles on a new pose
+  // - the early recomputation's trigger, which STATS_REBASE_INTERVAL limits
+  for (int i = 0; i < WINDOW_SIZE; i++) benchHeldWindow[i] = 50.0F;
+  initRunningStats(&benchHeldStats, benchHeldWindow);
+  for (uint32_t seq = 0; seq < WINDOW_SIZE; seq++) pushRunningStats(&benchHeldStats, seq, 50.0F);
+
+  benchStage("pushRunningStats_held", "early recomputation worst case", 0, minTimeUs, [](unsigned long) {
+    static uint32_t seq = WINDOW_SIZE;
+    benchHeldStats.shift = 49.0;
+    benchHeldStats.sum = benchHeldStats.sum2 = benchHeldStats.sum3 = benchHeldStats.sum4 = WINDOW_SIZE;
+    pushRunningStats(&benchHeldStats, seq++, 50.0F);
+    benchSink = (float)benchHeldStats.sum;
+  });
+
+  benchStage("calculateStatistics", "two-pass reference", 0, minTimeUs, [](unsigned long i) {
+    float stats[STATS_PER_SENSOR];
+    calculateStatistics(benchWindow, stats);
+    benchSink = stats[i % STATS_PER_SENSOR];
+  });
+
+  benchStage("calculateStatisticsSimd", WINDOW_SIMD_NAME " kernels", 0, minTimeUs, [](unsigned long i) {
+    float stats[STATS_PER_SENSOR];
+    calculateStatisticsSimd(benchWindow, stats);
+    benchSink = stats[i % STATS_PER_SENSOR];
+  });
+
+  benchStage("calculateStatisticsQ15", "fixed-point kernel", 0, minTimeUs, [](unsigned long i) {
+    int32_t stats[STATS_PER_SENSOR];
+    calculateStatisticsQ15(benchWindowQ15, CHANNEL_SCALE_SHIFT[CHANNEL_THUMB], stats);
+    benchSink = stats[i % STATS_PER_SENSOR];
+  });
+
+  benchStage("get_signal_data", "in run_classifier", 0, minTimeUs, [](unsigned long i) {
+    float input[FEATURE_COUNT];
+    get_signal_data(0, FEATURE_COUNT, input);
+    benchSink = input[i % FEATURE_COUNT];
+  });
+
+#ifdef USE_CASCADE
+  benchStage("classifyPose", "cascade first stage", 0, minTimeUs, [](unsigned long i) {
+    float bends[5];
+    for (int finger = 0; finger < 5; finger++) bends[finger] = getChannelMean(finger);
+    bends[i % 5] += (float)(i % 64);
+    benchSink = (float)classifyPose(bends);
+  });
+#endif
+
+  benchStage("run_classifier", NULL, perInference, minTimeUs, [](unsigned long) {
+    signal_t signal;
+    signal.total_length = FEATURE_COUNT;
+    signal.get_data = &get_signal_data;
+    ei_impulse_result_t result;
+    run_classifier(&signal, &result, false);
+    benchSink = result.classification[0].value;
+  });
+
+#ifdef USE_MLP_ENGINE
+  benchStage("runMlpClassifier", "in-tree int8 network", 0, minTimeUs, [](unsigned long) {
+    signal_t signal;
+    signal.total_length = FEATURE_COUNT;
+    signal.get_data = &get_signal_data;
+    ei_impulse_result_t result;
+    runMlpClassifier(&signal, &result);
+    benchSink = result.classification[0].value;
+  });
+#endif
+
+#ifdef USE_TEMPORAL_MODEL
+  benchStage("stepTemporalModel", "temporal model, every sample", 0, minTimeUs, [](unsigned long) {
+    stepTemporalModel(channelValues);
+    benchSink = temporal.scores[0];
+  });
+
+  benchStage("temporalWindowScores", "recomputed without state", 0, minTimeUs, [](unsigned long i) {
+    static float samples[TEMPORAL_RECEPTIVE_FIELD * TEMPORAL_INPUT_COUNT];
+    samples[i % (TEMPORAL_RECEPTIVE_FIELD * TEMPORAL_INPUT_COUNT)] = (float)(i % 100);
+    float scores[TEMPORAL_LABEL_COUNT];
+    temporalWindowScores(samples, scores);
+    benchSink = scores[0];
+  });
+#endif
+
+#ifdef USE_DTW_MATCHER
+  // Motion sign templates: the history's query, each further off on one channel - the near ones
+  // reach the DTW, the far ones are pruned
+  initDtwMatcher();
+  for (int i = 0; i < DTW_HISTORY_SAMPLES; i++) pushDtwSample(channelValues);
+  while (addDtwTemplate("bench") >= 0) {
+    DtwTemplate& added = dtw.templates[dtw.count - 1];
+    for (int point = 0; point < DTW_TEMPLATE_POINTS; point++) {
+      added.points[point][(dtw.count + point) % SENSOR_CHANNEL_COUNT] += (int8_t)(dtw.count * 2 % 64);
+    }
+    dtwEnvelope(added.points, added.upper, added.lower);
+  }
+
+  benchStage("dtwDistance", "one template, no pruning", 0, minTimeUs, [](unsigned long i) {
+    int8_t query[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+    buildDtwQuery(query);
+    benchSink = (float)dtwDistance(query, dtw.templates[i % dtw.count].points, INT32_MAX, NULL, NULL);
+  });
+
+  benchStage("searchDtwTemplates", "motion signs, bound cascade", 0, minTimeUs, [](unsigned long) {
+    int8_t query[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+    buildDtwQuery(query);
+    int32_t distance;
+    benchSink = (float)searchDtwTemplates(query, (int32_t)(DTW_MATCH_THRESHOLD * DTW_TEMPLATE_POINTS), &distance,
+                                          &dtw.stats);
+  });
+  initDtwMatcher();
+#endif
+
+  // LCD refresh runs with each inference once LCD_UPDATE_INTERVAL_MS has passed
+  benchStage("commitBuffer", NULL, perInference, minTimeUs, [](unsigned long) {
+    // Invalidate the shown frame so every line is rewritten (worst case)
+    for (int row = 0; row < 4; row++) {
+      lcdBuffer[row][0] = '\0';
+    }
+    commitBuffer();
+  });
+
+  benchStage("commitBuffer_unchanged", "no changed lines", 0, minTimeUs, [](unsigned long) {
+    commitBuffer();
+  });
+}
+
+void printBenchmarkReport() {
+  Serial.println("\nStage benchmarks:");
+  Serial.print("Counter: ");
+  Serial.print(benchCyclesPerUs, 1);
+  Serial.println(" cycles/us");
+  Serial.println("  stage                     cycles/call     ns/call   calls/sample");
+
+  char line[96];
+  for (int i = 0; i < benchResultCount; i++) {
+    const BenchResult& r = benchResults[i];
+    if (r.note) {
+      snprintf(line, sizeof(line), "  %-24s %12.1f %11.1f   (%s)",
+               r.name, r.cyclesPerCall, r.nsPerCall, r.note);
+    } else {
+      snprintf(line, sizeof(line), "  %-24s %12.1f %11.1f   %.3f",
+               r.name, r.cyclesPerCall, r.nsPerCall, r.callsPerSample);
+    }
+    Serial.println(line);
+  }
+
+  // Average and worst-case loop() cost against the sampling period
+  const float budgetNs = SAMPLING_INTERVAL_MS * 1000000.0F;
+  float averageNs = 0, worstNs = 0;
+
+  Serial.print("\nBudget per ");
+  Serial.print(SAMPLING_INTERVAL_MS);
+  Serial.println(" ms sample period:");
+  for (int i = 0; i < benchResultCount; i++) {
+    const BenchResult& r = benchResults[i];
+    if (r.note) continue;
+    float ns = r.nsPerCall * r.callsPerSample;
+    averageNs += ns;
+    worstNs += r.nsPerCall;
+    snprintf(line, sizeof(line), "  %-24s %11.3f us  %7.3f%%", r.name, ns / 1000.0F, 100.0F * ns / budgetNs);
+    Serial.println(line);
+  }
+  snprintf(line, sizeof(line), "  %-24s %11.3f us  %7.3f%%", "average loop()", averageNs / 1000.0F,
+           100.0F * averageNs / budgetNs);
+  Serial.println(line);
+  snprintf(line, sizeof(line), "  %-24s %11.3f us  %7.3f%%", "worst-case loop()", worstNs / 1000.0F,
+           100.0F * worstNs / budgetNs);
+  Serial.println(line);
+
+#ifdef USE_MLP_ENGINE
+  Serial.print("\nInt8 network (");
+  Serial.print(MLP_KERNEL_NAME);
+  Serial.print(" kernel): ");
+  Serial.print((unsigned long)mlpModelBytes(&MLP_MODEL));
+  Serial.print(" bytes of weights, ");
+  Serial.print((unsigned long)sizeof(mlpArena));
+  Serial.println(" bytes of arena");
+#endif
+}
+
+#endif // BENCHMARK_H
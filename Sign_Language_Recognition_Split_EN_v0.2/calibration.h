@@ -0,0 +1,347 @@
+/*
+ * calibration.h - Flex Sensor Calibration
+ *
+ * Keeps the straight and bent ADC values of each finger in a versioned,
+ * CRC-protected record in the last sector of the internal flash, so a glove
+ * is calibrated once with the 'calibrate' command instead of by editing
+ * config.h. At boot the stored record (or the config.h values when there is
+ * none) is turned into a bend lookup table per finger with an entry for
+ * every ADC value, so converting a reading to a bend percentage is a single
+ * indexed load whatever the bend curve (linear in ADC value, or linear in
+ * sensor resistance with USE_RESISTANCE_CURVE).
+ */
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <mbed.h>
+#include "config.h"
+
+#define CALIBRATION_MAGIC 0x424C4643UL  // "CFLB"
+#define CALIBRATION_VERSION 1
+
+static_assert(FLEX_ADC_BITS == 10 || FLEX_ADC_BITS == 12, "the SAADC delivers 10 or 12-bit flex readings");
+
+// Calibration record as stored in flash - 32 bytes, a whole number of flash pages
+struct CalibrationRecord {
+  uint32_t magic;             // CALIBRATION_MAGIC
+  uint16_t version;           // CALIBRATION_VERSION
+  uint16_t length;            // sizeof(CalibrationRecord)
+  int16_t straightAdc[5];     // Thumb..pinky
+  int16_t bentAdc[5];
+  uint16_t reserved;
+  uint16_t crc;               // CRC-16/CCITT-FALSE of all bytes before it
+};
+
+// Where the calibration in use came from
+enum CalibrationSource {
+  CALIBRATION_DEFAULTS,       // FLEX_STRAIGHT_ADC / FLEX_BENT_ADC of config.h
+  CALIBRATION_FLASH,          // Same as the record in flash
+  CALIBRATION_CAPTURED,       // Captured by the 'calibrate' command, not stored
+  CALIBRATION_ADAPTED         // One of the above with endpoints moved by adaptive calibration, not stored
+};
+
+// Calibration in use, with the precomputed conversion of each finger
+struct FlexCalibration {
+  CalibrationSource source;
+  int16_t straightAdc[5];
+  int16_t bentAdc[5];
+  int16_t bendQ15[5][FLEX_ADC_LEVELS];  // Bend of each ADC value as a Q15 fraction of 128 % (1 % = 256)
+};
+
+// Steps of the guided capture
+enum CalibrationPhase {
+  CALIBRATION_IDLE,
+  CALIBRATION_WAIT_STRAIGHT,     // Giving the user time to straighten all fingers
+  CALIBRATION_CAPTURE_STRAIGHT,  // Averaging the straight readings
+  CALIBRATION_WAIT_BENT,         // Giving the user time to make a fist
+  CALIBRATION_CAPTURE_BENT,      // Averaging the bent readings
+  CALIBRATION_COMPLETE,          // Both poses captured with enough range on every finger
+  CALIBRATION_FAILED             // A finger moved less than CALIBRATION_MIN_RANGE between the poses
+};
+
+// Guided capture state, advanced one sample at a time
+struct CalibrationCapture {
+  CalibrationPhase phase;
+  int samples;                // Samples spent in the current phase
+  long sums[5];
+  int16_t straightAdc[5];
+  int16_t bentAdc[5];
+  int failedFinger;           // First finger without enough range, when CALIBRATION_FAILED
+};
+
+extern FlexCalibration flexCalibration;
+extern CalibrationCapture calibrationCapture;
+
+// Incremented by every applyCalibration(), so derived state can tell the calibration was replaced
+extern uint16_t calibrationGeneration;
+
+/**
+ * @brief Where a calibration came from, for display
+ */
+const char* calibrationSourceName(CalibrationSource source);
+
+/**
+ * @brief Use a calibration - builds the bend lookup table of each finger
+ */
+void applyCalibration(const int16_t* straightAdc, const int16_t* bentAdc, CalibrationSource source);
+
+/**
+ * @brief Fill a bend lookup table: 0 % at straightAdc, 100 % at bentAdc, clamped outside
+ * @param table FLEX_ADC_LEVELS entries, Q15 fractions of 128 %
+ */
+void buildBendTable(float straightAdc, float bentAdc, int16_t* table);
+
+/**
+ * @brief Flex sensor resistance in units of the divider resistor, from the ADC value across that resistor
+ */
+float flexResistance(float adcValue);
+
+/**
+ * @brief Apply the calibration stored in flash, or the config.h values when there is no valid record
+ * @return Whether a stored calibration was found
+ */
+bool loadCalibration();
+
+/**
+ * @brief Store the calibration in use in flash
+ * @return Whether it was written and read back intact
+ * @note Erasing the sector stalls the CPU for up to about 90 ms on the nRF52840
+ */
+bool saveCalibration();
+
+/**
+ * @brief Erase the stored calibration and go back to the config.h values
+ * @return Whether the flash sector was erased
+ */
+bool eraseCalibration();
+
+/**
+ * @brief Start the guided capture: straight pose, then bent pose
+ */
+void startCalibrationCapture();
+
+/**
+ * @brief Feed one set of raw flex readings to the guided capture
+ * @return Whether the capture moved to another phase
+ */
+bool updateCalibrationCapture(const int* flexRawValues);
+
+/**
+ * @brief Whether the guided capture is running
+ */
+bool calibrationActive();
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+ */
+uint16_t calibrationCrc16(const uint8_t* data, size_t length);
+
+// Implementation section ---------------------------------
+
+FlexCalibration flexCalibration;
+CalibrationCapture calibrationCapture = {CALIBRATION_IDLE, 0, {0}, {0}, {0}, 0};
+uint16_t calibrationGeneration = 0;
+
+const char* calibrationSourceName(CalibrationSource source) {
+  switch (source) {
+    case CALIBRATION_FLASH: return "stored in flash";
+    case CALIBRATION_CAPTURED: return "captured, not saved";
+    case CALIBRATION_ADAPTED: return "adapted to drift, not saved";
+    default: return "config.h defaults";
+  }
+}
+
+void applyCalibration(const int16_t* straightAdc, const int16_t* bentAdc, CalibrationSource source) {
+  flexCalibration.source = source;
+  calibrationGeneration++;
+  for (int i = 0; i < 5; i++) {
+    flexCalibration.straightAdc[i] = straightAdc[i];
+    flexCalibration.bentAdc[i] = bentAdc[i];
+    buildBendTable(straightAdc[i], bentAdc[i], flexCalibration.bendQ15[i]);
+  }
+}
+
+float flexResistance(float adcValue) {
+  // Rflex = R_DIV * (VCC / Vflex - 1), with Vflex = adc * VCC / full scale
+  return (FLEX_ADC_LEVELS - 1) / (adcValue > 0.5F ? adcValue : 0.5F) - 1.0F;
+}
+
+void buildBendTable(float straightAdc, float bentAdc, int16_t* table) {
+  #ifdef USE_RESISTANCE_CURVE
+  float straight = flexResistance(straightAdc);
+  float range = flexResistance(bentAdc) - straight;
+  #else
+  float straight = straightAdc;
+  float range = bentAdc - straightAdc;
+  #endif
+
+  for (int adc = 0; adc < FLEX_ADC_LEVELS; adc++) {
+    #ifdef USE_RESISTANCE_CURVE
+    float bend = range != 0 ? (flexResistance(adc) - straight) * 100.0F / range : 0.0F;
+    #else
+    float bend = range != 0 ? (adc - straight) * 100.0F / range : 0.0F;
+    #endif
+    table[adc] = (int16_t)lroundf(constrain(bend, 0.0F, 100.0F) * 256.0F);
+  }
+}
+
+uint16_t calibrationCrc16(const uint8_t* data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief Start of the last flash sector, reserved for the calibration record
+ */
+uint32_t calibrationFlashAddress(mbed::FlashIAP& flash) {
+  uint32_t end = flash.get_flash_start() + flash.get_flash_size();
+  return end - flash.get_sector_size(end - 1);
+}
+
+/**
+ * @brief Check magic, version, length and CRC of a record read from flash
+ */
+bool validCalibrationRecord(const CalibrationRecord& record) {
+  return record.magic == CALIBRATION_MAGIC &&
+         record.version == CALIBRATION_VERSION &&
+         record.length == sizeof(CalibrationRecord) &&
+         record.crc == calibrationCrc16((const uint8_t*)&record, offsetof(CalibrationRecord, crc));
+}
+
+/**
+ * @brief Read the record of the calibration sector
+ * @return Whether it could be read and is valid
+ */
+bool readCalibrationRecord(CalibrationRecord* record) {
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return false;
+  int result = flash.read(record, calibrationFlashAddress(flash), sizeof(*record));
+  flash.deinit();
+  return result == 0 && validCalibrationRecord(*record);
+}
+
+bool loadCalibration() {
+  CalibrationRecord record;
+  if (readCalibrationRecord(&record)) {
+    applyCalibration(record.straightAdc, record.bentAdc, CALIBRATION_FLASH);
+    return true;
+  }
+
+  int16_t straightAdc[5], bentAdc[5];
+  for (int i = 0; i < 5; i++) {
+    straightAdc[i] = FLEX_STRAIGHT_ADC[i];
+    bentAdc[i] = FLEX_BENT_ADC[i];
+  }
+  applyCalibration(straightAdc, bentAdc, CALIBRATION_DEFAULTS);
+  return false;
+}
+
+bool saveCalibration() {
+  CalibrationRecord record = {};
+  record.magic = CALIBRATION_MAGIC;
+  record.version = CALIBRATION_VERSION;
+  record.length = sizeof(CalibrationRecord);
+  for (int i = 0; i < 5; i++) {
+    record.straightAdc[i] = flexCalibration.straightAdc[i];
+    record.bentAdc[i] = flexCalibration.bentAdc[i];
+  }
+  record.crc = calibrationCrc16((const uint8_t*)&record, offsetof(CalibrationRecord, crc));
+
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return false;
+  uint32_t address = calibrationFlashAddress(flash);
+  bool written = sizeof(record) % flash.get_page_size() == 0 &&
+                 flash.erase(address, flash.get_sector_size(address)) == 0 &&
+                 flash.program(&record, address, sizeof(record)) == 0;
+  flash.deinit();
+
+  // Read back through the same checks as at boot
+  CalibrationRecord stored;
+  if (!written || !readCalibrationRecord(&stored) || memcmp(&stored, &record, sizeof(record)) != 0) {
+    return false;
+  }
+  flexCalibration.source = CALIBRATION_FLASH;
+  return true;
+}
+
+bool eraseCalibration() {
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return false;
+  uint32_t address = calibrationFlashAddress(flash);
+  bool erased = flash.erase(address, flash.get_sector_size(address)) == 0;
+  flash.deinit();
+
+  loadCalibration();
+  return erased;
+}
+
+void startCalibrationCapture() {
+  calibrationCapture.phase = CALIBRATION_WAIT_STRAIGHT;
+  calibrationCapture.samples = 0;
+  calibrationCapture.failedFinger = -1;
+}
+
+bool calibrationActive() {
+  return calibrationCapture.phase != CALIBRATION_IDLE;
+}
+
+bool updateCalibrationCapture(const int* flexRawValues) {
+  CalibrationCapture& capture = calibrationCapture;
+  capture.samples++;
+
+  switch (capture.phase) {
+    case CALIBRATION_WAIT_STRAIGHT:
+    case CALIBRATION_WAIT_BENT:
+      if (capture.samples < CALIBRATION_SETTLE_SAMPLES) return false;
+      for (int i = 0; i < 5; i++) capture.sums[i] = 0;
+      capture.phase = capture.phase == CALIBRATION_WAIT_STRAIGHT ? CALIBRATION_CAPTURE_STRAIGHT
+                                                                 : CALIBRATION_CAPTURE_BENT;
+      capture.samples = 0;
+      return true;
+
+    case CALIBRATION_CAPTURE_STRAIGHT:
+    case CALIBRATION_CAPTURE_BENT: {
+      for (int i = 0; i < 5; i++) capture.sums[i] += flexRawValues[i];
+      if (capture.samples < CALIBRATION_CAPTURE_SAMPLES) return false;
+
+      int16_t* averages = capture.phase == CALIBRATION_CAPTURE_STRAIGHT ? capture.straightAdc : capture.bentAdc;
+      for (int i = 0; i < 5; i++) {
+        averages[i] = (int16_t)((capture.sums[i] + CALIBRATION_CAPTURE_SAMPLES / 2) / CALIBRATION_CAPTURE_SAMPLES);
+      }
+      capture.samples = 0;
+
+      if (capture.phase == CALIBRATION_CAPTURE_STRAIGHT) {
+        capture.phase = CALIBRATION_WAIT_BENT;
+        return true;
+      }
+
+      // Both poses captured - every finger needs a usable range
+      capture.phase = CALIBRATION_COMPLETE;
+      for (int i = 0; i < 5; i++) {
+        if (abs(capture.bentAdc[i] - capture.straightAdc[i]) < CALIBRATION_MIN_RANGE) {
+          capture.phase = CALIBRATION_FAILED;
+          capture.failedFinger = i;
+          break;
+        }
+      }
+      if (capture.phase == CALIBRATION_COMPLETE) {
+        applyCalibration(capture.straightAdc, capture.bentAdc, CALIBRATION_CAPTURED);
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+#endif // CALIBRATION_H
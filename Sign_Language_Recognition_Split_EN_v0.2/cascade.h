@@ -0,0 +1,170 @@
+/*
+ * cascade.h - Two-Stage Gesture Classifier
+ *
+ * Answers clear poses without the neural network. The first stage takes the
+ * mean bend of each finger over the window and finds the nearest pose
+ * centroid of cascade_model.h (trained by host/glove_cascade on the same
+ * captures as the model). When that centroid is within CASCADE_MAX_DISTANCE
+ * and the second nearest is at least CASCADE_MIN_MARGIN farther, its
+ * gesture is the result, with a score of 1; otherwise run_classifier()
+ * decides as before. Both stages fill the same ei_impulse_result_t, so the
+ * decision layer sees no difference. With USE_MLP_ENGINE the in-tree int8
+ * network takes run_classifier()'s place. Enabled with USE_CASCADE.
+ */
+
+#ifndef CASCADE_H
+#define CASCADE_H
+
+#include <Arduino.h>
+#include <Sign-Language-Glove_inferencing.h>
+#include "config.h"
+#include "sensors.h"
+#ifdef USE_MLP_ENGINE
+#include "mlp_engine.h"
+#endif
+
+// Pose centroid of a gesture - mean bend (%) of each finger, thumb to pinky
+struct CascadeCentroid {
+  const char* label;
+  float bend[5];
+};
+
+#include "cascade_model.h"
+
+// Per-stage counters
+struct CascadeStats {
+  int8_t labelIndex[CASCADE_CENTROID_COUNT];  // Classifier label of each centroid, -1 if the model lacks it
+  bool mapped;                                // labelIndex has been filled
+
+  int lastLabel;                 // Label of the latest first-stage answer, -1 if it passed the window on
+  unsigned long fastHits;        // Windows answered by the first stage
+  unsigned long fallbacks;       // Windows passed on to run_classifier()
+  unsigned long fastUs;          // Time spent in each stage
+  unsigned long fastMaxUs;
+  unsigned long classifierUs;
+  unsigned long classifierMaxUs;
+};
+
+extern CascadeStats cascade;
+
+/**
+ * @brief First stage: the pose centroid nearest to the given finger bends
+ * @param bends Mean bend (%) of each finger, thumb to pinky
+ * @return Classifier label index, or -1 if the pose is ambiguous
+ */
+int classifyPose(const float* bends);
+
+/**
+ * @brief Classify the current window with the first stage, falling back to run_classifier()
+ * @param signal Model input, read only by the fallback
+ * @param result Filled as by run_classifier()
+ */
+EI_IMPULSE_ERROR runCascade(signal_t* signal, ei_impulse_result_t* result);
+
+/**
+ * @brief Print the hit rate and time of each stage
+ */
+void printCascadeStats();
+
+// Implementation section ---------------------------------
+
+CascadeStats cascade = {{0}, false, -1, 0, 0, 0, 0, 0, 0};
+
+/**
+ * @brief Look up the classifier label of each centroid
+ */
+void mapCascadeLabels() {
+  for (int i = 0; i < CASCADE_CENTROID_COUNT; i++) {
+    cascade.labelIndex[i] = -1;
+    for (int label = 0; label < EI_CLASSIFIER_LABEL_COUNT; label++) {
+      if (strcmp(CASCADE_CENTROIDS[i].label, ei_classifier_inferencing_categories[label]) == 0) {
+        cascade.labelIndex[i] = label;
+      }
+    }
+  }
+  cascade.mapped = true;
+}
+
+int classifyPose(const float* bends) {
+  if (!cascade.mapped) mapCascadeLabels();
+
+  // Compare squared distances, the thresholds are applied to the two nearest only
+  int nearest = -1;
+  float d1 = INFINITY, d2 = INFINITY;
+  for (int i = 0; i < CASCADE_CENTROID_COUNT; i++) {
+    float d = 0;
+    for (int finger = 0; finger < 5; finger++) {
+      float diff = bends[finger] - CASCADE_CENTROIDS[i].bend[finger];
+      d += diff * diff;
+    }
+    if (d < d1) {
+      d2 = d1;
+      d1 = d;
+      nearest = i;
+    } else if (d < d2) {
+      d2 = d;
+    }
+  }
+
+  if (nearest < 0 || d1 > (float)(CASCADE_MAX_DISTANCE * CASCADE_MAX_DISTANCE)) return -1;
+  if (sqrtf(d2) - sqrtf(d1) < (float)CASCADE_MIN_MARGIN) return -1;
+  return cascade.labelIndex[nearest];
+}
+
+EI_IMPULSE_ERROR runCascade(signal_t* signal, ei_impulse_result_t* result) {
+  unsigned long startUs = micros();
+  float bends[5];
+  for (int finger = 0; finger < 5; finger++) {
+    bends[finger] = getChannelMean(finger);   // The flex channels are the first window rows
+  }
+  cascade.lastLabel = classifyPose(bends);
+
+  if (cascade.lastLabel >= 0) {
+    memset(result, 0, sizeof(*result));
+    for (int i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+      result->classification[i].label = ei_classifier_inferencing_categories[i];
+    }
+    result->classification[cascade.lastLabel].value = 1.0F;
+
+    unsigned long elapsedUs = micros() - startUs;
+    cascade.fastHits++;
+    cascade.fastUs += elapsedUs;
+    if (elapsedUs > cascade.fastMaxUs) cascade.fastMaxUs = elapsedUs;
+    return EI_IMPULSE_OK;
+  }
+
+  // Ambiguous - the neural network decides, the first stage's time counts toward it
+  #ifdef USE_MLP_ENGINE
+  EI_IMPULSE_ERROR error = runMlpClassifier(signal, result);
+  #else
+  EI_IMPULSE_ERROR error = run_classifier(signal, result, false);
+  #endif
+  unsigned long elapsedUs = micros() - startUs;
+  cascade.fallbacks++;
+  cascade.classifierUs += elapsedUs;
+  if (elapsedUs > cascade.classifierMaxUs) cascade.classifierMaxUs = elapsedUs;
+  return error;
+}
+
+void printCascadeStats() {
+  unsigned long total = cascade.fastHits + cascade.fallbacks;
+  Serial.println("\nCascade classifier:");
+  Serial.print("  first stage ");
+  Serial.print(cascade.fastHits);
+  Serial.print(" of ");
+  Serial.print(total);
+  Serial.print(" (");
+  Serial.print(total ? 100.0F * cascade.fastHits / total : 0, 1);
+  Serial.print("%), time (us): mean ");
+  Serial.print(cascade.fastHits ? cascade.fastUs / cascade.fastHits : 0);
+  Serial.print(", max ");
+  Serial.println(cascade.fastMaxUs);
+  Serial.print("  run_classifier ");
+  Serial.print(cascade.fallbacks);
+  Serial.print(", time (us): mean ");
+  Serial.print(cascade.fallbacks ? cascade.classifierUs / cascade.fallbacks : 0);
+  Serial.print(", max ");
+  Serial.println(cascade.classifierMaxUs);
+}
+
+#endif // CASCADE_H
@@ -0,0 +1,22 @@
+/*
+ * cascade_model.h - Cascade First-Stage Centroids
+ *
+ * Generated by host/glove_cascade from 18 captures (window 50 samples) - do
+ * not edit. Mean bend (%) of each finger, thumb to pinky, of each gesture.
+ */
+
+#ifndef CASCADE_MODEL_H
+#define CASCADE_MODEL_H
+
+const CascadeCentroid CASCADE_CENTROIDS[] = {
+  {"five", {7.01F, 4.84F, 4.69F, 5.52F, 3.45F}},
+  {"four", {88.37F, 4.17F, 5.08F, 2.69F, 7.35F}},
+  {"love", {4.82F, 88.32F, 89.64F, 89.02F, 5.19F}},
+  {"one", {91.69F, 6.66F, 89.19F, 89.65F, 89.03F}},
+  {"three", {6.26F, 4.36F, 5.48F, 87.91F, 91.31F}},
+  {"two", {89.98F, 6.18F, 5.47F, 90.23F, 90.60F}},
+};
+
+#define CASCADE_CENTROID_COUNT ((int)(sizeof(CASCADE_CENTROIDS) / sizeof(CASCADE_CENTROIDS[0])))
+
+#endif // CASCADE_MODEL_H
@@ -10,6 +10,45 @@
 // LCD Support - comment out this line to disable LCD functionality
 #define USE_LCD
 
+// Benchmark Support - uncomment this line to add the 'bench' command (stage timings)
+// #define ENABLE_BENCHMARK
+
+// Vector Statistics - uncomment this line to rescan the window with vector kernels at each inference
+// instead of keeping double-precision running statistics per sample
+// #define USE_SIMD_STATISTICS
+
+// Fixed-Point Pipeline - uncomment this line to keep samples in Q15 and compute the statistics with integers
+// #define USE_FIXED_POINT
+
+// Motion Trigger - uncomment this line to run inference when the hand settles instead of every INFERENCE_INTERVAL_MS
+// #define USE_MOTION_TRIGGER
+
+// Timer/DMA Sampling - uncomment this line to scan the flex sensors with the ADC sampler instead of analogRead()
+// #define USE_ADC_SAMPLER
+
+// Debounce Decision - uncomment this line to recognize a gesture after two identical classifications and release
+// it after ten misses instead of smoothing the classifier scores (the decision rule before decision.h)
+// #define USE_DEBOUNCE_DECISION
+
+// Adaptive Calibration - uncomment this line to let the flex calibration follow sensor drift during use
+// #define USE_ADAPTIVE_CALIBRATION
+
+// Cascade Classifier - uncomment this line to answer clear poses from the mean finger bends and run the
+// neural network only when they are ambiguous (cascade.h)
+// #define USE_CASCADE
+
+// Int8 Network - uncomment this line to run the in-tree int8 network (mlp_engine.h, weights in mlp_model.h)
+// instead of run_classifier()
+// #define USE_MLP_ENGINE
+
+// Temporal Model - uncomment this line to run the streaming temporal model (temporal.h) on every sample and blend
+// its scores into the classifier's
+// #define USE_TEMPORAL_MODEL
+
+// Motion Signs - uncomment this line to match the sample stream against motion signs recorded with the 'enroll'
+// command (dtw.h)
+// #define USE_DTW_MATCHER
+
 // Flex sensor pin definitions
 #define FLEX_PIN_THUMB A0
 #define FLEX_PIN_INDEX A1
@@ -17,7 +56,10 @@
 #define FLEX_PIN_RING A3
 #define FLEX_PIN_PINKY A6
 
-// Flex sensor calibration values - as obtained from the calibration program
+// Flex sensor pins in finger order
+const int FLEX_PINS[5] = {FLEX_PIN_THUMB, FLEX_PIN_INDEX, FLEX_PIN_MIDDLE, FLEX_PIN_RING, FLEX_PIN_PINKY};
+
+// Flex sensor calibration values - used until the 'calibrate' command stores a calibration in flash
 const int FLEX_THUMB_STRAIGHT_ADC = 330;    // ADC value when straight
 const int FLEX_INDEX_STRAIGHT_ADC = 440;    // ADC value when straight
 const int FLEX_MIDDLE_STRAIGHT_ADC = 400;   // ADC value when straight
@@ -47,21 +89,151 @@ const int FLEX_BENT_ADC[5] = {
   FLEX_PINKY_BENT_ADC
 };
 
+// Flex sensor ADC resolution in bits (10 or 12) - calibration values are in the same resolution,
+// and each finger gets a bend lookup table with one entry per ADC value
+#define FLEX_ADC_BITS 10
+#define FLEX_ADC_LEVELS (1 << FLEX_ADC_BITS)
+
+// Resistance Bend Curve - uncomment this line to make bend linear in flex sensor resistance (sensor on the
+// supply side of the divider, as in Basic.ino) instead of linear in ADC value
+// #define USE_RESISTANCE_CURVE
+
+// Guided calibration ('calibrate' command), counted in samples
+#define CALIBRATION_SETTLE_SAMPLES 150  // Time to get into each pose (3 s)
+#define CALIBRATION_CAPTURE_SAMPLES 50  // Readings averaged per pose (1 s)
+#define CALIBRATION_MIN_RANGE 20        // Smallest straight-to-bent ADC difference accepted per finger
+
 // LCD Update interval
 #define LCD_UPDATE_INTERVAL_MS 200  // Update LCD every 200ms
 
-// Data processing parameters
+// Sensor channels that can be added to the data window
+enum SensorChannel {
+  CHANNEL_THUMB, CHANNEL_INDEX, CHANNEL_MIDDLE, CHANNEL_RING, CHANNEL_PINKY,
+  CHANNEL_ACCEL_X, CHANNEL_ACCEL_Y, CHANNEL_ACCEL_Z,
+  CHANNEL_GYRO_X, CHANNEL_GYRO_Y, CHANNEL_GYRO_Z,
+  SENSOR_CHANNEL_COUNT
+};
+
+const char* const SENSOR_CHANNEL_NAMES[SENSOR_CHANNEL_COUNT] = {
+  "Thumb", "Index", "Middle", "Ring", "Pinky",
+  "AccelX", "AccelY", "AccelZ",
+  "GyroX", "GyroY", "GyroZ"
+};
+
+// IMU Features - uncomment this line to add the six IMU axes to the window (the model must be trained on 77 features)
+// #define USE_IMU_FEATURES
+
+// Windowed channels, in the order their features are fed to the model
+const uint8_t WINDOW_CHANNELS[] = {
+  CHANNEL_THUMB, CHANNEL_INDEX, CHANNEL_MIDDLE, CHANNEL_RING, CHANNEL_PINKY,
+#ifdef USE_IMU_FEATURES
+  CHANNEL_ACCEL_X, CHANNEL_ACCEL_Y, CHANNEL_ACCEL_Z,
+  CHANNEL_GYRO_X, CHANNEL_GYRO_Y, CHANNEL_GYRO_Z,
+#endif
+};
+
+// Data processing parameters - WINDOW_SIZE may be overridden at build time (e.g. to sweep it over recordings)
+#ifndef WINDOW_SIZE
 #define WINDOW_SIZE 50          // Number of samples to collect for statistics
-#define FEATURE_COUNT 35        // Total features (5 sensors × 7 statistics)
-#define STATS_PER_SENSOR 7      // Number of statistics per sensor
+#endif
+#define WINDOW_STRIDE ((WINDOW_SIZE + 7) & ~7)  // Window row length, padded to whole 32-byte vectors
+#define WINDOW_CHANNEL_COUNT ((int)(sizeof(WINDOW_CHANNELS) / sizeof(WINDOW_CHANNELS[0])))
+
+// Statistics of each windowed channel, in the order they are fed to the model (feature_spec.h) - must
+// match the features of the Edge Impulse project: any of STAT_MEAN, STAT_MIN, STAT_MAX, STAT_RMS,
+// STAT_STDEV, STAT_SKEWNESS and STAT_KURTOSIS. May be overridden at build time
+#ifndef WINDOW_STATISTICS
+#define WINDOW_STATISTICS STAT_MEAN, STAT_MIN, STAT_MAX, STAT_RMS, STAT_STDEV, STAT_SKEWNESS, STAT_KURTOSIS
+#endif
+#define STATS_PER_SENSOR ((int)WindowFeatures::COUNT)  // Number of statistics per sensor
+#define STATS_REBASE_INTERVAL 8  // Fewest samples between two early recomputations of the running statistics
+#define FEATURE_COUNT (WINDOW_CHANNEL_COUNT * STATS_PER_SENSOR)  // Total features (35 for the five flex sensors)
 
 // Sampling and inference configuration
 #define SAMPLING_INTERVAL_MS 20 // 50Hz sampling rate
 #define INFERENCE_INTERVAL_MS 300  // Perform inference every 300ms
 #define CONFIDENCE_THRESHOLD 0.60 // Confidence threshold (0.0-1.0)
 
-// Filtering parameters
-#define ALPHA 0.3  // Low-pass filter coefficient
+// Decision layer parameters (decision.h) - DECISION_TIME_MS may be overridden at build time (e.g. by the replay sweep)
+#ifdef USE_MOTION_TRIGGER
+#define DEFAULT_DECISION_TIME_MS MOTION_DECISION_TIME_MS
+#else
+#define DEFAULT_DECISION_TIME_MS 200.0  // Time constant of the score smoothing - shorter decides sooner
+#endif
+#ifndef DECISION_TIME_MS
+#define DECISION_TIME_MS DEFAULT_DECISION_TIME_MS
+#endif
+#define DECISION_ENTER 0.70   // Smoothed score at which a gesture is recognized
+#define DECISION_EXIT 0.40    // Smoothed score of the recognized gesture below which it is released
+
+// Cascade parameters (USE_CASCADE) - the first stage answers when the window's mean finger bends are close to
+// one pose centroid of cascade_model.h and clearly closer to it than to any other
+#define CASCADE_MAX_DISTANCE 20.0   // Largest distance (bend %, over the five fingers) from the nearest centroid
+#define CASCADE_MIN_MARGIN 30.0     // Smallest extra distance (bend %) of the second nearest centroid
+
+// Temporal model parameters (USE_TEMPORAL_MODEL)
+#define TEMPORAL_WEIGHT 0.5   // Share of the temporal model in the scores the decision layer gets (1.0: it alone)
+
+// Motion sign parameters (USE_DTW_MATCHER) - the stream is compared with the templates every sample
+#define DTW_TEMPLATE_POINTS 32         // Points of a template (1.28 s with 2 samples per point)
+#define DTW_POINT_SAMPLES 2            // Samples per point
+#define DTW_BAND 3                     // Points a warping path may stray from the diagonal
+#define DTW_MAX_TEMPLATES 30           // Templates kept, also limited by the flash sectors
+#define DTW_FLASH_SECTORS 3            // Flash sectors below the calibration sector that hold the templates
+#define DTW_MATCH_THRESHOLD 150.0      // Largest DTW distance per point of a match (squared steps over all channels)
+#define DTW_ENROLL_SETTLE_SAMPLES 150  // Time to get ready before a sign is recorded (3 s)
+#define DTW_FLEX_STEP 1.0              // Quantization step of the flex channels (bend %)
+#define DTW_ACCEL_STEP 0.03125         // Quantization step of the accelerometer channels (g)
+#define DTW_GYRO_STEP 8.0              // Quantization step of the gyroscope channels (dps)
+
+// Motion trigger parameters (USE_MOTION_TRIGGER)
+#define MOTION_FLEX_THRESHOLD 3.0    // Bend change per sample (%) above which a finger is moving
+#define MOTION_GYRO_THRESHOLD 30.0   // Angular rate (dps) above which the hand is moving
+#define MOTION_SETTLE_SAMPLES 5      // Quiet samples before the hand counts as settled
+#define MOTION_POSE_CHANGE 15.0      // Bend drift (%) from the settled pose that counts as a new pose
+#define SETTLED_INFERENCE_INTERVAL_MS 100  // Inference period while a settled pose is classified
+#define MOTION_DECISION_TIME_MS 100.0      // Decision time constant - inference skips the moving hand, so less smoothing is needed
+
+// Adaptive calibration parameters (USE_ADAPTIVE_CALIBRATION)
+#define DRIFT_CONFIDENCE 0.90      // Classification confidence needed to learn from a pose
+#define DRIFT_SMOOTHING 0.1F       // Per-sample coefficient of the smoothed raw readings
+#define DRIFT_RATE 0.05            // Fraction of an endpoint's error corrected per learned pose
+#define DRIFT_MAX_STEP 0.5         // Largest endpoint move (ADC steps) per learned pose
+#define DRIFT_EXTREME_MARGIN 3.0   // Distance (ADC steps) beyond an endpoint at which a reading counts as an extreme
+#define DRIFT_EXTREME_STEP 0.01    // Endpoint move (ADC steps) per sample while a finger reads beyond it
+#define DRIFT_STILL_ADC 3.0        // Mean deviation (ADC steps) from the smoothed reading below which a finger is still
+#define DRIFT_LIMIT 80             // Largest endpoint move (ADC steps) away from the stored calibration
+#define DRIFT_REBUILD_STEP 0.25    // Endpoint move (ADC steps) at which the finger's bend table is rebuilt
+
+// Filtering parameters - ALPHA may be overridden at build time (e.g. 1.0 to replay pre-filtered captures)
+#define DEFAULT_ALPHA 0.3  // Low-pass filter coefficient
+#ifndef ALPHA
+#define ALPHA DEFAULT_ALPHA
+#endif
+
+// Filter chains of the flex and IMU channels (filter_bank.h), applied to every sample in stage order.
+// The default single low-pass is the filter the training captures were recorded with - a chain with
+// less delay needs recordings made through it. glove_filters reports the delay and noise reduction
+// of candidate chains on recorded captures. May be overridden at build time; USE_FIXED_POINT keeps
+// its Q31 low-pass
+#ifndef FLEX_FILTER
+#define FLEX_FILTER FilterChain<LowPassStage<5>>
+#endif
+#ifndef IMU_FILTER
+#define IMU_FILTER FilterChain<LowPassStage<6>>
+#endif
+
+// Stage tunings for the filter chains
+struct FlexOneEuroTuning {
+  static constexpr float minCutoffHz = 1.5F;         // Cutoff while the fingers are still
+  static constexpr float beta = 0.02F;               // Cutoff increase (Hz) per %/s of bend speed
+  static constexpr float derivativeCutoffHz = 2.0F;  // Smoothing of the bend speed
+};
+
+struct ImuBiquadTuning {
+  static constexpr float cutoffHz = 5.0F;
+  static constexpr float q = 0.7071F;   // Butterworth
+};
 
 // Gesture labels and descriptions
 const char* GESTURE_LABELS[] = {"one", "two", "three", "four", "five", "love"};
@@ -74,4 +246,14 @@ const char* GESTURE_DESCRIPTIONS[] = {
   "Love gesture (Thumb and pinky extended, forming heart shape)"
 };
 
+// Finger states of each gesture, thumb..pinky: 0 = straight, 1 = fully bent - the poses adaptive calibration learns from
+const uint8_t GESTURE_FINGERS_BENT[][5] = {
+  {1, 0, 1, 1, 1},
+  {1, 0, 0, 1, 1},
+  {0, 0, 0, 1, 1},
+  {1, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0},
+  {0, 1, 1, 1, 0}
+};
+
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,184 @@
+/*
+ * decision.h - Gesture Decision Layer
+ *
+ * Turns the stream of classifier results into recognized and released
+ * gestures. The score vector of every inference is accumulated into a
+ * smoothed posterior with an exponential time constant (DECISION_TIME_MS,
+ * scaled by the real time between inferences, so the motion trigger's
+ * irregular cadence is handled too). A gesture is recognized once its
+ * smoothed score reaches DECISION_ENTER and released once it falls below
+ * DECISION_EXIT; the gap between the two keeps a held gesture from
+ * flickering. A shorter time constant decides sooner, a longer one rides
+ * out more misclassifications. While a gesture stays recognized it is
+ * repeated every second inference that still classifies it confidently.
+ *
+ * USE_DEBOUNCE_DECISION keeps the earlier rule instead - two identical
+ * classifications above CONFIDENCE_THRESHOLD to recognize, repeated every
+ * second one, and more than ten below it to release.
+ */
+
+#ifndef DECISION_H
+#define DECISION_H
+
+#include <Arduino.h>
+#include <Sign-Language-Glove_inferencing.h>
+#include "config.h"
+
+// What an inference changed in the decision
+enum DecisionEvent {
+  DECISION_NONE,
+  DECISION_RECOGNIZED,   // A gesture was recognized
+  DECISION_REPEATED,     // The recognized gesture is still held - reported every second confident classification
+  DECISION_RELEASED      // The recognized gesture was released and none replaced it
+};
+
+// Decision state and time-to-decision counters
+struct DecisionState {
+  float posterior[EI_CLASSIFIER_LABEL_COUNT];  // Smoothed score of each label
+  bool primed;                   // An inference has been seen
+  unsigned long lastUpdateMs;    // Time of the latest inference
+
+  int gesture;                   // Label index of the recognized gesture, -1 if none
+  int heldCount;                 // Confident classifications of it since it was recognized
+  int top;                       // Label of the latest classification above CONFIDENCE_THRESHOLD, -1 if none
+  float topScore;                // Score of the top label of the latest inference
+  int topCount;                  // Classifications of that label above the threshold, with no other label between
+  unsigned long topSinceMs;      // Time of the first of them
+  int lead;                      // Top label of the latest inference, at any score
+  unsigned long leadSinceMs;     // Time of the first of the inferences it has led in a row
+  int missCount;                 // Inferences below the threshold since the last output (USE_DEBOUNCE_DECISION)
+
+  unsigned long recognitions;    // Gestures recognized
+  unsigned long releases;        // Gestures released
+  unsigned long latencySumMs;    // Time from the inference where a gesture took the lead to its recognition
+  unsigned long latencyMaxMs;
+};
+
+extern DecisionState decision;
+
+/**
+ * @brief Feed the result of one inference to the decision layer
+ * @param nowMs Time of the inference
+ * @return What changed - the gesture is decision.gesture
+ */
+DecisionEvent updateDecision(const ei_impulse_result_t* result, unsigned long nowMs);
+
+/**
+ * @brief Print the recognized gesture, recognition and release counts and the time to decision
+ */
+void printDecisionStats();
+
+// Implementation section ---------------------------------
+
+DecisionState decision = {{0}, false, 0, -1, 0, -1, 0, 0, 0, -1, 0, 0, 0, 0, 0, 0};
+
+/**
+ * @brief Count a recognition with its time since the gesture took the lead of the classifier's scores
+ */
+void recordRecognition(unsigned long sinceMs, unsigned long nowMs) {
+  unsigned long latencyMs = nowMs - sinceMs;
+  decision.recognitions++;
+  decision.latencySumMs += latencyMs;
+  if (latencyMs > decision.latencyMaxMs) decision.latencyMaxMs = latencyMs;
+}
+
+DecisionEvent updateDecision(const ei_impulse_result_t* result, unsigned long nowMs) {
+  int best = 0;
+  for (int i = 1; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+    if (result->classification[i].value > result->classification[best].value) best = i;
+  }
+  decision.topScore = result->classification[best].value;
+  bool confident = decision.topScore > CONFIDENCE_THRESHOLD;
+
+  // Run of inferences led by the same label, however weakly - the earliest sign of a new gesture
+  if (best != decision.lead) {
+    decision.lead = best;
+    decision.leadSinceMs = nowMs;
+  }
+
+  // Run of confident classifications of the same label - inferences below the threshold do not break it
+  if (confident) {
+    if (best != decision.top) {
+      decision.top = best;
+      decision.topCount = 0;
+      decision.topSinceMs = nowMs;
+    }
+    decision.topCount++;
+  }
+
+  #ifdef USE_DEBOUNCE_DECISION
+  if (confident) {
+    if (decision.top != decision.gesture) {
+      // New gesture, wait for a second classification
+      decision.gesture = decision.top;
+    } else if (decision.topCount % 2 == 0) {  // Output every 2 stable updates
+      decision.missCount = 0;
+      if (decision.topCount > 2) return DECISION_REPEATED;
+      recordRecognition(decision.top == decision.lead ? decision.leadSinceMs : decision.topSinceMs, nowMs);
+      return DECISION_RECOGNIZED;
+    }
+    return DECISION_NONE;
+  }
+
+  // Below threshold, might be noise or transition state - release after more than 10 in a row
+  if (++decision.missCount > 10) {
+    decision.top = -1;
+    decision.topCount = 0;
+    if (decision.gesture >= 0) {
+      decision.gesture = -1;
+      decision.releases++;
+      return DECISION_RELEASED;
+    }
+  }
+  return DECISION_NONE;
+  #else
+  // Start from an even prior, then move each score toward the latest one by the elapsed time
+  if (!decision.primed) {
+    for (int i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+      decision.posterior[i] = 1.0F / EI_CLASSIFIER_LABEL_COUNT;
+    }
+    decision.lastUpdateMs = nowMs - INFERENCE_INTERVAL_MS;
+    decision.primed = true;
+  }
+  float weight = 1.0F - expf(-(float)(nowMs - decision.lastUpdateMs) / (DECISION_TIME_MS));
+  decision.lastUpdateMs = nowMs;
+
+  int leader = 0;
+  for (int i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+    decision.posterior[i] += weight * (result->classification[i].value - decision.posterior[i]);
+    if (decision.posterior[i] > decision.posterior[leader]) leader = i;
+  }
+
+  if (leader != decision.gesture && decision.posterior[leader] >= DECISION_ENTER) {
+    decision.gesture = leader;
+    decision.heldCount = 0;
+    recordRecognition(leader == decision.lead ? decision.leadSinceMs : nowMs, nowMs);
+    return DECISION_RECOGNIZED;
+  }
+  if (decision.gesture < 0) return DECISION_NONE;
+  if (decision.posterior[decision.gesture] < DECISION_EXIT) {
+    decision.gesture = -1;
+    decision.releases++;
+    return DECISION_RELEASED;
+  }
+  // Repeated only while the classifier still puts it on top
+  if (!confident || best != decision.gesture) return DECISION_NONE;
+  return (++decision.heldCount % 2 == 0) ? DECISION_REPEATED : DECISION_NONE;
+  #endif
+}
+
+void printDecisionStats() {
+  Serial.println("\nGesture decision:");
+  Serial.print("  recognized ");
+  Serial.println(decision.gesture >= 0 ? ei_classifier_inferencing_categories[decision.gesture] : "none");
+  Serial.print("  recognitions ");
+  Serial.print(decision.recognitions);
+  Serial.print(", releases ");
+  Serial.println(decision.releases);
+  Serial.print("  time to decision (ms): mean ");
+  Serial.print(decision.recognitions ? decision.latencySumMs / decision.recognitions : 0);
+  Serial.print(", max ");
+  Serial.println(decision.latencyMaxMs);
+}
+
+#endif // DECISION_H
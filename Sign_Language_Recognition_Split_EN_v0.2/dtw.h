@@ -0,0 +1,663 @@
+/*
+ * dtw.h - Motion Sign Templates and DTW Matcher
+ *
+ * Lets the user add motion signs without retraining the classifier: the
+ * 'enroll' command records the filtered flex and IMU channels for
+ * DTW_TEMPLATE_POINTS points of DTW_POINT_SAMPLES samples each, and every
+ * new sample the last stretch of the stream is compared with every
+ * template by dynamic time warping within a band of DTW_BAND points.
+ * Values are quantized to int8 steps per channel (DTW_FLEX_STEP and so on)
+ * and distances are sums of squared steps over all channels, so the matcher
+ * runs on integers. Most templates never reach the full DTW: a cascade of
+ * lower bounds (LB_Kim on the end points, then LB_Keogh of the template
+ * against the query's envelope and of the query against the template's)
+ * rejects them first, and the DTW itself is abandoned once its partial cost
+ * plus the LB_Keogh bound of the rest passes the best distance so far - a
+ * match must come under DTW_MATCH_THRESHOLD per point to begin with.
+ *
+ * Templates are kept in flash below the calibration sector, one
+ * CRC-protected record per slot. Enrolling programs the next free slot;
+ * forgetting a sign rewrites the store.
+ */
+
+#ifndef DTW_H
+#define DTW_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <mbed.h>
+#include "config.h"
+#include "calibration.h"
+
+#define DTW_MAGIC 0x4E475344UL  // "DSGN"
+#define DTW_VERSION 1
+#define DTW_NAME_SIZE 12         // Longest sign name, including the terminator
+#define DTW_HISTORY_SAMPLES (DTW_TEMPLATE_POINTS * DTW_POINT_SAMPLES)
+
+static_assert(DTW_TEMPLATE_POINTS >= 4, "LB_Kim needs two points at each end");
+static_assert(DTW_TEMPLATE_POINTS * SENSOR_CHANNEL_COUNT % 4 == 0, "template slots are programmed in whole words");
+
+// Template as stored in one flash slot
+struct DtwTemplateRecord {
+  uint32_t magic;             // DTW_MAGIC, all ones in an empty slot
+  uint16_t version;           // DTW_VERSION
+  uint16_t length;            // sizeof(DtwTemplateRecord)
+  char name[DTW_NAME_SIZE];
+  int8_t points[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+  uint16_t reserved;
+  uint16_t crc;               // CRC-16/CCITT-FALSE of all bytes before it
+};
+
+// Template in use, with its envelope over the warping band
+struct DtwTemplate {
+  char name[DTW_NAME_SIZE];
+  int8_t points[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+  int8_t upper[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+  int8_t lower[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+};
+
+// Steps of the 'enroll' command
+enum DtwEnrollPhase {
+  DTW_ENROLL_IDLE,
+  DTW_ENROLL_WAIT,            // Giving the user time to get ready
+  DTW_ENROLL_RECORD,          // Recording the sign
+  DTW_ENROLL_COMPLETE         // Recorded - the template is in dtw.templates
+};
+
+// Where each candidate template was ruled out
+struct DtwSearchStats {
+  uint32_t searches;
+  uint32_t compared;          // Templates looked at
+  uint32_t prunedKim;         // Rejected by LB_Kim
+  uint32_t prunedKeoghQuery;  // Rejected by LB_Keogh against the query envelope
+  uint32_t prunedKeoghTemplate;  // Rejected by LB_Keogh against the template envelope
+  uint32_t abandoned;         // DTW stopped early
+  uint32_t completed;         // DTW computed to the end
+  uint64_t cells;             // DTW cells computed
+};
+
+// Template store, sample history, enrollment and counters
+struct DtwMatcher {
+  DtwTemplate templates[DTW_MAX_TEMPLATES];
+  int count;
+  int slotsUsed;              // Flash slots holding a record, the next enrollment goes after them
+  int corruptSlots;           // Records that failed their checks at load
+
+  int8_t history[DTW_HISTORY_SAMPLES][SENSOR_CHANNEL_COUNT];  // Quantized samples, a ring
+  int historyIndex;           // Where the next sample goes
+  uint32_t samples;           // Samples pushed since initDtwMatcher()
+  int refractory;             // Samples until the next match is looked for
+
+  DtwEnrollPhase enrollPhase;
+  int enrollSamples;          // Samples spent in the current phase
+  char enrollName[DTW_NAME_SIZE];
+
+  int lastMatch;              // Template of the last match, -1 before the first
+  int lastNearest;            // Nearest template of the last search that found one
+  int32_t lastDistance;
+
+  DtwSearchStats stats;
+  unsigned long matchUs;      // Time spent in matchDtwTemplates()
+  unsigned long matchMaxUs;
+};
+
+extern DtwMatcher dtw;
+
+/**
+ * @brief Clear the history and the counters and load the templates stored in flash
+ * @return Number of templates loaded
+ */
+int initDtwMatcher();
+
+/**
+ * @brief Quantize the newest filtered sample into the history
+ * @param values Filtered value of each sensor channel, indexed by SensorChannel
+ */
+void pushDtwSample(const float* const* values);
+
+/**
+ * @brief Look for an enrolled sign at the end of the history
+ * @return Index of the matched template, or -1
+ * @note Nothing is looked for while enrolling, before the history is full and for one template length
+ *       after a match, so a sign is reported once
+ */
+int matchDtwTemplates();
+
+/**
+ * @brief The last DTW_TEMPLATE_POINTS points of the history, oldest first
+ */
+void buildDtwQuery(int8_t query[][SENSOR_CHANNEL_COUNT]);
+
+/**
+ * @brief Nearest template to a query through the lower bound cascade
+ * @param bound Distance a template must come under to count (INT32_MAX for the nearest template)
+ * @param distance Receives the distance of the nearest template
+ * @return Index of the nearest template under bound, or -1
+ */
+int searchDtwTemplates(const int8_t query[][SENSOR_CHANNEL_COUNT], int32_t bound, int32_t* distance,
+                       DtwSearchStats* stats);
+
+/**
+ * @brief Banded DTW distance, abandoned once it cannot come under bound
+ * @param remaining Lower bound of the cost from each query point on (DTW_TEMPLATE_POINTS + 1 entries), or NULL
+ * @param cells Incremented by the cells computed, or NULL
+ * @return The distance, or INT32_MAX when abandoned
+ */
+int32_t dtwDistance(const int8_t query[][SENSOR_CHANNEL_COUNT], const int8_t points[][SENSOR_CHANNEL_COUNT],
+                    int32_t bound, const int32_t* remaining, uint64_t* cells);
+
+/**
+ * @brief Add a template made of the last DTW_TEMPLATE_POINTS points of the history
+ * @return Its index, or -1 when the store is full
+ */
+int addDtwTemplate(const char* name);
+
+/**
+ * @brief Start recording a sign under a name
+ * @return Whether it started - the store must have room and the name must fit
+ */
+bool startDtwEnrollment(const char* name);
+
+/**
+ * @brief Advance a running enrollment by one sample
+ * @return Whether it moved to another phase
+ */
+bool updateDtwEnrollment();
+
+/**
+ * @brief Whether an enrollment is running
+ */
+bool dtwEnrollmentActive();
+
+/**
+ * @brief Largest number of templates RAM and flash can hold
+ */
+int dtwCapacity();
+
+/**
+ * @brief Store a new template in the next free flash slot, rewriting the store when there is none
+ * @return Whether it was written and read back intact
+ */
+bool appendDtwTemplate(int index);
+
+/**
+ * @brief Erase the flash sectors of the store and write every template in use again
+ * @return Whether all were written and read back intact
+ * @note Erasing stalls the CPU for up to about 90 ms per sector on the nRF52840
+ */
+bool saveDtwTemplates();
+
+/**
+ * @brief Remove every template with a name, from RAM and from flash
+ * @return Number of templates removed, -1 if the store could not be rewritten
+ */
+int forgetDtwTemplates(const char* name);
+
+/**
+ * @brief Print the templates and how the matcher ruled candidates out
+ */
+void printDtwStats();
+
+// Implementation section ---------------------------------
+
+DtwMatcher dtw;
+
+// Quantization step of each channel, indexed by SensorChannel
+const float DTW_CHANNEL_STEPS[SENSOR_CHANNEL_COUNT] = {
+  DTW_FLEX_STEP, DTW_FLEX_STEP, DTW_FLEX_STEP, DTW_FLEX_STEP, DTW_FLEX_STEP,
+  DTW_ACCEL_STEP, DTW_ACCEL_STEP, DTW_ACCEL_STEP,
+  DTW_GYRO_STEP, DTW_GYRO_STEP, DTW_GYRO_STEP
+};
+
+/**
+ * @brief Read the template records of the flash store into RAM
+ */
+void loadDtwTemplates();
+
+int initDtwMatcher() {
+  memset(&dtw, 0, sizeof(dtw));
+  dtw.lastMatch = -1;
+  loadDtwTemplates();
+  return dtw.count;
+}
+
+void pushDtwSample(const float* const* values) {
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    long step = lroundf(*values[ch] / DTW_CHANNEL_STEPS[ch]);
+    dtw.history[dtw.historyIndex][ch] = (int8_t)constrain(step, -127L, 127L);
+  }
+  dtw.historyIndex = (dtw.historyIndex + 1) % DTW_HISTORY_SAMPLES;
+  dtw.samples++;
+  if (dtw.refractory > 0) dtw.refractory--;
+}
+
+void buildDtwQuery(int8_t query[][SENSOR_CHANNEL_COUNT]) {
+  // The newest sample is the last point, the others DTW_POINT_SAMPLES apart before it
+  int newest = dtw.historyIndex + DTW_HISTORY_SAMPLES - 1;
+  for (int i = 0; i < DTW_TEMPLATE_POINTS; i++) {
+    int sample = (newest - (DTW_TEMPLATE_POINTS - 1 - i) * DTW_POINT_SAMPLES) % DTW_HISTORY_SAMPLES;
+    memcpy(query[i], dtw.history[sample], SENSOR_CHANNEL_COUNT);
+  }
+}
+
+/**
+ * @brief Squared distance between two points over all channels
+ */
+inline int32_t dtwPointDistance(const int8_t* a, const int8_t* b) {
+  int32_t sum = 0;
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    int32_t d = a[ch] - b[ch];
+    sum += d * d;
+  }
+  return sum;
+}
+
+/**
+ * @brief Upper and lower envelope of a sequence over the warping band
+ */
+void dtwEnvelope(const int8_t points[][SENSOR_CHANNEL_COUNT], int8_t upper[][SENSOR_CHANNEL_COUNT],
+                 int8_t lower[][SENSOR_CHANNEL_COUNT]) {
+  for (int i = 0; i < DTW_TEMPLATE_POINTS; i++) {
+    int first = max(i - DTW_BAND, 0);
+    int last = min(i + DTW_BAND, DTW_TEMPLATE_POINTS - 1);
+    for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+      int8_t high = points[first][ch], low = high;
+      for (int j = first + 1; j <= last; j++) {
+        if (points[j][ch] > high) high = points[j][ch];
+        if (points[j][ch] < low) low = points[j][ch];
+      }
+      upper[i][ch] = high;
+      lower[i][ch] = low;
+    }
+  }
+}
+
+/**
+ * @brief LB_Kim - the warping path starts at the first points and ends at the last, with one of three cells next
+ *        to each
+ */
+int32_t dtwLowerBoundKim(const int8_t query[][SENSOR_CHANNEL_COUNT], const int8_t points[][SENSOR_CHANNEL_COUNT],
+                         int32_t bound) {
+  const int n = DTW_TEMPLATE_POINTS - 1;
+  int32_t lb = dtwPointDistance(query[0], points[0]) + dtwPointDistance(query[n], points[n]);
+  if (lb >= bound) return lb;
+
+  lb += min(dtwPointDistance(query[1], points[1]),
+            min(dtwPointDistance(query[0], points[1]), dtwPointDistance(query[1], points[0])));
+  if (lb >= bound) return lb;
+
+  lb += min(dtwPointDistance(query[n - 1], points[n - 1]),
+            min(dtwPointDistance(query[n], points[n - 1]), dtwPointDistance(query[n - 1], points[n])));
+  return lb;
+}
+
+/**
+ * @brief LB_Keogh - the squared distance of each point of a sequence outside the other's envelope at that position
+ * @param contributions Receives the bound of each position
+ * @return The bound, or a partial sum once it reaches bound
+ */
+int32_t dtwLowerBoundKeogh(const int8_t points[][SENSOR_CHANNEL_COUNT], const int8_t upper[][SENSOR_CHANNEL_COUNT],
+                           const int8_t lower[][SENSOR_CHANNEL_COUNT], int32_t bound, int32_t* contributions) {
+  int32_t lb = 0;
+  for (int i = 0; i < DTW_TEMPLATE_POINTS; i++) {
+    int32_t sum = 0;
+    for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+      int32_t d = 0;
+      if (points[i][ch] > upper[i][ch]) d = points[i][ch] - upper[i][ch];
+      else if (points[i][ch] < lower[i][ch]) d = lower[i][ch] - points[i][ch];
+      sum += d * d;
+    }
+    contributions[i] = sum;
+    lb += sum;
+    if (lb >= bound) return lb;
+  }
+  return lb;
+}
+
+int32_t dtwDistance(const int8_t query[][SENSOR_CHANNEL_COUNT], const int8_t points[][SENSOR_CHANNEL_COUNT],
+                    int32_t bound, const int32_t* remaining, uint64_t* cells) {
+  const int32_t infinity = INT32_MAX / 2;
+  int32_t rows[2][DTW_TEMPLATE_POINTS];
+  int32_t* previous = rows[0];
+  int32_t* current = rows[1];
+  unsigned long computed = 0;
+
+  for (int i = 0; i < DTW_TEMPLATE_POINTS; i++) {
+    int first = max(i - DTW_BAND, 0);
+    int last = min(i + DTW_BAND, DTW_TEMPLATE_POINTS - 1);
+    int32_t rowMin = infinity;
+    for (int j = 0; j < DTW_TEMPLATE_POINTS; j++) current[j] = infinity;
+
+    for (int j = first; j <= last; j++) {
+      int32_t best;
+      if (i == 0 && j == 0) {
+        best = 0;
+      } else {
+        best = infinity;
+        if (i > 0) best = min(best, previous[j]);
+        if (j > 0) best = min(best, current[j - 1]);
+        if (i > 0 && j > 0) best = min(best, previous[j - 1]);
+      }
+      current[j] = min(best + dtwPointDistance(query[i], points[j]), infinity);
+      if (current[j] < rowMin) rowMin = current[j];
+    }
+    computed += last - first + 1;
+
+    // Every path still has the rest of the query to cover
+    if (rowMin + (remaining ? remaining[i + 1] : 0) >= bound) {
+      if (cells) *cells += computed;
+      return INT32_MAX;
+    }
+    int32_t* swap = previous;
+    previous = current;
+    current = swap;
+  }
+  if (cells) *cells += computed;
+  return previous[DTW_TEMPLATE_POINTS - 1];
+}
+
+int searchDtwTemplates(const int8_t query[][SENSOR_CHANNEL_COUNT], int32_t bound, int32_t* distance,
+                       DtwSearchStats* stats) {
+  int8_t upper[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+  int8_t lower[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+  int32_t byTemplate[DTW_TEMPLATE_POINTS], byQuery[DTW_TEMPLATE_POINTS];
+  int32_t remaining[DTW_TEMPLATE_POINTS + 1];
+  dtwEnvelope(query, upper, lower);
+
+  // The nearest template of the previous search goes first - the stream has moved by one sample, so it is
+  // likely near again and its distance prunes the others early
+  int best = -1;
+  int first = dtw.lastNearest < dtw.count ? dtw.lastNearest : 0;
+  stats->searches++;
+  for (int n = 0; n < dtw.count; n++) {
+    int k = (first + n) % dtw.count;
+    const DtwTemplate& candidate = dtw.templates[k];
+    stats->compared++;
+
+    if (dtwLowerBoundKim(query, candidate.points, bound) >= bound) {
+      stats->prunedKim++;
+      continue;
+    }
+    // Template points against the query envelope - bounds the cost of each template point
+    if (dtwLowerBoundKeogh(candidate.points, upper, lower, bound, byTemplate) >= bound) {
+      stats->prunedKeoghQuery++;
+      continue;
+    }
+    // Query points against the template envelope - bounds the cost of each query point
+    if (dtwLowerBoundKeogh(query, candidate.upper, candidate.lower, bound, byQuery) >= bound) {
+      stats->prunedKeoghTemplate++;
+      continue;
+    }
+
+    // Before query point i the path has still to cover it and every later query point, and every template
+    // point past the band of point i - 1
+    int32_t templateTails[DTW_TEMPLATE_POINTS + 1];
+    templateTails[DTW_TEMPLATE_POINTS] = 0;
+    for (int i = DTW_TEMPLATE_POINTS - 1; i >= 0; i--) templateTails[i] = templateTails[i + 1] + byTemplate[i];
+    int32_t queryTail = 0;
+    remaining[DTW_TEMPLATE_POINTS] = 0;
+    for (int i = DTW_TEMPLATE_POINTS - 1; i >= 0; i--) {
+      queryTail += byQuery[i];
+      remaining[i] = max(queryTail, templateTails[min(i + DTW_BAND, DTW_TEMPLATE_POINTS)]);
+    }
+
+    int32_t d = dtwDistance(query, candidate.points, bound, remaining, &stats->cells);
+    if (d == INT32_MAX) {
+      stats->abandoned++;
+      continue;
+    }
+    stats->completed++;
+    if (d < bound) {
+      bound = d;
+      best = k;
+    }
+  }
+  if (best >= 0) dtw.lastNearest = best;
+  *distance = bound;
+  return best;
+}
+
+int matchDtwTemplates() {
+  if (dtw.count == 0 || dtwEnrollmentActive() || dtw.refractory > 0 || dtw.samples < DTW_HISTORY_SAMPLES) {
+    return -1;
+  }
+
+  unsigned long startUs = micros();
+  int8_t query[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+  buildDtwQuery(query);
+  int32_t distance;
+  int best = searchDtwTemplates(query, (int32_t)(DTW_MATCH_THRESHOLD * DTW_TEMPLATE_POINTS), &distance, &dtw.stats);
+  if (best >= 0) {
+    dtw.lastMatch = best;
+    dtw.lastDistance = distance;
+    dtw.refractory = DTW_HISTORY_SAMPLES;
+  }
+
+  unsigned long elapsedUs = micros() - startUs;
+  dtw.matchUs += elapsedUs;
+  if (elapsedUs > dtw.matchMaxUs) dtw.matchMaxUs = elapsedUs;
+  return best;
+}
+
+int dtwCapacity() {
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return 0;
+  uint32_t sectorSize = flash.get_sector_size(calibrationFlashAddress(flash) - 1);
+  flash.deinit();
+  return min((int)(sectorSize / sizeof(DtwTemplateRecord)) * DTW_FLASH_SECTORS, DTW_MAX_TEMPLATES);
+}
+
+int addDtwTemplate(const char* name) {
+  if (dtw.count >= dtwCapacity()) return -1;
+  DtwTemplate& added = dtw.templates[dtw.count];
+  strncpy(added.name, name, DTW_NAME_SIZE - 1);
+  added.name[DTW_NAME_SIZE - 1] = '\0';
+  buildDtwQuery(added.points);
+  dtwEnvelope(added.points, added.upper, added.lower);
+  return dtw.count++;
+}
+
+bool startDtwEnrollment(const char* name) {
+  if (name[0] == '\0' || strlen(name) >= DTW_NAME_SIZE || dtw.count >= dtwCapacity()) return false;
+  strcpy(dtw.enrollName, name);
+  dtw.enrollPhase = DTW_ENROLL_WAIT;
+  dtw.enrollSamples = 0;
+  return true;
+}
+
+bool dtwEnrollmentActive() {
+  return dtw.enrollPhase != DTW_ENROLL_IDLE;
+}
+
+bool updateDtwEnrollment() {
+  dtw.enrollSamples++;
+  switch (dtw.enrollPhase) {
+    case DTW_ENROLL_WAIT:
+      if (dtw.enrollSamples < DTW_ENROLL_SETTLE_SAMPLES) return false;
+      dtw.enrollPhase = DTW_ENROLL_RECORD;
+      dtw.enrollSamples = 0;
+      return true;
+
+    case DTW_ENROLL_RECORD:
+      // The history holds the sign once it has been refilled
+      if (dtw.enrollSamples < DTW_HISTORY_SAMPLES) return false;
+      if (addDtwTemplate(dtw.enrollName) < 0) {
+        dtw.enrollPhase = DTW_ENROLL_IDLE;
+        return false;
+      }
+      // The history is the template itself until it has moved on
+      dtw.refractory = DTW_HISTORY_SAMPLES;
+      dtw.enrollPhase = DTW_ENROLL_COMPLETE;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Start of the flash sectors below the calibration sector that hold the templates
+ */
+uint32_t dtwFlashAddress(mbed::FlashIAP& flash) {
+  uint32_t end = calibrationFlashAddress(flash);
+  return end - DTW_FLASH_SECTORS * flash.get_sector_size(end - 1);
+}
+
+/**
+ * @brief Flash address of a slot - slots never cross a sector boundary
+ */
+uint32_t dtwSlotAddress(mbed::FlashIAP& flash, int slot) {
+  uint32_t base = dtwFlashAddress(flash);
+  uint32_t sectorSize = flash.get_sector_size(base);
+  int perSector = sectorSize / sizeof(DtwTemplateRecord);
+  return base + (slot / perSector) * sectorSize + (slot % perSector) * sizeof(DtwTemplateRecord);
+}
+
+/**
+ * @brief Check magic, version, length and CRC of a record read from flash
+ */
+bool validDtwRecord(const DtwTemplateRecord& record) {
+  return record.magic == DTW_MAGIC &&
+         record.version == DTW_VERSION &&
+         record.length == sizeof(DtwTemplateRecord) &&
+         record.name[DTW_NAME_SIZE - 1] == '\0' &&
+         record.crc == calibrationCrc16((const uint8_t*)&record, offsetof(DtwTemplateRecord, crc));
+}
+
+void loadDtwTemplates() {
+  int capacity = dtwCapacity();
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return;
+
+  // Records fill the slots from the first, an erased slot ends the store
+  DtwTemplateRecord record;
+  for (int slot = 0; slot < capacity; slot++) {
+    if (flash.read(&record, dtwSlotAddress(flash, slot), sizeof(record)) != 0) break;
+    if (record.magic == 0xFFFFFFFFUL) break;
+    dtw.slotsUsed = slot + 1;
+    if (!validDtwRecord(record)) {
+      dtw.corruptSlots++;
+      continue;
+    }
+    DtwTemplate& loaded = dtw.templates[dtw.count++];
+    memcpy(loaded.name, record.name, DTW_NAME_SIZE);
+    memcpy(loaded.points, record.points, sizeof(loaded.points));
+    dtwEnvelope(loaded.points, loaded.upper, loaded.lower);
+  }
+  flash.deinit();
+}
+
+/**
+ * @brief Program a template into an erased slot and read it back
+ */
+bool programDtwSlot(mbed::FlashIAP& flash, int slot, const DtwTemplate& source) {
+  DtwTemplateRecord record;
+  memset(&record, 0, sizeof(record));
+  record.magic = DTW_MAGIC;
+  record.version = DTW_VERSION;
+  record.length = sizeof(DtwTemplateRecord);
+  memcpy(record.name, source.name, DTW_NAME_SIZE);
+  memcpy(record.points, source.points, sizeof(record.points));
+  record.crc = calibrationCrc16((const uint8_t*)&record, offsetof(DtwTemplateRecord, crc));
+
+  uint32_t address = dtwSlotAddress(flash, slot);
+  DtwTemplateRecord stored;
+  return sizeof(record) % flash.get_page_size() == 0 &&
+         flash.program(&record, address, sizeof(record)) == 0 &&
+         flash.read(&stored, address, sizeof(stored)) == 0 &&
+         memcmp(&stored, &record, sizeof(record)) == 0;
+}
+
+bool appendDtwTemplate(int index) {
+  if (dtw.slotsUsed >= dtwCapacity()) return saveDtwTemplates();
+
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return false;
+  bool written = programDtwSlot(flash, dtw.slotsUsed, dtw.templates[index]);
+  flash.deinit();
+
+  // A failed write may have left a partial record, which the next load skips
+  dtw.slotsUsed++;
+  return written;
+}
+
+bool saveDtwTemplates() {
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return false;
+  uint32_t address = dtwFlashAddress(flash);
+  bool written = true;
+  for (int sector = 0; sector < DTW_FLASH_SECTORS && written; sector++) {
+    uint32_t sectorSize = flash.get_sector_size(address);
+    written = flash.erase(address, sectorSize) == 0;
+    address += sectorSize;
+  }
+  dtw.slotsUsed = 0;
+  dtw.corruptSlots = 0;
+  for (int k = 0; k < dtw.count && written; k++) {
+    written = programDtwSlot(flash, k, dtw.templates[k]);
+    dtw.slotsUsed = k + 1;
+  }
+  flash.deinit();
+  return written;
+}
+
+int forgetDtwTemplates(const char* name) {
+  int kept = 0;
+  for (int k = 0; k < dtw.count; k++) {
+    if (strcmp(dtw.templates[k].name, name) == 0) continue;
+    if (kept != k) dtw.templates[kept] = dtw.templates[k];
+    kept++;
+  }
+  int removed = dtw.count - kept;
+  dtw.count = kept;
+  dtw.lastMatch = -1;
+  if (removed == 0) return 0;
+  return saveDtwTemplates() ? removed : -1;
+}
+
+/**
+ * @brief Print a count with its share of the templates compared
+ */
+void printDtwShare(const char* name, uint32_t count) {
+  Serial.print("  ");
+  Serial.print(name);
+  Serial.print(count);
+  Serial.print(" (");
+  Serial.print(dtw.stats.compared ? 100.0F * count / dtw.stats.compared : 0.0F, 1);
+  Serial.println("%)");
+}
+
+void printDtwStats() {
+  Serial.print("\nMotion sign templates: ");
+  Serial.print(dtw.count);
+  Serial.print(" of ");
+  Serial.print(dtwCapacity());
+  if (dtw.corruptSlots > 0) {
+    Serial.print(", ");
+    Serial.print(dtw.corruptSlots);
+    Serial.print(" damaged records skipped");
+  }
+  Serial.println();
+  for (int k = 0; k < dtw.count; k++) {
+    Serial.print("  ");
+    Serial.print(k + 1);
+    Serial.print(". ");
+    Serial.println(dtw.templates[k].name);
+  }
+
+  Serial.print("Searches ");
+  Serial.print(dtw.stats.searches);
+  Serial.print(", templates compared ");
+  Serial.println(dtw.stats.compared);
+  printDtwShare("pruned by LB_Kim ", dtw.stats.prunedKim);
+  printDtwShare("pruned by LB_Keogh (query envelope) ", dtw.stats.prunedKeoghQuery);
+  printDtwShare("pruned by LB_Keogh (template envelope) ", dtw.stats.prunedKeoghTemplate);
+  printDtwShare("DTW abandoned early ", dtw.stats.abandoned);
+  printDtwShare("DTW completed ", dtw.stats.completed);
+  Serial.print("  time per search (us): mean ");
+  Serial.print(dtw.stats.searches ? dtw.matchUs / dtw.stats.searches : 0);
+  Serial.print(", max ");
+  Serial.println(dtw.matchMaxUs);
+}
+
+#endif // DTW_H
@@ -0,0 +1,80 @@
+/*
+ * feature_spec.h - Window Feature Specification
+ *
+ * Describes which statistics of each window channel the model takes, and in
+ * which order, as a compile-time list (WINDOW_STATISTICS in config.h). From
+ * that list come STATS_PER_SENSOR, FEATURE_COUNT and the statistic names
+ * printed by the 'features' command. The statistics kernels compute every
+ * statistic into a table indexed by Statistic and then select the listed
+ * ones; work no listed statistic needs is skipped at compile time - the
+ * min/max tracking without minimum and maximum, the third and fourth
+ * moments without skewness and kurtosis, and the whole central-moment pass
+ * without standard deviation as well.
+ */
+
+#ifndef FEATURE_SPEC_H
+#define FEATURE_SPEC_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Statistics a window channel can contribute to the model input
+enum Statistic {
+  STAT_MEAN, STAT_MIN, STAT_MAX, STAT_RMS, STAT_STDEV, STAT_SKEWNESS, STAT_KURTOSIS,
+  STATISTIC_COUNT
+};
+
+const char* const STATISTIC_NAMES[STATISTIC_COUNT] = {
+  "Average", "Minimum", "Maximum", "RMS", "StdDev", "Skewness", "Kurtosis"
+};
+
+/**
+ * @brief Whether a statistic is in a list
+ */
+constexpr bool containsStatistic(Statistic) {
+  return false;
+}
+
+template <class... Rest>
+constexpr bool containsStatistic(Statistic stat, Statistic first, Rest... rest) {
+  return stat == first || containsStatistic(stat, rest...);
+}
+
+// Statistics of each window channel, in model input order
+template <Statistic... Stats>
+struct FeatureSpec {
+  static constexpr int COUNT = sizeof...(Stats);
+  static constexpr Statistic ORDER[sizeof...(Stats)] = {Stats...};
+
+  // Work the listed statistics need
+  static constexpr bool NEEDS_MIN = containsStatistic(STAT_MIN, Stats...);
+  static constexpr bool NEEDS_MAX = containsStatistic(STAT_MAX, Stats...);
+  static constexpr int MOMENTS =   // Highest central moment: 0 (none), 2, 3 or 4
+    containsStatistic(STAT_KURTOSIS, Stats...) ? 4 :
+    containsStatistic(STAT_SKEWNESS, Stats...) ? 3 :
+    containsStatistic(STAT_STDEV, Stats...) ? 2 : 0;
+
+  static_assert(sizeof...(Stats) > 0, "the feature spec needs at least one statistic");
+};
+
+template <Statistic... Stats>
+constexpr Statistic FeatureSpec<Stats...>::ORDER[];
+
+typedef FeatureSpec<WINDOW_STATISTICS> WindowFeatures;
+
+/**
+ * @brief Copy the statistics of the feature spec, in its order, out of a table indexed by Statistic
+ */
+template <class T>
+void selectStatistics(const T* all, T* stats);
+
+// Implementation section ---------------------------------
+
+template <class T>
+void selectStatistics(const T* all, T* stats) {
+  for (int i = 0; i < WindowFeatures::COUNT; i++) {
+    stats[i] = all[WindowFeatures::ORDER[i]];
+  }
+}
+
+#endif // FEATURE_SPEC_H
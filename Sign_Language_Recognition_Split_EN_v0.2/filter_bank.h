@@ -0,0 +1,205 @@
+/*
+ * filter_bank.h - Sensor Filter Chains
+ *
+ * Composes the filtering of a group of sensor channels from stages chosen
+ * at compile time: FilterChain<Stage1, Stage2, ...> passes every sample
+ * through the stages in order. Each stage keeps its state as one array per
+ * variable with an entry per channel, and processes all channels of the
+ * group in one branch-free loop, so the whole group is filtered in one pass
+ * that the compiler can vectorize. Stages:
+ *   LowPassStage      single-pole low-pass with the ALPHA coefficient
+ *   SpikeRejectStage  median of the last 3 samples - removes single-sample spikes
+ *   BiquadStage       second-order low-pass section (cascade several for higher orders)
+ *   OneEuroStage      one-euro filter - smooths hard while still, follows fast when moving
+ * A chain starts from the first sample it is reset with, as if the input
+ * had always been there, instead of rising from zero.
+ */
+
+#ifndef FILTER_BANK_H
+#define FILTER_BANK_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#define FILTER_SAMPLE_PERIOD_S (SAMPLING_INTERVAL_MS / 1000.0F)
+
+// Single-pole low-pass, y += ALPHA * (x - y)
+template <int N>
+struct LowPassStage {
+  float y[N] = {};
+
+  void reset(const float* x);
+  void process(float* x);
+};
+
+// Median of the current and the two previous samples
+template <int N>
+struct SpikeRejectStage {
+  float x1[N] = {}, x2[N] = {};   // Previous inputs
+
+  void reset(const float* x);
+  void process(float* x);
+};
+
+// Second-order low-pass (RBJ cookbook) in transposed direct form II
+// Tuning provides cutoffHz and q (0.7071 for Butterworth)
+template <int N, class Tuning>
+struct BiquadStage {
+  float b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;   // Coefficients, normalized so that a0 = 1
+  float s1[N] = {}, s2[N] = {};                   // State
+
+  void reset(const float* x);
+  void process(float* x);
+};
+
+// One-euro filter (Casiez et al., CHI 2012): a low-pass whose cutoff rises with the signal's speed
+// Tuning provides minCutoffHz, beta (cutoff increase in Hz per unit/s) and derivativeCutoffHz
+template <int N, class Tuning>
+struct OneEuroStage {
+  float y[N] = {};    // Filtered value
+  float dy[N] = {};   // Filtered rate of change, units per second
+
+  void reset(const float* x);
+  void process(float* x);
+};
+
+// Stages of a chain, each processing the output of the previous one
+template <class... Stages>
+struct FilterStages;
+
+template <>
+struct FilterStages<> {
+  void reset(const float*) {}
+  void process(float*) {}
+};
+
+template <class First, class... Rest>
+struct FilterStages<First, Rest...> {
+  First first;
+  FilterStages<Rest...> rest;
+
+  void reset(const float* x) {
+    first.reset(x);
+    rest.reset(x);
+  }
+
+  void process(float* x) {
+    first.process(x);
+    rest.process(x);
+  }
+};
+
+// Filter chain of a channel group - stages applied one after the other to every sample
+template <class... Stages>
+struct FilterChain {
+  FilterStages<Stages...> stages;
+  bool primed = false;
+
+  /**
+   * @brief Start every stage from a steady input x
+   */
+  void reset(const float* x) {
+    stages.reset(x);
+    primed = true;
+  }
+
+  /**
+   * @brief Filter one sample of every channel in place, resetting the chain on its first sample
+   */
+  void process(float* x) {
+    if (!primed) reset(x);
+    stages.process(x);
+  }
+};
+
+/**
+ * @brief Smoothing factor of a single-pole low-pass with the given cutoff at the sample rate
+ */
+float filterAlpha(float cutoffHz);
+
+// Implementation section ---------------------------------
+
+float filterAlpha(float cutoffHz) {
+  float tau = 1.0F / (2 * PI * cutoffHz);
+  return 1.0F / (1.0F + tau / FILTER_SAMPLE_PERIOD_S);
+}
+
+template <int N>
+void LowPassStage<N>::reset(const float* x) {
+  memcpy(y, x, sizeof(y));
+}
+
+template <int N>
+void LowPassStage<N>::process(float* x) {
+  for (int i = 0; i < N; i++) {
+    y[i] += ALPHA * (x[i] - y[i]);
+    x[i] = y[i];
+  }
+}
+
+template <int N>
+void SpikeRejectStage<N>::reset(const float* x) {
+  memcpy(x1, x, sizeof(x1));
+  memcpy(x2, x, sizeof(x2));
+}
+
+template <int N>
+void SpikeRejectStage<N>::process(float* x) {
+  for (int i = 0; i < N; i++) {
+    float a = x2[i], b = x1[i], c = x[i];
+    x2[i] = b;
+    x1[i] = c;
+    x[i] = fmaxf(fminf(a, b), fminf(fmaxf(a, b), c));
+  }
+}
+
+template <int N, class Tuning>
+void BiquadStage<N, Tuning>::reset(const float* x) {
+  float w0 = 2 * PI * Tuning::cutoffHz * FILTER_SAMPLE_PERIOD_S;
+  float alpha = sinf(w0) / (2 * Tuning::q);
+  float cosW0 = cosf(w0);
+  float a0 = 1 + alpha;
+  b1 = (1 - cosW0) / a0;
+  b0 = b2 = b1 / 2;
+  a1 = -2 * cosW0 / a0;
+  a2 = (1 - alpha) / a0;
+
+  // State of a filter whose input and output have been x forever
+  for (int i = 0; i < N; i++) {
+    s2[i] = (b2 - a2) * x[i];
+    s1[i] = (b1 - a1) * x[i] + s2[i];
+  }
+}
+
+template <int N, class Tuning>
+void BiquadStage<N, Tuning>::process(float* x) {
+  for (int i = 0; i < N; i++) {
+    float in = x[i];
+    float out = b0 * in + s1[i];
+    s1[i] = b1 * in - a1 * out + s2[i];
+    s2[i] = b2 * in - a2 * out;
+    x[i] = out;
+  }
+}
+
+template <int N, class Tuning>
+void OneEuroStage<N, Tuning>::reset(const float* x) {
+  memcpy(y, x, sizeof(y));
+  memset(dy, 0, sizeof(dy));
+}
+
+template <int N, class Tuning>
+void OneEuroStage<N, Tuning>::process(float* x) {
+  const float derivativeAlpha = filterAlpha(Tuning::derivativeCutoffHz);
+  for (int i = 0; i < N; i++) {
+    dy[i] += derivativeAlpha * ((x[i] - y[i]) / FILTER_SAMPLE_PERIOD_S - dy[i]);
+
+    // filterAlpha() of the speed-dependent cutoff, written out to stay in the loop
+    float cutoffHz = Tuning::minCutoffHz + Tuning::beta * fabsf(dy[i]);
+    float tau = 1.0F / (2 * PI * cutoffHz);
+    y[i] += (x[i] - y[i]) / (1.0F + tau / FILTER_SAMPLE_PERIOD_S);
+    x[i] = y[i];
+  }
+}
+
+#endif // FILTER_BANK_H
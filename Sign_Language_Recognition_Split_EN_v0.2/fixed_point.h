@@ -0,0 +1,273 @@
+/*
+ * fixed_point.h - Fixed-Point Feature Pipeline
+ *
+ * Integer versions of the bend conversion, low-pass filter and window
+ * statistics. Samples are Q15 fractions of a per-channel full scale, filter
+ * state is Q31, and the moments are accumulated in 64-bit integers. The
+ * statistics come out as Q16.16 real values, ready to be quantized for an
+ * int8 model input. Enabled for the whole pipeline with USE_FIXED_POINT.
+ * Like the float kernels, only the moments the feature spec needs are summed.
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "feature_spec.h"
+
+#define Q16_ONE 65536L
+
+// The 64-bit fourth-moment sum of full-scale Q15 samples overflows beyond this window size
+static_assert(WINDOW_SIZE <= 512, "calculateStatisticsQ15 supports windows of up to 512 samples");
+
+// Full scale of each sensor channel as a power of two: bend 128 %, accel 8 g, gyro 2048 dps
+const uint8_t CHANNEL_SCALE_SHIFT[SENSOR_CHANNEL_COUNT] = {
+  7, 7, 7, 7, 7,
+  3, 3, 3,
+  11, 11, 11
+};
+
+// Low-pass filter coefficient in Q16
+#define ALPHA_Q16 ((int32_t)((ALPHA) * 65536.0 + 0.5))
+
+/**
+ * @brief Convert a real value to a saturated Q15 fraction of 2^scaleShift
+ */
+int16_t toQ15(float value, uint8_t scaleShift);
+
+/**
+ * @brief Convert a Q15 fraction of 2^scaleShift back to a real value
+ */
+float fromQ15(int32_t value, uint8_t scaleShift);
+
+/**
+ * @brief Convert a Q16.16 value to float
+ */
+float fromQ16(int32_t value);
+
+/**
+ * @brief Bend percentage as a Q15 fraction of 128 %, looked up in the bend table of the finger
+ * @param bendTable FlexCalibration::bendQ15 row of the finger
+ */
+int16_t bendPercentageQ15(const int16_t* bendTable, int adcValue);
+
+/**
+ * @brief Low-pass filter on a Q31 state with the ALPHA_Q16 coefficient
+ * @return New Q31 state - its upper 16 bits are the filtered Q15 sample
+ */
+int32_t lowPassQ31(int32_t state, int16_t sample);
+
+/**
+ * @brief Round a Q31 filter state to a Q15 sample
+ */
+int16_t q31ToQ15(int32_t state);
+
+/**
+ * @brief The statistics of a Q15 window (same order and thresholds as calculateStatistics)
+ * @param window WINDOW_SIZE Q15 samples
+ * @param scaleShift Full scale of the channel, see CHANNEL_SCALE_SHIFT
+ * @param stats Receives the STATS_PER_SENSOR statistics in Q16.16
+ */
+void calculateStatisticsQ15(const int16_t* window, uint8_t scaleShift, int32_t* stats);
+
+/**
+ * @brief Quantize Q16.16 features to int8 model input: round(x / scale) + zeroPoint
+ */
+void quantizeFeaturesInt8(const int32_t* features, int count, float scale, int zeroPoint, int8_t* out);
+
+// Implementation section ---------------------------------
+
+int16_t toQ15(float value, uint8_t scaleShift) {
+  float scaled = value * (32768.0F / (1L << scaleShift));
+  if (scaled >= 32767.0F) return 32767;
+  if (scaled <= -32768.0F) return -32768;
+  return (int16_t)(scaled >= 0 ? scaled + 0.5F : scaled - 0.5F);
+}
+
+float fromQ15(int32_t value, uint8_t scaleShift) {
+  return value * ((1L << scaleShift) / 32768.0F);
+}
+
+float fromQ16(int32_t value) {
+  return value * (1.0F / Q16_ONE);
+}
+
+int16_t bendPercentageQ15(const int16_t* bendTable, int adcValue) {
+  return bendTable[constrain(adcValue, 0, FLEX_ADC_LEVELS - 1)];
+}
+
+int32_t lowPassQ31(int32_t state, int16_t sample) {
+  int64_t error = (int64_t)sample * 65536 - state;
+  return state + (int32_t)((error * ALPHA_Q16) >> 16);
+}
+
+int16_t q31ToQ15(int32_t state) {
+  int32_t rounded = (int32_t)(((int64_t)state + 0x8000) >> 16);
+  if (rounded > 32767) return 32767;
+  return (int16_t)rounded;
+}
+
+/**
+ * @brief Integer square root of a 64-bit value
+ */
+uint64_t isqrt64(uint64_t value) {
+  uint64_t root = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > value) bit >>= 2;
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+/**
+ * @brief Left shift (negative for a right shift) that puts the top bit of a nonzero value at topBit
+ */
+int normalizeShift(uint64_t value, int topBit) {
+  return topBit - (63 - __builtin_clzll(value));
+}
+
+uint64_t shiftUnsigned(uint64_t value, int shift) {
+  return shift >= 0 ? value << shift : value >> -shift;
+}
+
+/**
+ * @brief Scale a Q15-unit value to Q16.16 real units for a channel full scale of 2^scaleShift
+ * @param extraBits Fractional bits the value carries beyond Q15 units
+ */
+int64_t q15UnitsToQ16(int64_t value, int scaleShift, int extraBits) {
+  int shift = scaleShift + 1 - extraBits;
+  return shift >= 0 ? value * ((int64_t)1 << shift) : value / ((int64_t)1 << -shift);
+}
+
+int32_t saturateQ16(int64_t value) {
+  if (value > INT32_MAX) return INT32_MAX;
+  if (value < INT32_MIN) return INT32_MIN;
+  return (int32_t)value;
+}
+
+/**
+ * @brief Standard deviation, skewness and kurtosis of a Q15 window from a second pass around its mean
+ * @param all Statistic table, indexed by Statistic - entries below threshold are left as they are (0)
+ */
+void centralStatisticsQ15(const int16_t* window, int32_t sum, int16_t minValue, int16_t maxValue,
+                          uint8_t scaleShift, int32_t* all) {
+  const int64_t n = WINDOW_SIZE;
+
+  // Pass 2 - power sums around the mean. The variance uses the rounded mean. The higher
+  // powers use e = n * value - sum, which is centered without rounding, while n * e^4 fits
+  // in 64 bits; wider windows use the deviations from the rounded mean instead, scaled
+  // down just enough to fit, which keeps log2(n) more bits than scaling n * value - sum.
+  // Skewness and kurtosis do not depend on that scale
+  int32_t center = (sum >= 0 ? sum + n / 2 : sum - n / 2) / n;
+  uint32_t spread = (uint32_t)(maxValue - minValue);
+  int deviationBits = (62 - (32 - __builtin_clz((uint32_t)n))) / 4;
+  bool exactCenter = 32 - __builtin_clz((spread * (uint32_t)n) | 1) <= deviationBits;
+  int spreadBits = 32 - __builtin_clz(spread | 1);
+  int deviationShift = !exactCenter && spreadBits > deviationBits ? spreadBits - deviationBits : 0;
+  int32_t half = deviationShift ? 1 << (deviationShift - 1) : 0;
+
+  int64_t s1 = 0, s2 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    int32_t d = window[i] - center;
+    s1 += d;
+    s2 += (int64_t)d * d;
+
+    int64_t e = exactCenter ? (int64_t)window[i] * n - sum : (d + half) >> deviationShift;
+    int64_t e2 = e * e;
+    t1 += e;
+    t2 += e2;
+    if (WindowFeatures::MOMENTS >= 3) t3 += e2 * e;
+    if (WindowFeatures::MOMENTS >= 4) t4 += e2 * e2;
+  }
+
+  // Correct for the rounding of the center and of the scaled deviations (|s1|, |t1| <= n / 2)
+  int64_t nVar = s2 - (s1 * s1) / n;
+  if (nVar < 0) nVar = 0;
+  t4 -= (4 * t1 * t3) / n - (6 * t1 * t1 * t2) / (n * n) + (3 * t1 * t1 * t1 * t1) / (n * n * n);
+  t3 -= (3 * t1 * t2) / n - (2 * t1 * t1 * t1) / (n * n);
+  t2 -= (t1 * t1) / n;
+
+  // Standard deviation with 12 extra bits, also kept in Q28 real units for the thresholds
+  int64_t stdev = isqrt64(((uint64_t)nVar << 24) / n);
+  int64_t stdevQ28 = q15UnitsToQ16(stdev, scaleShift, 0);
+  all[STAT_STDEV] = saturateQ16(stdevQ28 >> 12);
+
+  // Same thresholds as calculateStatistics(): stdev > 0.0001 and variance > 0.0001
+  const int64_t q28One = (int64_t)1 << 28;
+  if (t2 <= 0) return;
+
+  // Skewness - sqrt(n) * t3 / t2^1.5, on mantissas normalized to 62 bits (an even shift for t2)
+  if (WindowFeatures::MOMENTS >= 3 && stdevQ28 * 10000 > q28One && t3 != 0) {
+    int t2Shift = normalizeShift(t2, 61) & ~1;
+    uint64_t t2Norm = shiftUnsigned(t2, t2Shift);
+    uint64_t t2Root = isqrt64(t2Norm);
+    uint64_t t3Abs = t3 < 0 ? -(uint64_t)t3 : (uint64_t)t3;
+    int t3Shift = normalizeShift(t3Abs, 61);
+    uint64_t ratio = shiftUnsigned(t3Abs, t3Shift) / (t2Norm >> 31);
+    ratio = (ratio << 29) / t2Root;
+    uint64_t rootN = isqrt64((uint64_t)n << 32);
+    int64_t skew = (int64_t)shiftUnsigned(ratio * rootN, -60 - t3Shift + t2Shift * 3 / 2);
+    all[STAT_SKEWNESS] = saturateQ16(t3 < 0 ? -skew : skew);
+  }
+
+  // Kurtosis - n * t4 / t2^2 - 3, normalized the same way
+  if (WindowFeatures::MOMENTS >= 4 && stdevQ28 * 100 > q28One) {
+    int t2Shift = normalizeShift(t2, 30);
+    uint64_t t2Norm = shiftUnsigned(t2, t2Shift);
+    int t4Shift = normalizeShift(t4, 61);
+    uint64_t ratio = shiftUnsigned(t4, t4Shift) / t2Norm;
+    ratio = (ratio << 30) / t2Norm;
+    int64_t kurtosis = (int64_t)shiftUnsigned(ratio * n, 16 - 30 - t4Shift + 2 * t2Shift);
+    all[STAT_KURTOSIS] = saturateQ16(kurtosis - 3 * Q16_ONE);
+  }
+}
+
+void calculateStatisticsQ15(const int16_t* window, uint8_t scaleShift, int32_t* stats) {
+  const int64_t n = WINDOW_SIZE;
+  int32_t all[STATISTIC_COUNT] = {0};
+
+  // Pass 1 - sum, sum of squares, min and max
+  int32_t sum = 0;
+  int64_t sum2 = 0;
+  int16_t minValue = window[0], maxValue = window[0];
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    int32_t x = window[i];
+    sum += x;
+    sum2 += x * x;
+    if (x < minValue) minValue = x;
+    if (x > maxValue) maxValue = x;
+  }
+
+  all[STAT_MEAN] = saturateQ16(q15UnitsToQ16(((int64_t)sum * 256 + n / 2) / n, scaleShift, 8));
+  all[STAT_MIN] = saturateQ16(q15UnitsToQ16(minValue, scaleShift, 0));
+  all[STAT_MAX] = saturateQ16(q15UnitsToQ16(maxValue, scaleShift, 0));
+
+  // Root-mean square - sqrt of the mean square (Q30 units with 20 extra bits -> 10 extra bits)
+  uint64_t meanSquare = ((uint64_t)sum2 << 20) / n;
+  all[STAT_RMS] = saturateQ16(q15UnitsToQ16(isqrt64(meanSquare), scaleShift, 10));
+
+  if (WindowFeatures::MOMENTS >= 2) {
+    centralStatisticsQ15(window, sum, minValue, maxValue, scaleShift, all);
+  }
+  selectStatistics(all, stats);
+}
+
+void quantizeFeaturesInt8(const int32_t* features, int count, float scale, int zeroPoint, int8_t* out) {
+  // 1 / scale in Q16, so each feature needs one multiply and a shift
+  int64_t inverseScale = (int64_t)(Q16_ONE / scale + 0.5F);
+  for (int i = 0; i < count; i++) {
+    int64_t q = ((int64_t)features[i] * inverseScale + ((int64_t)1 << 31)) >> 32;
+    q += zeroPoint;
+    out[i] = (int8_t)(q > 127 ? 127 : (q < -128 ? -128 : q));
+  }
+}
+
+#endif // FIXED_POINT_H
@@ -11,31 +11,48 @@
 #include <Sign-Language-Glove_inferencing.h>
 #include "config.h"
 #include "sensors.h"
+#include "led.h"
+#include "decision.h"
+#ifdef USE_CASCADE
+#include "cascade.h"
+#endif
+#ifdef USE_MLP_ENGINE
+#include "mlp_engine.h"
+#endif
+#ifdef USE_TEMPORAL_MODEL
+#include "temporal.h"
+#endif
+#ifdef USE_DTW_MATCHER
+#include "dtw.h"
+#endif
 #ifdef USE_LCD
 #include "lcd_ui.h"
 #endif
 
-// Gesture recognition state variables
-extern String lastRecognizedGesture;
-extern int stableCount;
-extern int noGestureCount;
-
 /**
  * @brief Get friendly description for a gesture
  */
 const char* getGestureDescription(const char* label);
 
+/**
+ * @brief Label of the last recognized gesture, or "" if there is none
+ */
+const char* lastGestureLabel();
+
 /**
  * @brief Run inference and process results
  */
 void runInference();
 
-// Implementation section ---------------------------------
+#ifdef USE_DTW_MATCHER
+/**
+ * @brief Match the newest samples against the enrolled motion signs and report a match
+ * @note Called once per sample after pushDtwSample(); pauses while a calibration runs
+ */
+void updateMotionSigns();
+#endif
 
-// Gesture recognition state variables
-String lastRecognizedGesture = "";
-int stableCount = 0;  // Stability counter to reduce recognition jitter
-int noGestureCount = 0; // Counter to detect when no gesture is present
+// Implementation section ---------------------------------
 
 const char* getGestureDescription(const char* label) {
   // Check if the label matches any predefined gesture and return its description
@@ -57,6 +74,10 @@ const char* getGestureDescription(const char* label) {
   }
 }
 
+const char* lastGestureLabel() {
+  return decision.gesture >= 0 ? ei_classifier_inferencing_categories[decision.gesture] : "";
+}
+
 void runInference() {
   // Create signal_t structure for Edge Impulse
   signal_t signal;
@@ -67,77 +88,57 @@ void runInference() {
   ei_impulse_result_t result;
   
   // Execute inference
+  #ifdef USE_CASCADE
+  // Clear poses are answered from the mean finger bends, the rest by the neural network
+  EI_IMPULSE_ERROR ei_error = runCascade(&signal, &result);
+  #elif defined(USE_MLP_ENGINE)
+  EI_IMPULSE_ERROR ei_error = runMlpClassifier(&signal, &result);
+  #else
   EI_IMPULSE_ERROR ei_error = run_classifier(&signal, &result, false);
+  #endif
   
   // Process results if inference was successful
   if (ei_error == EI_IMPULSE_OK) {
-    // Find gesture with highest confidence
-    float maxScore = 0;
-    size_t maxIndex = 0;
+    #ifdef USE_TEMPORAL_MODEL
+    // The temporal model has been stepped with every sample, its latest scores count alongside the window's
+    blendTemporalScores(&result);
+    #endif
     
-    for (size_t i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
-      if (result.classification[i].value > maxScore) {
-        maxScore = result.classification[i].value;
-        maxIndex = i;
-      }
-    }
+    // Accumulate the scores and decide whether a gesture is recognized or released
+    DecisionEvent event = updateDecision(&result, millis());
     
-    // Only consider as valid gesture if above confidence threshold
-    if (maxScore > CONFIDENCE_THRESHOLD) {
-      String gesture = String(result.classification[maxIndex].label);
+    if (event == DECISION_RECOGNIZED || event == DECISION_REPEATED) {
+      const char* label = result.classification[decision.gesture].label;
+      
+      // Get gesture description
+      const char* gestureDesc = getGestureDescription(label);
       
-      // Only output result after consecutive identical recognitions
-      if (gesture == lastRecognizedGesture) {
-        stableCount++;
-        if (stableCount >= 2 && stableCount % 2 == 0) {  // Output every 2 stable updates
-          // Get gesture description
-          const char* gestureDesc = getGestureDescription(gesture.c_str());
-          
-          // Display recognition result
-          Serial.print("Recognized gesture: ");
-          Serial.print(gesture);
-          Serial.print(" - ");
-          Serial.print(gestureDesc);
-          Serial.print(" (");
-          Serial.print(maxScore * 100);
-          Serial.println("%)");
-          
-          // LED flash to indicate successful recognition
-          digitalWrite(LED_BUILTIN, HIGH);
-          delay(50);
-          digitalWrite(LED_BUILTIN, LOW);
-          
-          #ifdef USE_LCD
-          // Update LCD with latest gesture (done in main loop)
-          #endif
-          
-          // Reset no-gesture counter
-          noGestureCount = 0;
-        }
-      } else {
-        // New gesture, reset stability counter
-        lastRecognizedGesture = gesture;
-        stableCount = 1;
-      }
-    } else {
-      // Below threshold, might be noise or transition state
-      noGestureCount++;
+      // Display recognition result
+      Serial.print("Recognized gesture: ");
+      Serial.print(label);
+      Serial.print(" - ");
+      Serial.print(gestureDesc);
+      Serial.print(" (");
+      Serial.print(result.classification[decision.gesture].value * 100);
+      Serial.println("%)");
       
-      // If no gesture detected for 10 consecutive times, clear last recognized gesture
-      if (noGestureCount > 10) {
-        if (lastRecognizedGesture != "") {
-          Serial.println("Gesture released");
-          
-          #ifdef USE_LCD
-          // Update LCD to show ready state
-          updateLCD("");
-          #endif
-          
-          lastRecognizedGesture = "";
-        }
-        stableCount = 0;
-      }
+      // LED flash to indicate successful recognition (switched off by the LED task)
+      flashLed(50);
+    } else if (event == DECISION_RELEASED) {
+      Serial.println("Gesture released");
+      
+      #ifdef USE_LCD
+      // Update LCD to show ready state
+      updateLCD("");
+      #endif
     }
+    
+    #ifdef USE_ADAPTIVE_CALIBRATION
+    // Only a confident classification of the same pose twice in a row is learned from
+    bool confident = decision.top >= 0 && decision.topScore > CONFIDENCE_THRESHOLD;
+    adaptCalibration(confident ? decision.top : -1, decision.topScore,
+                     confident ? decision.topCount : 0);
+    #endif
   } else {
     Serial.println("Inference error");
     
@@ -148,4 +149,25 @@ void runInference() {
   }
 }
 
-#endif // GESTURES_H
\ No newline at end of file
+#ifdef USE_DTW_MATCHER
+void updateMotionSigns() {
+  if (calibrationActive()) return;
+  
+  int match = matchDtwTemplates();
+  if (match < 0) return;
+  
+  const char* name = dtw.templates[match].name;
+  Serial.print("Recognized motion sign: ");
+  Serial.print(name);
+  Serial.print(" (distance ");
+  Serial.print((float)dtw.lastDistance / DTW_TEMPLATE_POINTS, 1);
+  Serial.println(" per point)");
+  flashLed(50);
+  
+  #ifdef USE_LCD
+  showTempMessage("Motion sign:", name, "", "", 1500);
+  #endif
+}
+#endif
+
+#endif // GESTURES_H
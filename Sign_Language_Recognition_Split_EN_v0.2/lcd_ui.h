@@ -24,6 +24,9 @@ extern char lcdBuffer[4][21]; // 20 chars + null terminator
 // Secondary buffer for preparing the next frame
 extern char lcdNextBuffer[4][21];
 
+// Whether a temporary message currently owns the display
+extern bool tempMessageActive;
+
 /**
  * @brief Initialize the LCD display
  */
@@ -39,11 +42,6 @@ void initBuffers();
  */
 void writeToBuffer(int row, int col, const char* text);
 
-/**
- * @brief Write a string to the next buffer at specified position
- */
-void writeToBuffer(int row, int col, String text);
-
 /**
  * @brief Clear a single line in the next buffer
  */
@@ -60,15 +58,28 @@ void clearBuffer();
 void commitBuffer();
 
 /**
- * @brief Update LCD with gesture recognition information
+ * @brief Commit the first changed line of the next buffer to the LCD
+ * @return Whether a line was written (false once the LCD is up to date)
+ */
+bool commitBufferLine();
+
+/**
+ * @brief Prepare the gesture recognition screen in the next buffer
+ * @note Drawn by commitBuffer()/commitBufferLine(); skipped while a temporary message is shown
  */
 void updateLCD(const char* gesture);
 
 /**
- * @brief Show temporary message on LCD
+ * @brief Show temporary message on LCD without blocking
+ * @note Messages are queued and shown one after another; updateTempMessage() restores the previous screen
  */
 void showTempMessage(const char* line1, const char* line2, const char* line3, const char* line4, int duration);
 
+/**
+ * @brief Move on to the next queued temporary message, or restore the screen, once the current one expires
+ */
+void updateTempMessage();
+
 /**
  * @brief Toggle LCD backlight
  * @return Current backlight status (true = on, false = off)
@@ -89,6 +100,21 @@ LiquidCrystal_I2C lcd(0x27, 20, 4);
 char lcdBuffer[4][21];
 char lcdNextBuffer[4][21];
 
+// Temporary message queue
+#define TEMP_MESSAGE_QUEUE_SIZE 4
+
+struct TempMessage {
+    char lines[4][21];
+    unsigned long duration;
+};
+
+TempMessage tempMessageQueue[TEMP_MESSAGE_QUEUE_SIZE];
+int tempMessageHead = 0;
+int tempMessageCount = 0;
+bool tempMessageActive = false;
+unsigned long tempMessageEndMs = 0;
+char tempSavedBuffer[4][21];   // Screen to restore once the messages have been shown
+
 void initLCD() {
     Wire.begin();
     lcd.init();      // Initialize the LCD
@@ -119,10 +145,6 @@ void writeToBuffer(int row, int col, const char* text) {
     }
 }
 
-void writeToBuffer(int row, int col, String text) {
-    writeToBuffer(row, col, text.c_str());
-}
-
 void clearBufferLine(int row) {
     if (row < 0 || row > 3) return;
     
@@ -139,12 +161,14 @@ void clearBuffer() {
 }
 
 void commitBuffer() {
-    bool different = false;
-    
+    while (commitBufferLine()) {
+    }
+}
+
+bool commitBufferLine() {
     for (int i = 0; i < 4; i++) {
-        different = false;
-        
         // Check if this line is different
+        bool different = false;
         for (int j = 0; j < 20; j++) {
             if (lcdBuffer[i][j] != lcdNextBuffer[i][j]) {
                 different = true;
@@ -159,11 +183,17 @@ void commitBuffer() {
                 lcdBuffer[i][j] = lcdNextBuffer[i][j];
                 lcd.write(lcdBuffer[i][j]);
             }
+            return true;
         }
     }
+    
+    return false;
 }
 
 void updateLCD(const char* gesture) {
+    // Leave the screen to a temporary message until it expires
+    if (tempMessageActive) return;
+    
     // First line: Title
     clearBufferLine(0);
     writeToBuffer(0, 0, "Sign Language Glove");
@@ -197,35 +227,55 @@ void updateLCD(const char* gesture) {
     sprintf(line4, "R:%.0f%% P:%.0f%%", 
             bendValues[3], bendValues[4]);
     writeToBuffer(3, 0, line4);
-    
-    // Commit changes to the physical LCD
-    commitBuffer();
 }
 
 void showTempMessage(const char* line1, const char* line2, const char* line3, const char* line4, int duration) {
-    // Store current buffer
-    char tempBuffer[4][21];
+    // Drop the message if the queue is full
+    if (tempMessageCount >= TEMP_MESSAGE_QUEUE_SIZE) return;
+    
+    // Queue the message
+    TempMessage& message = tempMessageQueue[(tempMessageHead + tempMessageCount) % TEMP_MESSAGE_QUEUE_SIZE];
+    const char* lines[4] = {line1, line2, line3, line4};
     for (int i = 0; i < 4; i++) {
-        strncpy(tempBuffer[i], lcdNextBuffer[i], 21);
+        strncpy(message.lines[i], lines[i] ? lines[i] : "", 20);
+        message.lines[i][20] = '\0';
     }
+    message.duration = duration;
+    tempMessageCount++;
     
-    // Show message
-    clearBuffer();
-    if (line1) writeToBuffer(0, 0, line1);
-    if (line2) writeToBuffer(1, 0, line2);
-    if (line3) writeToBuffer(2, 0, line3);
-    if (line4) writeToBuffer(3, 0, line4);
-    commitBuffer();
+    // Show it straight away if nothing else is being shown
+    if (!tempMessageActive) {
+        memcpy(tempSavedBuffer, lcdNextBuffer, sizeof(tempSavedBuffer));
+        tempMessageActive = true;
+        tempMessageEndMs = millis();
+        updateTempMessage();
+    }
+}
+
+void updateTempMessage() {
+    if (!tempMessageActive || (long)(millis() - tempMessageEndMs) < 0) return;
     
-    delay(duration);
+    if (tempMessageCount == 0) {
+        // Restore buffer
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 21; j++) {
+                lcdNextBuffer[i][j] = tempSavedBuffer[i][j];
+            }
+        }
+        tempMessageActive = false;
+        return;
+    }
     
-    // Restore buffer
+    // Show the next queued message
+    TempMessage& message = tempMessageQueue[tempMessageHead];
+    tempMessageHead = (tempMessageHead + 1) % TEMP_MESSAGE_QUEUE_SIZE;
+    tempMessageCount--;
+    
+    clearBuffer();
     for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 21; j++) {
-            lcdNextBuffer[i][j] = tempBuffer[i][j];
-        }
+        writeToBuffer(i, 0, message.lines[i]);
     }
-    commitBuffer();
+    tempMessageEndMs = millis() + message.duration;
 }
 
 bool toggleLCDBacklight() {
@@ -0,0 +1,41 @@
+/*
+ * led.h - Status LED Effects
+ *
+ * Non-blocking LED flashes - the LED is switched on immediately and switched
+ * off again by updateLed(), which runs as a scheduler task
+ */
+
+#ifndef LED_H
+#define LED_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Switch the built-in LED on for a number of milliseconds without blocking
+ */
+void flashLed(unsigned long durationMs);
+
+/**
+ * @brief Switch the LED off once the current flash has expired
+ */
+void updateLed();
+
+// Implementation section ---------------------------------
+
+bool ledFlashActive = false;
+unsigned long ledFlashEndMs = 0;
+
+void flashLed(unsigned long durationMs) {
+  digitalWrite(LED_BUILTIN, HIGH);
+  ledFlashActive = true;
+  ledFlashEndMs = millis() + durationMs;
+}
+
+void updateLed() {
+  if (ledFlashActive && (long)(millis() - ledFlashEndMs) >= 0) {
+    digitalWrite(LED_BUILTIN, LOW);
+    ledFlashActive = false;
+  }
+}
+
+#endif // LED_H
@@ -0,0 +1,373 @@
+/*
+ * mlp_engine.h - In-Tree int8 Dense Network
+ *
+ * Runs the gesture classifier - fully connected layers with ReLU and a
+ * softmax, the architecture of the Edge Impulse project - from int8 weights
+ * in flash (mlp_model.h, written by host/glove_mlp) with activations in a
+ * static arena, instead of going through the Edge Impulse SDK. The integer
+ * arithmetic is that of the TensorFlow Lite Micro int8 reference kernels the
+ * SDK runs: inputs quantized as round(x / scale) + zero point, int32
+ * accumulators requantized with a fixed-point multiplier and shift, and the
+ * gemmlowp fixed-point softmax. The layers run through AVX2 on the host
+ * build when available and plain loops otherwise, and the host checks both
+ * give the same bytes. The CMSIS-NN path for the Cortex-M4 has not been
+ * built for the board yet. Enabled in place of run_classifier() with
+ * USE_MLP_ENGINE.
+ */
+
+#ifndef MLP_ENGINE_H
+#define MLP_ENGINE_H
+
+#include <Arduino.h>
+#include <Sign-Language-Glove_inferencing.h>
+#include "config.h"
+#include "sensors.h"
+
+#if defined(__arm__) && defined(ARDUINO)
+#include <edge-impulse-sdk/CMSIS/NN/Include/arm_nnfunctions.h>
+#define MLP_KERNEL_CMSIS
+#define MLP_KERNEL_NAME "CMSIS-NN"
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define MLP_KERNEL_AVX2
+#define MLP_KERNEL_NAME "AVX2"
+#else
+#define MLP_KERNEL_NAME "scalar"
+#endif
+
+// One fully connected layer, quantized as TensorFlow Lite Micro does
+struct MlpDenseLayer {
+  uint16_t inputs;
+  uint16_t outputs;
+  const int8_t* weights;      // One row of inputs per output, symmetric (zero point 0)
+  const int32_t* bias;        // Scale of input times weights, zero point 0
+  int32_t inputOffset;        // Negated zero point of the input
+  int32_t outputOffset;       // Zero point of the output
+  int32_t multiplier;         // Requantization of the accumulators: Q31 multiplier and power-of-two shift
+  int32_t shift;
+  int32_t activationMin;      // Output clamp - the output zero point for ReLU
+  int32_t activationMax;
+};
+
+// Quantized network - dense layers followed by a softmax
+struct MlpModel {
+  const MlpDenseLayer* layers;
+  uint8_t layerCount;
+  float inputScale;           // Input quantization
+  int32_t inputZeroPoint;
+  int32_t softmaxMultiplier;  // Scaling of the logit differences into Q5.26, and the smallest difference kept
+  int32_t softmaxShift;
+  int32_t softmaxDiffMin;
+  float outputScale;          // Score dequantization (1/256 and -128 for int8 softmax)
+  int32_t outputZeroPoint;
+  const char* const* labels;
+};
+
+#include "mlp_model.h"
+
+// Largest layer of the model, padded to whole 16-element vectors for the kernels
+#define MLP_ARENA_WIDTH ((MLP_MAX_WIDTH + 15) & ~15)
+
+extern unsigned long mlpInvokeCount;
+
+/**
+ * @brief Reference fully connected layer - the loops of the TensorFlow Lite Micro int8 kernel
+ */
+void mlpDenseScalar(const MlpDenseLayer* layer, const int8_t* input, int8_t* output);
+
+/**
+ * @brief Fully connected layer with the fastest kernel of the target, same output as mlpDenseScalar()
+ */
+void mlpDense(const MlpDenseLayer* layer, const int8_t* input, int8_t* output);
+
+/**
+ * @brief int8 softmax of the last layer's output, as TensorFlow Lite Micro computes it
+ */
+void mlpSoftmax(const MlpModel* model, const int8_t* logits, int count, int8_t* scores);
+
+/**
+ * @brief Run the network on a quantized input
+ * @param scores Receives the int8 score of each label
+ * @return Whether the model fits the arena
+ */
+bool mlpInvoke(const MlpModel* model, const int8_t* input, int8_t* scores);
+
+/**
+ * @brief Drop-in replacement for run_classifier() running MLP_MODEL
+ * @note The input is read from the sensor window with get_signal_data_int8(), quantized with the
+ *       model's input scale and zero point, rather than through signal->get_data
+ */
+EI_IMPULSE_ERROR runMlpClassifier(signal_t* signal, ei_impulse_result_t* result);
+
+/**
+ * @brief Bytes of weights and biases of a model (flash)
+ */
+size_t mlpModelBytes(const MlpModel* model);
+
+// Implementation section ---------------------------------
+
+unsigned long mlpInvokeCount = 0;
+
+// Activations of the layer being read and the layer being written
+int8_t mlpArena[2][MLP_ARENA_WIDTH];
+
+// Classifier label of each model label, -1 if the classifier lacks it
+int8_t mlpLabelIndex[MLP_LABEL_COUNT];
+bool mlpLabelsMapped = false;
+
+/**
+ * @brief gemmlowp SaturatingRoundingDoublingHighMul - (a * b) / 2^31, rounded
+ */
+int32_t mlpHighMul(int32_t a, int32_t b) {
+  if (a == b && a == INT32_MIN) return INT32_MAX;
+  int64_t ab = (int64_t)a * b;
+  int32_t nudge = ab >= 0 ? (1 << 30) : (1 - (1 << 30));
+  return (int32_t)((ab + nudge) / (1LL << 31));
+}
+
+/**
+ * @brief gemmlowp RoundingDivideByPOT - x / 2^exponent, rounded half away from zero
+ */
+int32_t mlpDivideByPot(int32_t x, int exponent) {
+  int32_t mask = (int32_t)((1LL << exponent) - 1);
+  int32_t remainder = x & mask;
+  int32_t threshold = (mask >> 1) + (x < 0 ? 1 : 0);
+  return (x >> exponent) + (remainder > threshold ? 1 : 0);
+}
+
+/**
+ * @brief gemmlowp SaturatingRoundingMultiplyByPOT for a positive exponent
+ */
+int32_t mlpShiftLeftSaturating(int32_t x, int exponent) {
+  int32_t threshold = (int32_t)((1LL << (31 - exponent)) - 1);
+  if (x > threshold) return INT32_MAX;
+  if (x < -threshold) return INT32_MIN;
+  return (int32_t)((uint32_t)x << exponent);
+}
+
+/**
+ * @brief TensorFlow Lite MultiplyByQuantizedMultiplier - x times a Q31 multiplier and 2^shift
+ */
+int32_t mlpRequantize(int32_t x, int32_t multiplier, int shift) {
+  int leftShift = shift > 0 ? shift : 0;
+  int rightShift = shift > 0 ? 0 : -shift;
+  return mlpDivideByPot(mlpHighMul((int32_t)((uint32_t)x << leftShift), multiplier), rightShift);
+}
+
+/**
+ * @brief Requantize a layer's accumulator to its int8 output
+ */
+int8_t mlpOutput(const MlpDenseLayer* layer, int32_t acc) {
+  acc = mlpRequantize(acc, layer->multiplier, layer->shift) + layer->outputOffset;
+  return (int8_t)constrain(acc, layer->activationMin, layer->activationMax);
+}
+
+void mlpDenseScalar(const MlpDenseLayer* layer, const int8_t* input, int8_t* output) {
+  for (int out = 0; out < layer->outputs; out++) {
+    const int8_t* row = layer->weights + out * layer->inputs;
+    int32_t acc = 0;
+    for (int i = 0; i < layer->inputs; i++) {
+      acc += row[i] * (input[i] + layer->inputOffset);
+    }
+    output[out] = mlpOutput(layer, acc + layer->bias[out]);
+  }
+}
+
+#if defined(MLP_KERNEL_CMSIS)
+
+void mlpDense(const MlpDenseLayer* layer, const int8_t* input, int8_t* output) {
+  cmsis_nn_context context = {NULL, 0};
+  cmsis_nn_fc_params params;
+  params.input_offset = layer->inputOffset;
+  params.filter_offset = 0;
+  params.output_offset = layer->outputOffset;
+  params.activation.min = layer->activationMin;
+  params.activation.max = layer->activationMax;
+  cmsis_nn_per_tensor_quant_params quant = {layer->multiplier, layer->shift};
+  cmsis_nn_dims inputDims = {1, 1, 1, layer->inputs};
+  cmsis_nn_dims filterDims = {layer->inputs, 1, 1, layer->outputs};
+  cmsis_nn_dims biasDims = {1, 1, 1, layer->outputs};
+  cmsis_nn_dims outputDims = {1, 1, 1, layer->outputs};
+  arm_fully_connected_s8(&context, &params, &quant, &inputDims, input, &filterDims, layer->weights, &biasDims,
+                         layer->bias, &outputDims, output);
+}
+
+#elif defined(MLP_KERNEL_AVX2)
+
+void mlpDense(const MlpDenseLayer* layer, const int8_t* input, int8_t* output) {
+  // Offset input widened to int16 once - it fits, and so do the pairwise products madd sums
+  alignas(32) int16_t x[MLP_ARENA_WIDTH];
+  for (int i = 0; i < layer->inputs; i++) {
+    x[i] = (int16_t)(input[i] + layer->inputOffset);
+  }
+
+  const int vectorInputs = layer->inputs & ~15;
+  for (int out = 0; out < layer->outputs; out++) {
+    const int8_t* row = layer->weights + out * layer->inputs;
+    __m256i acc = _mm256_setzero_si256();
+    for (int i = 0; i < vectorInputs; i += 16) {
+      __m256i w = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(row + i)));
+      acc = _mm256_add_epi32(acc, _mm256_madd_epi16(w, _mm256_load_si256((const __m256i*)(x + i))));
+    }
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    int32_t total = _mm_cvtsi128_si32(sum);
+    for (int i = vectorInputs; i < layer->inputs; i++) {
+      total += row[i] * x[i];
+    }
+    output[out] = mlpOutput(layer, total + layer->bias[out]);
+  }
+}
+
+#else
+
+void mlpDense(const MlpDenseLayer* layer, const int8_t* input, int8_t* output) {
+  mlpDenseScalar(layer, input, output);
+}
+
+#endif
+
+/**
+ * @brief gemmlowp exp_on_interval_between_negative_one_quarter_and_0_excl - Q0.31 in and out
+ */
+int32_t mlpExpQuarter(int32_t a) {
+  const int32_t constantTerm = 1895147668;   // exp(-1/8)
+  const int32_t oneThird = 715827883;
+  int32_t x = a + (1 << 28);                 // Taylor expansion around -1/8
+  int32_t x2 = mlpHighMul(x, x);
+  int32_t x3 = mlpHighMul(x2, x);
+  int32_t x4 = mlpHighMul(x2, x2);
+  int32_t x4Over4 = mlpDivideByPot(x4, 2);
+  int32_t poly = mlpDivideByPot(mlpHighMul(x4Over4 + x3, oneThird) + x2, 1);
+  return constantTerm + mlpHighMul(constantTerm, x + poly);
+}
+
+/**
+ * @brief gemmlowp exp_on_negative_values - a <= 0 in Q5.26, exp(a) in Q0.31
+ */
+int32_t mlpExpOnNegative(int32_t a) {
+  const int32_t oneQuarter = 1 << 24;
+  int32_t aModQuarterMinusQuarter = (a & (oneQuarter - 1)) - oneQuarter;
+  int32_t result = mlpExpQuarter(mlpShiftLeftSaturating(aModQuarterMinusQuarter, 5));
+  int32_t remainder = aModQuarterMinusQuarter - a;
+
+  // exp(-2^k) for each bit of the remaining whole quarters, k = -2..4
+  static const int32_t multipliers[7] = {1672461947, 1302514674, 790015084, 290630308, 39332535, 720401, 242};
+  for (int k = 0; k < 7; k++) {
+    if (remainder & (1 << (24 + k))) result = mlpHighMul(result, multipliers[k]);
+  }
+  return a == 0 ? INT32_MAX : result;
+}
+
+/**
+ * @brief TensorFlow Lite GetReciprocal - 1 / x for x with integerBits, as a Q0.31 scale and a shift
+ */
+int32_t mlpReciprocal(int32_t x, int integerBits, int* bitsOverUnit) {
+  int headroomPlusOne = __builtin_clz((uint32_t)x);
+  *bitsOverUnit = integerBits - headroomPlusOne;
+  int32_t shiftedMinusOne = (int32_t)(((uint32_t)x << headroomPlusOne) - (1U << 31));
+
+  // gemmlowp one_over_one_plus_x_for_x_in_0_1: Newton-Raphson on half the denominator, in Q2.29
+  int64_t sum = (int64_t)shiftedMinusOne + INT32_MAX;
+  int32_t halfDenominator = (int32_t)((sum + (sum >= 0 ? 1 : -1)) / 2);
+  int32_t estimate = 1515870810 + mlpHighMul(halfDenominator, -1010580540);   // 48/17 - 32/17 * d
+  for (int i = 0; i < 3; i++) {
+    int32_t oneMinusProduct = (1 << 29) - mlpHighMul(halfDenominator, estimate);
+    estimate += mlpShiftLeftSaturating(mlpHighMul(estimate, oneMinusProduct), 2);
+  }
+  return mlpShiftLeftSaturating(estimate, 1);
+}
+
+void mlpSoftmax(const MlpModel* model, const int8_t* logits, int count, int8_t* scores) {
+  #if defined(MLP_KERNEL_CMSIS)
+  arm_softmax_s8(logits, 1, count, model->softmaxMultiplier, model->softmaxShift, model->softmaxDiffMin, scores);
+  #else
+  int8_t maxLogit = logits[0];
+  for (int i = 1; i < count; i++) {
+    if (logits[i] > maxLogit) maxLogit = logits[i];
+  }
+
+  // Sum of the exponentials in Q12.19
+  int32_t sumOfExps = 0;
+  for (int i = 0; i < count; i++) {
+    int32_t diff = logits[i] - maxLogit;
+    if (diff < model->softmaxDiffMin) continue;
+    int32_t scaled = mlpHighMul(diff * (1 << model->softmaxShift), model->softmaxMultiplier);
+    sumOfExps += mlpDivideByPot(mlpExpOnNegative(scaled), 12);
+  }
+
+  int bitsOverUnit;
+  int32_t scale = mlpReciprocal(sumOfExps, 12, &bitsOverUnit);
+  for (int i = 0; i < count; i++) {
+    int32_t diff = logits[i] - maxLogit;
+    if (diff < model->softmaxDiffMin) {
+      scores[i] = -128;
+      continue;
+    }
+    int32_t scaled = mlpHighMul(diff * (1 << model->softmaxShift), model->softmaxMultiplier);
+    int32_t score = mlpDivideByPot(mlpHighMul(scale, mlpExpOnNegative(scaled)), bitsOverUnit + 31 - 8) - 128;
+    scores[i] = (int8_t)constrain(score, -128, 127);
+  }
+  #endif
+}
+
+bool mlpInvoke(const MlpModel* model, const int8_t* input, int8_t* scores) {
+  const int8_t* in = input;
+  int8_t* out = mlpArena[0];
+  int width = 0;
+  for (int i = 0; i < model->layerCount; i++) {
+    const MlpDenseLayer* layer = &model->layers[i];
+    if (layer->inputs > MLP_ARENA_WIDTH || layer->outputs > MLP_ARENA_WIDTH) return false;
+    mlpDense(layer, in, out);
+    in = out;
+    out = (out == mlpArena[0]) ? mlpArena[1] : mlpArena[0];
+    width = layer->outputs;
+  }
+  mlpSoftmax(model, in, width, scores);
+  return true;
+}
+
+EI_IMPULSE_ERROR runMlpClassifier(signal_t* signal, ei_impulse_result_t* result) {
+  if (signal->total_length != MLP_INPUT_COUNT) return EI_IMPULSE_ERROR_SHAPES_DONT_MATCH;
+
+  if (!mlpLabelsMapped) {
+    for (int i = 0; i < MLP_LABEL_COUNT; i++) {
+      mlpLabelIndex[i] = -1;
+      for (int label = 0; label < EI_CLASSIFIER_LABEL_COUNT; label++) {
+        if (strcmp(MLP_MODEL.labels[i], ei_classifier_inferencing_categories[label]) == 0) mlpLabelIndex[i] = label;
+      }
+    }
+    mlpLabelsMapped = true;
+  }
+
+  // Quantize the features as the SDK does for an int8 input tensor
+  int8_t input[MLP_INPUT_COUNT];
+  if (get_signal_data_int8(0, MLP_INPUT_COUNT, MLP_MODEL.inputScale, MLP_MODEL.inputZeroPoint, input) != 0) {
+    return EI_IMPULSE_DSP_ERROR;
+  }
+
+  int8_t scores[MLP_LABEL_COUNT];
+  if (!mlpInvoke(&MLP_MODEL, input, scores)) return EI_IMPULSE_TFLITE_ERROR;
+  mlpInvokeCount++;
+
+  memset(result, 0, sizeof(*result));
+  for (int i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+    result->classification[i].label = ei_classifier_inferencing_categories[i];
+  }
+  for (int i = 0; i < MLP_LABEL_COUNT; i++) {
+    if (mlpLabelIndex[i] < 0) continue;
+    result->classification[mlpLabelIndex[i]].value = (scores[i] - MLP_MODEL.outputZeroPoint) * MLP_MODEL.outputScale;
+  }
+  return EI_IMPULSE_OK;
+}
+
+size_t mlpModelBytes(const MlpModel* model) {
+  size_t bytes = 0;
+  for (int i = 0; i < model->layerCount; i++) {
+    bytes += model->layers[i].inputs * model->layers[i].outputs + model->layers[i].outputs * sizeof(int32_t);
+  }
+  return bytes;
+}
+
+#endif // MLP_ENGINE_H
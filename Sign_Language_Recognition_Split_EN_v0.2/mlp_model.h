@@ -0,0 +1,141 @@
+/*
+ * mlp_model.h - int8 Gesture Network
+ *
+ * Generated by host/glove_mlp from 1800 windows of 18 captures - do not edit.
+ *
+ * Dense layers of 25, 15, 10 and 6 neurons and a softmax,
+ * quantized to int8 as the TensorFlow Lite converter does.
+ */
+
+#ifndef MLP_MODEL_H
+#define MLP_MODEL_H
+
+#define MLP_INPUT_COUNT 35
+#define MLP_LABEL_COUNT 6
+#define MLP_MAX_WIDTH 35
+
+const char* const MLP_LABELS[MLP_LABEL_COUNT] = {"five", "four", "love", "one", "three", "two"};
+
+const int8_t MLP_WEIGHTS_0[875] = {
+  8, 4, -15, -20, -8, -24, -13, -40, 41, -39, 20, -6, 38, 5, -57, -25, 7, 63, -10, -46,
+  -9, 15, 2, -14, 21, 7, -39, -72, -64, 55, 20, -20, 20, 26, -19, -14, 1, 57, 6, 16,
+  -3, -34, 56, -28, -7, 14, -52, -5, -38, 33, -26, -14, 34, 18, -8, 39, 20, 43, -29, 32,
+  -18, -57, -20, 19, -50, -83, 16, -12, -3, -6, 2, -38, 20, 8, -19, -42, 83, -10, -3, -22,
+  60, 48, -49, 12, -34, 22, 2, -32, 30, -19, -8, 67, 39, -69, -16, 15, -41, 2, 50, 5,
+  37, 10, 16, 45, -5, -38, -16, 35, 25, -86, 7, -24, 8, 38, 39, -48, 15, 42, -9, 14,
+  13, 22, 49, 30, -40, 41, 40, -21, -26, -43, 4, 27, 35, -6, 1, 69, -22, 2, 10, -12,
+  -50, 0, 31, 19, -58, -85, -13, -7, 36, 25, -39, 26, -56, 26, 34, -48, -1, 8, 15, 50,
+  15, -65, 12, 10, -15, 71, 49, 70, 6, -32, 20, -11, -6, 102, 14, 46, -31, 15, -2, 56,
+  8, 8, -3, -12, -3, -18, -16, -6, -18, 19, -57, 2, 12, -2, -23, 16, -12, -15, -16, -9,
+  49, 44, -6, 12, -67, 29, -23, 28, 18, -32, 21, 46, -35, -56, 17, 25, -14, 46, -71, 50,
+  -16, -27, 1, -3, 22, -38, 69, 29, -1, 12, 6, 12, -51, 16, -18, -17, -22, 25, -57, 40,
+  15, 24, -28, -43, -41, -4, 2, -2, 12, -23, 46, -4, 42, 15, -50, 70, 8, -64, -35, 5,
+  3, -80, -50, 5, 10, 4, -16, 63, -22, -15, -43, -19, -23, 5, -5, -4, -23, 13, -4, -20,
+  -13, -8, -12, 11, 35, 46, 29, -5, -3, 14, -36, -35, -2, -15, 0, 50, 19, 23, 8, 8,
+  -6, -7, 27, -27, 46, 25, -15, 7, -44, 10, 22, 8, -43, -15, -43, -4, -12, 0, -66, 64,
+  -6, 21, 49, -51, -18, -37, 11, -24, -12, -2, -3, -15, -19, 30, -2, -12, -1, -70, 3, 42,
+  -43, -28, -7, 15, 27, 4, -13, 14, -74, -45, -64, 23, 13, 46, -27, -22, 15, 2, -47, 29,
+  -43, 11, -53, -14, 10, 8, -37, -25, 37, 75, -16, -17, 13, 43, -18, 1, -20, -7, -32, 52,
+  3, 24, -47, -9, -28, 23, -4, 27, -47, 59, -64, 25, 43, -24, 67, 35, 7, -20, 32, 30,
+  27, 21, -29, -13, 14, 66, -60, -17, -39, -13, -9, 13, 35, -68, -18, -5, 43, 75, -35, 3,
+  -5, 10, 35, 33, -21, -23, -10, -2, -39, -23, 3, 4, 9, 63, -29, -35, 3, 36, 36, -2,
+  -20, 15, -28, 3, -91, 29, -25, 4, 42, -7, 38, -48, 46, -31, -9, -5, -19, -27, 10, 8,
+  35, 41, -42, 9, 3, -40, 30, -2, -11, -69, 18, -14, 37, 10, -26, -14, 3, 27, -2, 29,
+  -27, -23, -5, -31, -3, -45, -68, 0, 1, -47, 23, -40, -40, -12, 42, 60, -13, -38, 47, 2,
+  -51, -5, -6, -8, 56, 42, -30, 12, 7, 83, -20, 11, 29, -1, 20, 27, -15, -40, -16, 30,
+  8, 29, 8, 26, -16, 28, 41, 28, 33, 28, -44, 57, 17, 27, 1, -19, -27, 32, -27, -32,
+  -22, -18, 51, 42, 49, -12, 1, 46, 68, -33, 0, 10, -5, -32, 3, 28, -76, 35, -39, 23,
+  60, 14, 40, -1, -2, -19, 30, -13, -1, -17, 5, -39, 15, 8, 49, -21, 14, 15, -5, 74,
+  -6, 61, 11, -15, 58, -67, -47, 24, -2, 7, -24, -30, -31, -36, 22, -41, 9, 5, -45, -6,
+  -103, 25, 23, -28, -20, 32, -2, -62, -26, 7, -8, 10, 3, -76, 26, 23, 31, 2, -47, 8,
+  -20, 26, 2, -14, -22, 14, -71, -19, 1, -50, 27, -37, -5, -29, -66, -32, -12, 3, -15, 39,
+  -14, 58, 33, 26, 20, -10, -17, 22, 39, -5, 9, 33, 14, -22, 5, -26, 11, -19, 75, -42,
+  -10, -27, -55, -48, 25, 17, 13, 1, 72, -41, 65, -7, -26, -1, 45, -13, 2, -5, 9, -24,
+  45, 27, -35, 1, -20, 36, 11, 18, 16, -32, 19, -18, 40, 33, 7, 33, 35, 34, -26, 25,
+  45, -62, 22, -43, -5, -44, 7, 9, 7, -3, 28, -45, 1, 40, -36, -29, 27, -20, 1, 127,
+  34, -26, 19, -10, -21, -12, -57, 6, -6, 57, 7, 23, -70, 10, 34, -5, 29, 97, -30, 34,
+  30, -10, 1, 76, -30, -38, -39, 7, 32, -20, 37, 0, 0, 28, -33, -2, -16, -3, 5, 25,
+  -11, 23, 2, 24, -13, -9, -3, -23, -19, -33, -32, -19, 5, -12, -28, 4, 11, -3, -15, 13,
+  -8, -43, -24, 15, 11, -16, -30, 80, -39, -60, -4, -7, -31, 11, 47, -1, -46, -3, 8, -42,
+  22, 2, -7, 41, -37, 6, 3, 6, 52, 36, 24, -12, -47, -30, 1, 11, -7, 18, -32, 15,
+  -18, 7, 40, 44, -23, -5, -65, -7, 41, -20, -49, -16, 9, 52, -80, -41, 73, -28, 0, -14,
+  -27, 34, -8, -50, 36, -47, -19, -16, -46, 13, 18, -8, 61, -5, 22, 9, -25, 36, -11, -28,
+  17, -4, -11, 38, 34, 30, 36, 22, 66, -50, 31, 13, -73, -11, -6
+};
+
+const int32_t MLP_BIAS_0[25] = {
+  -2, 0, -19, 14, 144, -37, 8, -8,
+  31, -6, 30, 125, -11, 0, -32, -18,
+  -26, 2, -12, -12, 16, 26, 4, -4,
+  -28
+};
+
+const int8_t MLP_WEIGHTS_1[375] = {
+  14, 38, -27, 79, 69, 15, -67, 16, -20, -67, 50, 4, 15, 78, -52, -37, -31, -31, -35, 27,
+  31, -68, -29, 27, 32, -103, -12, 51, -17, -3, 26, -28, -9, 54, -27, 24, -29, -15, 9, -58,
+  -20, -30, 2, -48, 60, -28, 52, 50, 31, 41, 30, -43, 18, -52, 10, 26, 6, 74, -30, 4,
+  -10, -77, -2, 51, 81, -44, -31, -2, -12, -37, -12, -46, 47, -99, -48, -88, -11, -39, -33, 66,
+  -19, 74, 16, 11, 11, -11, 63, 27, -56, 39, 31, 11, -1, -1, -30, 52, 35, -6, -18, 42,
+  22, 23, -6, -59, -29, -12, -43, -29, 54, -31, -99, 45, 103, -8, -11, -20, 23, -38, 111, 9,
+  28, -64, 29, -14, 17, 55, 3, -10, 72, 40, 1, -41, 99, 34, -25, 56, -15, -34, -79, 80,
+  9, -61, 22, 20, 32, 25, -25, -30, -21, 37, 70, 15, 66, -43, -50, 21, 53, 32, -17, -65,
+  -7, -1, -22, 21, 30, 16, 109, 69, 27, 27, -48, -80, -25, 16, 33, 47, 85, 79, -45, 15,
+  -21, 15, -51, 61, 2, 36, 19, -84, -25, -32, 41, 10, -1, 34, -36, 31, -26, 0, 36, -41,
+  20, 7, -11, -3, -80, -92, -29, -4, 15, 47, 74, -57, -52, -53, -47, 35, -27, -41, 38, -4,
+  -35, -66, 59, 37, 6, 42, -68, -73, 6, 96, -10, 16, 17, 7, -44, -11, 61, 27, 29, 2,
+  -78, 8, -10, 58, 20, -13, 66, 21, -21, 5, -13, -13, 16, 23, 26, 71, 21, 2, 55, 36,
+  -18, 10, 0, 10, -30, -79, -13, 43, 78, -61, 23, -21, 15, 46, 102, -72, 3, -5, 4, 9,
+  -13, 27, -66, -3, 16, 37, 72, -55, -19, 8, -66, -60, 127, 19, -40, -29, 5, -37, -31, 18,
+  -60, 8, 16, 12, 1, 19, -12, 40, -35, -22, 45, 63, -3, -11, -46, -29, 43, -3, 31, -6,
+  35, -84, -31, -5, 5, 10, 7, 87, -56, -45, -20, 34, -32, 92, -24, -52, 16, 33, -4, 2,
+  50, -65, -2, -3, -15, 5, -39, -33, 22, 52, -21, -10, 45, 5, -32, -1, -17, 35, 4, 5,
+  -60, 20, 5, 37, 81, -72, -2, 33, -16, -70, 25, 6, -38, 64, -63
+};
+
+const int32_t MLP_BIAS_1[15] = {
+  6, 12, 0, 17, -12, 4, -19, 88,
+  -1, 69, -9, -2, 33, -13, 0
+};
+
+const int8_t MLP_WEIGHTS_2[150] = {
+  -9, 7, 20, -75, 23, 34, 38, -52, 10, -38, -28, 20, -23, 66, 40, 38, 8, 71, 25, -44,
+  59, -70, -20, -15, 67, -39, -38, 25, -14, 56, 2, 87, -37, 15, 9, -44, 13, -4, -43, 18,
+  11, 16, 27, -6, -68, -29, 69, -1, 12, -33, 33, -16, 53, -19, 22, 42, 23, 37, -5, -101,
+  15, -30, 92, 102, -35, -22, 34, 2, 49, 35, -11, -1, 3, 16, -4, -46, 17, 78, 66, 68,
+  33, -5, 66, -32, -18, 7, -16, 33, 1, 61, -62, 63, -8, 25, 2, -31, 59, -22, 48, 50,
+  33, -49, 6, -12, -36, 34, -13, 9, -14, -2, -14, 6, 34, 26, 123, -21, 0, 127, -10, -7,
+  14, -3, -38, -14, 86, -27, -4, 12, 50, -36, 22, 45, 27, 4, 12, 24, -49, -24, -16, -59,
+  -2, 29, 1, 4, 68, -15, 79, 19, -20, -27
+};
+
+const int32_t MLP_BIAS_2[10] = {
+  -13, 36, 9, 33, -5, 3, -5, 68,
+  -6, 2
+};
+
+const int8_t MLP_WEIGHTS_3[60] = {
+  -59, 69, 8, 29, 47, -10, -40, 72, -23, 44, -127, -60, -51, 12, -7, -33, 60, -37, -3, -41,
+  -14, -28, -82, -11, 81, -40, 11, 5, 41, 1, -33, -57, 6, -3, 41, -6, -27, -89, -111, 6,
+  -6, -7, -13, -14, -35, 16, -9, -5, 26, 26, -45, -30, 26, 29, -19, -19, -25, 31, 29, -58
+};
+
+const int32_t MLP_BIAS_3[6] = {
+  38, 9, -12, -21, -4, -5
+};
+
+const MlpDenseLayer MLP_LAYERS[] = {
+  {35, 25, MLP_WEIGHTS_0, MLP_BIAS_0, 111, -128, 1180408000, -7, -128, 127},
+  {25, 15, MLP_WEIGHTS_1, MLP_BIAS_1, 128, -128, 1898367856, -7, -128, 127},
+  {15, 10, MLP_WEIGHTS_2, MLP_BIAS_2, 128, -128, 1634235070, -6, -128, 127},
+  {10, 6, MLP_WEIGHTS_3, MLP_BIAS_3, 128, 2, 1135504581, -6, -128, 127},
+};
+
+const MlpModel MLP_MODEL = {
+  MLP_LAYERS, 4,
+  0.401216716F, -111,  // Input scale and zero point
+  1785209088, 26, -31,  // Softmax multiplier, shift and smallest difference
+  1.0F / 256, -128,  // Score scale and zero point
+  MLP_LABELS
+};
+
+#endif // MLP_MODEL_H
@@ -0,0 +1,136 @@
+/*
+ * motion.h - Motion and Settling Detection
+ *
+ * Watches the filtered flex and gyroscope stream so inference can run when
+ * the hand settles into a pose instead of on a fixed timer. The hand is
+ * moving while any finger bends faster than MOTION_FLEX_THRESHOLD per sample
+ * or the gyroscope turns faster than MOTION_GYRO_THRESHOLD, and settles after
+ * MOTION_SETTLE_SAMPLES quiet samples in a row. Inference is wanted from the
+ * settle, every SETTLED_INFERENCE_INTERVAL_MS, until a window holding only the
+ * settled pose has been classified and the decision layer has recognized the
+ * pose's top label; after that the result cannot change, so it is skipped
+ * until the hand moves or the pose drifts.
+ */
+
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sensors.h"
+#include "decision.h"
+
+// Change detector state and inference counters
+struct MotionState {
+  float lastFlex[5];          // Previous filtered bend of each finger
+  float settledFlex[5];       // Bend of each finger when the hand settled
+  bool primed;                // lastFlex holds a sample
+  bool settled;
+  int quietSamples;           // Consecutive samples below the motion thresholds
+  int settledSamples;         // Samples since the hand settled
+  bool settledWindowClassified;  // A window holding only the settled pose has been classified
+
+  unsigned long settles;            // Settle events
+  unsigned long inferencesRun;      // Inference task runs that went to the classifier
+  unsigned long inferencesSkipped;  // Inference task runs suppressed by the detector
+};
+
+extern MotionState motion;
+
+/**
+ * @brief Reset the detector to the moving state and clear its counters
+ */
+void initMotionDetector();
+
+/**
+ * @brief Feed the latest filtered sample to the detector
+ * @return Whether the hand settled (or its settled pose changed) with this sample
+ */
+bool updateMotionDetector();
+
+/**
+ * @brief Whether the inference task should run the classifier now, counting the decision
+ */
+bool motionWantsInference();
+
+/**
+ * @brief Print settle events and run/skipped inference counts
+ */
+void printMotionStats();
+
+// Implementation section ---------------------------------
+
+MotionState motion;
+
+void initMotionDetector() {
+  memset(&motion, 0, sizeof(motion));
+}
+
+bool updateMotionDetector() {
+  // Fastest finger bend since the previous sample
+  float flexSpeed = 0;
+  for (int i = 0; i < 5; i++) {
+    if (motion.primed) {
+      flexSpeed = max(flexSpeed, fabsf(filteredFlexValues[i] - motion.lastFlex[i]));
+    }
+    motion.lastFlex[i] = filteredFlexValues[i];
+  }
+  motion.primed = true;
+
+  float gyroSpeed = max(fabsf(filteredGx), max(fabsf(filteredGy), fabsf(filteredGz)));
+  bool moving = flexSpeed > MOTION_FLEX_THRESHOLD || gyroSpeed > MOTION_GYRO_THRESHOLD;
+
+  if (moving) {
+    motion.quietSamples = 0;
+    motion.settled = false;
+    return false;
+  }
+
+  if (motion.settled) {
+    motion.settledSamples++;
+
+    // A slow drift to another pose never trips the speed thresholds - treat it as a new settle
+    bool poseChanged = false;
+    for (int i = 0; i < 5; i++) {
+      if (fabsf(filteredFlexValues[i] - motion.settledFlex[i]) > MOTION_POSE_CHANGE) {
+        poseChanged = true;
+      }
+    }
+    if (!poseChanged) return false;
+  } else if (++motion.quietSamples < MOTION_SETTLE_SAMPLES) {
+    return false;
+  }
+
+  motion.settled = true;
+  motion.settledSamples = 0;
+  motion.settledWindowClassified = false;
+  memcpy(motion.settledFlex, filteredFlexValues, sizeof(motion.settledFlex));
+  motion.settles++;
+  return true;
+}
+
+bool motionWantsInference() {
+  // Done once the features only see the settled pose and the decision has caught up with its label
+  bool decided = motion.settledWindowClassified && decision.gesture == decision.top;
+  if (motion.settled && !decided) {
+    if (motion.settledSamples >= WINDOW_SIZE) motion.settledWindowClassified = true;
+    motion.inferencesRun++;
+    return true;
+  }
+  motion.inferencesSkipped++;
+  return false;
+}
+
+void printMotionStats() {
+  Serial.println("\nInference trigger:");
+  Serial.print("  hand ");
+  Serial.println(motion.settled ? "settled" : "moving");
+  Serial.print("  settle events ");
+  Serial.println(motion.settles);
+  Serial.print("  inferences run ");
+  Serial.print(motion.inferencesRun);
+  Serial.print(", skipped ");
+  Serial.println(motion.inferencesSkipped);
+}
+
+#endif // MOTION_H
@@ -0,0 +1,181 @@
+/*
+ * scheduler.h - Cooperative Task Scheduler
+ *
+ * Runs the periodic jobs of the main loop from a single task table. Each call
+ * to runScheduler() runs only the most urgent due task (lowest priority value,
+ * then earliest deadline), so sampling never waits for more than one short
+ * task. Deadlines advance by whole periods, keeping each task phase-locked
+ * instead of drifting with loop() timing.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+#define MAX_TASKS 8
+
+typedef void (*TaskFunction)();
+
+// A periodic task and its timing statistics
+struct Task {
+  const char* name;
+  TaskFunction function;
+  unsigned long periodUs;
+  uint8_t priority;             // 0 = most urgent
+  unsigned long nextRunUs;      // Release time of the next run
+
+  unsigned long runs;
+  unsigned long missed;         // Releases skipped because the task started a full period late
+  unsigned long maxJitterUs;    // Largest delay between release and start
+  uint64_t totalJitterUs;
+  unsigned long maxRunUs;       // Longest execution time
+};
+
+extern Task tasks[MAX_TASKS];
+extern int taskCount;
+
+/**
+ * @brief Add a periodic task
+ * @param name Name shown in the statistics
+ * @param function Function to run
+ * @param periodMs Period in milliseconds
+ * @param priority Priority among due tasks, 0 is the most urgent
+ * @return Task index, or -1 if the table is full
+ */
+int addTask(const char* name, TaskFunction function, unsigned long periodMs, uint8_t priority);
+
+/**
+ * @brief Release a task now, for events that should not wait for its next period
+ * @param index Task index returned by addTask()
+ * @note The task stays periodic, phase-locked to this release
+ */
+void releaseTask(int index);
+
+/**
+ * @brief Release all tasks now and clear their statistics
+ */
+void startScheduler();
+
+/**
+ * @brief Run the most urgent due task, if any
+ * @return Whether a task was run
+ */
+bool runScheduler();
+
+/**
+ * @brief Time until the next task is released
+ */
+unsigned long nextTaskDelayUs();
+
+/**
+ * @brief Clear the timing statistics of all tasks
+ */
+void resetSchedulerStats();
+
+/**
+ * @brief Print run counts, jitter and missed deadlines of each task
+ */
+void printSchedulerStats();
+
+// Implementation section ---------------------------------
+
+Task tasks[MAX_TASKS];
+int taskCount = 0;
+
+int addTask(const char* name, TaskFunction function, unsigned long periodMs, uint8_t priority) {
+  if (taskCount >= MAX_TASKS) return -1;
+
+  Task& task = tasks[taskCount];
+  task.name = name;
+  task.function = function;
+  task.periodUs = periodMs * 1000UL;
+  task.priority = priority;
+  task.nextRunUs = micros();
+  return taskCount++;
+}
+
+void releaseTask(int index) {
+  if (index < 0 || index >= taskCount) return;
+  tasks[index].nextRunUs = micros();
+}
+
+void startScheduler() {
+  unsigned long now = micros();
+  for (int i = 0; i < taskCount; i++) {
+    tasks[i].nextRunUs = now;
+  }
+  resetSchedulerStats();
+}
+
+bool runScheduler() {
+  unsigned long now = micros();
+
+  // Pick the most urgent released task
+  int selected = -1;
+  for (int i = 0; i < taskCount; i++) {
+    if ((long)(now - tasks[i].nextRunUs) < 0) continue;
+    if (selected < 0 ||
+        tasks[i].priority < tasks[selected].priority ||
+        (tasks[i].priority == tasks[selected].priority &&
+         (long)(tasks[i].nextRunUs - tasks[selected].nextRunUs) < 0)) {
+      selected = i;
+    }
+  }
+  if (selected < 0) return false;
+
+  Task& task = tasks[selected];
+  unsigned long jitter = now - task.nextRunUs;
+
+  // Advance by whole periods, counting any releases that were skipped
+  unsigned long skipped = jitter / task.periodUs;
+  task.missed += skipped;
+  task.nextRunUs += (skipped + 1) * task.periodUs;
+
+  task.function();
+
+  unsigned long runTime = micros() - now;
+  task.runs++;
+  task.totalJitterUs += jitter;
+  if (jitter > task.maxJitterUs) task.maxJitterUs = jitter;
+  if (runTime > task.maxRunUs) task.maxRunUs = runTime;
+  return true;
+}
+
+unsigned long nextTaskDelayUs() {
+  unsigned long now = micros();
+  unsigned long shortest = 0xFFFFFFFFUL;
+  for (int i = 0; i < taskCount; i++) {
+    long remaining = (long)(tasks[i].nextRunUs - now);
+    if (remaining <= 0) return 0;
+    if ((unsigned long)remaining < shortest) shortest = remaining;
+  }
+  return shortest;
+}
+
+void resetSchedulerStats() {
+  for (int i = 0; i < taskCount; i++) {
+    tasks[i].runs = 0;
+    tasks[i].missed = 0;
+    tasks[i].maxJitterUs = 0;
+    tasks[i].totalJitterUs = 0;
+    tasks[i].maxRunUs = 0;
+  }
+}
+
+void printSchedulerStats() {
+  Serial.println("\nTask statistics:");
+  Serial.println("  task        period(ms)      runs  missed  jitter avg/max(us)  run max(us)");
+
+  char line[96];
+  for (int i = 0; i < taskCount; i++) {
+    const Task& task = tasks[i];
+    unsigned long averageJitter = task.runs ? (unsigned long)(task.totalJitterUs / task.runs) : 0;
+    snprintf(line, sizeof(line), "  %-10s %10lu %9lu %7lu %9lu/%-9lu %12lu",
+             task.name, task.periodUs / 1000, task.runs, task.missed,
+             averageJitter, task.maxJitterUs, task.maxRunUs);
+    Serial.println(line);
+  }
+}
+
+#endif // SCHEDULER_H
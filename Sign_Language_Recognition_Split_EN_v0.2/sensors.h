@@ -10,23 +10,50 @@
 #include <Arduino_LSM9DS1.h>
 #include <Sign-Language-Glove_inferencing.h>
 #include "config.h"
+#include "calibration.h"
+#ifdef USE_ADAPTIVE_CALIBRATION
+#include "adaptive_calibration.h"
+#endif
+#include "window_stats.h"
+#include "window_simd.h"
+#include "fixed_point.h"
+#include "filter_bank.h"
 
-// Store filtered sensor values
+// The model input is the window features, channel by channel (feature_spec.h)
+static_assert(FEATURE_COUNT == EI_CLASSIFIER_NN_INPUT_FRAME_SIZE,
+              "WINDOW_CHANNELS and WINDOW_STATISTICS do not match the input of the Edge Impulse model");
+
+// Store raw and filtered sensor values
+extern int lastFlexRawValues[5];
 extern float filteredFlexValues[5];
 extern float filteredAx, filteredAy, filteredAz;
 extern float filteredGx, filteredGy, filteredGz;
 
-// Data windows for statistical features
-extern float thumbWindow[WINDOW_SIZE];
-extern float indexWindow[WINDOW_SIZE];
-extern float middleWindow[WINDOW_SIZE];
-extern float ringWindow[WINDOW_SIZE];
-extern float pinkyWindow[WINDOW_SIZE];
+// Filtered value of each sensor channel, indexed by SensorChannel
+extern float* const channelValues[SENSOR_CHANNEL_COUNT];
+
+#ifdef USE_FIXED_POINT
+// Q31 filter state of each sensor channel, indexed by SensorChannel
+extern int32_t filteredQ31[SENSOR_CHANNEL_COUNT];
+
+// Q15 data window of the fixed-point pipeline
+extern int16_t sensorWindowQ15[WINDOW_CHANNEL_COUNT][WINDOW_STRIDE];
+#else
+// Filter chains of the flex and IMU channels
+extern FLEX_FILTER flexFilter;
+extern IMU_FILTER imuFilter;
+
+// Data window for statistical features - one row of WINDOW_SIZE samples per WINDOW_CHANNELS entry,
+// each row aligned and padded to WINDOW_STRIDE for the vector kernels
+extern float sensorWindow[WINDOW_CHANNEL_COUNT][WINDOW_STRIDE];
+
+// Running statistics for each window row, updated sample by sample
+extern RunningStats channelStats[WINDOW_CHANNEL_COUNT];
+#endif
 extern int windowIndex;
 extern bool windowFilled;
-
-// Model input feature buffer
-extern float features[FEATURE_COUNT];
+extern uint32_t sampleSequence;
+extern unsigned long lastSampleTimeUs;   // Capture time of the newest sample in the window
 
 /**
  * @brief Initialize all sensors
@@ -35,19 +62,30 @@ extern float features[FEATURE_COUNT];
 bool initSensors();
 
 /**
- * @brief Bend percentage calculation function - handles both increasing and decreasing ADC values
+ * @brief Bend percentage calculation function - looks the ADC value up in the bend table of the finger
+ * @param bendTable FlexCalibration::bendQ15 row of the finger
  */
-float calculateBendPercentage(int adcValue, int straightAdc, int bentAdc);
+float calculateBendPercentage(const int16_t* bendTable, int adcValue);
 
 /**
- * @brief Low-pass filter function
+ * @brief Read all sensor data
  */
-float lowPassFilter(float currentValue, float previousFilteredValue, float alpha);
+void readAllSensors();
 
 /**
- * @brief Read all sensor data
+ * @brief Convert one set of flex ADC readings to bend percentages and filter them
  */
-void readAllSensors();
+void processFlexReadings(const int* flexRawValues);
+
+/**
+ * @brief Read and filter the IMU if a new reading is available
+ */
+void readImu();
+
+/**
+ * @brief Latest raw flex ADC readings, without touching the ADC while the sampler owns it
+ */
+void readFlexRaw(int* flexRawValues);
 
 /**
  * @brief Update the data window with latest sensor readings
@@ -55,114 +93,190 @@ void readAllSensors();
 void updateDataWindow();
 
 /**
- * @brief Calculate statistics for a sensor data window
+ * @brief Calculate statistics for a sensor data window with two full passes
  * @param window Pointer to the data window
- * @param stats Array to store the 7 statistics
+ * @param stats Array to store the STATS_PER_SENSOR statistics
+ * @note Reference implementation - the features come from channelStats
  */
 void calculateStatistics(float* window, float* stats);
 
 /**
- * @brief Prepare feature data for inference
+ * @brief The statistics of one window channel, straight from the statistics engine
+ * @param ch Window row (index into WINDOW_CHANNELS)
+ * @param stats Array to store the STATS_PER_SENSOR statistics
  */
-void prepareFeatures();
+void getChannelFeatures(int ch, float* stats);
+
+/**
+ * @brief Mean of one window channel over the window
+ * @param ch Window row (index into WINDOW_CHANNELS)
+ */
+float getChannelMean(int ch);
 
 /**
  * @brief Define static callback function for getting feature data
+ * @note Model input view - features [offset, offset + length) are computed from the window on
+ *       each call, whole channels directly into out_ptr, with no intermediate feature buffer
  */
 int get_signal_data(size_t offset, size_t length, float *out_ptr);
 
+/**
+ * @brief Same view as get_signal_data(), quantized for an int8 input tensor
+ * @param scale Input tensor scale
+ * @param zeroPoint Input tensor zero point
+ * @param out_ptr Receives round(feature / scale) + zeroPoint, saturated to int8
+ */
+int get_signal_data_int8(size_t offset, size_t length, float scale, int zeroPoint, int8_t *out_ptr);
+
 // Implementation section -----------------------
 
-// Store filtered sensor values
+// Store raw and filtered sensor values
+int lastFlexRawValues[5] = {0};
 float filteredFlexValues[5] = {0};
 float filteredAx = 0, filteredAy = 0, filteredAz = 0;
 float filteredGx = 0, filteredGy = 0, filteredGz = 0;
 
-// Data windows for statistical features
-float thumbWindow[WINDOW_SIZE] = {0};
-float indexWindow[WINDOW_SIZE] = {0};
-float middleWindow[WINDOW_SIZE] = {0};
-float ringWindow[WINDOW_SIZE] = {0};
-float pinkyWindow[WINDOW_SIZE] = {0};
+float* const channelValues[SENSOR_CHANNEL_COUNT] = {
+  &filteredFlexValues[0], &filteredFlexValues[1], &filteredFlexValues[2],
+  &filteredFlexValues[3], &filteredFlexValues[4],
+  &filteredAx, &filteredAy, &filteredAz,
+  &filteredGx, &filteredGy, &filteredGz
+};
+
+#ifdef USE_FIXED_POINT
+int32_t filteredQ31[SENSOR_CHANNEL_COUNT] = {0};
+alignas(32) int16_t sensorWindowQ15[WINDOW_CHANNEL_COUNT][WINDOW_STRIDE] = {{0}};
+#else
+FLEX_FILTER flexFilter;
+IMU_FILTER imuFilter;
+
+// Data window for statistical features
+alignas(32) float sensorWindow[WINDOW_CHANNEL_COUNT][WINDOW_STRIDE] = {{0}};
+
+// Running statistics of each window row
+RunningStats channelStats[WINDOW_CHANNEL_COUNT];
+#endif
 int windowIndex = 0;
 bool windowFilled = false;
-
-// Model input feature buffer
-float features[FEATURE_COUNT];
+uint32_t sampleSequence = 0;
+unsigned long lastSampleTimeUs = 0;
 
 bool initSensors() {
-  return IMU.begin();
-}
-
-float calculateBendPercentage(int adcValue, int straightAdc, int bentAdc) {
-  // Ensure ADC value is within range to prevent extreme cases
-  adcValue = constrain(adcValue, min(straightAdc, bentAdc), max(straightAdc, bentAdc));
-  
-  // Calculate bend percentage (0% = straight, 100% = fully bent)
-  float bendPercentage;
-  
-  // Handle both cases: ADC values that increase or decrease with bending
-  if (bentAdc > straightAdc) {
-    // Standard case: ADC value increases when bent
-    bendPercentage = map(adcValue, straightAdc, bentAdc, 0, 100);
-  } else {
-    // Reverse case: ADC value decreases when bent
-    bendPercentage = map(adcValue, straightAdc, bentAdc, 0, 100);
+  #ifndef USE_FIXED_POINT
+  for (int ch = 0; ch < WINDOW_CHANNEL_COUNT; ch++) {
+    initRunningStats(&channelStats[ch], sensorWindow[ch]);
   }
+  #endif
+  
+  #if FLEX_ADC_BITS != 10
+  analogReadResolution(FLEX_ADC_BITS);
+  #endif
   
-  // Ensure result is within 0-100 range
-  return constrain(bendPercentage, 0, 100);
+  return IMU.begin();
 }
 
-float lowPassFilter(float currentValue, float previousFilteredValue, float alpha) {
-  return previousFilteredValue + alpha * (currentValue - previousFilteredValue);
+float calculateBendPercentage(const int16_t* bendTable, int adcValue) {
+  // Keep the index within the table (a single USAT on the Cortex-M4) - the SAADC can return
+  // slightly negative values near 0 V
+  return bendTable[constrain(adcValue, 0, FLEX_ADC_LEVELS - 1)] * (1.0F / 256);
 }
 
 void readAllSensors() {
   // Read flex sensor data
   int flexRawValues[5];
-  flexRawValues[0] = analogRead(FLEX_PIN_THUMB);
-  flexRawValues[1] = analogRead(FLEX_PIN_INDEX);
-  flexRawValues[2] = analogRead(FLEX_PIN_MIDDLE);
-  flexRawValues[3] = analogRead(FLEX_PIN_RING);
-  flexRawValues[4] = analogRead(FLEX_PIN_PINKY);
+  for (int i = 0; i < 5; i++) {
+    flexRawValues[i] = analogRead(FLEX_PINS[i]);
+  }
+  
+  processFlexReadings(flexRawValues);
+  readImu();
+}
+
+void processFlexReadings(const int* flexRawValues) {
+  #ifdef USE_ADAPTIVE_CALIBRATION
+  // Follow drift of the raw readings before they are converted
+  trackFlexDrift(flexRawValues);
+  #endif
   
   // Convert ADC values to bend percentages and apply filtering
   for (int i = 0; i < 5; i++) {
-    float bendPercentage = calculateBendPercentage(
-      flexRawValues[i], 
-      FLEX_STRAIGHT_ADC[i], 
-      FLEX_BENT_ADC[i]
-    );
+    lastFlexRawValues[i] = flexRawValues[i];
     
-    // Apply low-pass filter
-    filteredFlexValues[i] = lowPassFilter(bendPercentage, filteredFlexValues[i], ALPHA);
+    #ifdef USE_FIXED_POINT
+    int16_t bendQ15 = bendPercentageQ15(flexCalibration.bendQ15[i], flexRawValues[i]);
+    filteredQ31[i] = lowPassQ31(filteredQ31[i], bendQ15);
+    
+    // Float copy for the display and serial commands
+    filteredFlexValues[i] = fromQ15(q31ToQ15(filteredQ31[i]), CHANNEL_SCALE_SHIFT[i]);
+    #else
+    filteredFlexValues[i] = calculateBendPercentage(flexCalibration.bendQ15[i], flexRawValues[i]);
+    #endif
   }
   
-  // Read IMU data
+  #ifndef USE_FIXED_POINT
+  // Filter all five fingers in one pass
+  flexFilter.process(filteredFlexValues);
+  #endif
+}
+
+void readImu() {
   float ax, ay, az, gx, gy, gz;
   
   if (IMU.accelerationAvailable() && IMU.gyroscopeAvailable()) {
     IMU.readAcceleration(ax, ay, az);
     IMU.readGyroscope(gx, gy, gz);
     
-    // Apply low-pass filter
-    filteredAx = lowPassFilter(ax, filteredAx, ALPHA);
-    filteredAy = lowPassFilter(ay, filteredAy, ALPHA);
-    filteredAz = lowPassFilter(az, filteredAz, ALPHA);
-    filteredGx = lowPassFilter(gx, filteredGx, ALPHA);
-    filteredGy = lowPassFilter(gy, filteredGy, ALPHA);
-    filteredGz = lowPassFilter(gz, filteredGz, ALPHA);
+    #ifdef USE_FIXED_POINT
+    // The IMU library reports floats - convert once, then filter in Q31
+    float imuValues[6] = {ax, ay, az, gx, gy, gz};
+    for (int i = 0; i < 6; i++) {
+      int ch = CHANNEL_ACCEL_X + i;
+      filteredQ31[ch] = lowPassQ31(filteredQ31[ch], toQ15(imuValues[i], CHANNEL_SCALE_SHIFT[ch]));
+      *channelValues[ch] = fromQ15(q31ToQ15(filteredQ31[ch]), CHANNEL_SCALE_SHIFT[ch]);
+    }
+    #else
+    // Filter all six axes in one pass
+    float imuValues[6] = {ax, ay, az, gx, gy, gz};
+    imuFilter.process(imuValues);
+    for (int i = 0; i < 6; i++) {
+      *channelValues[CHANNEL_ACCEL_X + i] = imuValues[i];
+    }
+    #endif
+  }
+}
+
+void readFlexRaw(int* flexRawValues) {
+#ifdef USE_ADC_SAMPLER
+  // The sampler owns the ADC - report the readings it delivered last
+  for (int i = 0; i < 5; i++) {
+    flexRawValues[i] = lastFlexRawValues[i];
   }
+#else
+  for (int i = 0; i < 5; i++) {
+    flexRawValues[i] = analogRead(FLEX_PINS[i]);
+  }
+#endif
 }
 
 void updateDataWindow() {
-  // Add latest data to the window
-  thumbWindow[windowIndex] = filteredFlexValues[0];
-  indexWindow[windowIndex] = filteredFlexValues[1];
-  middleWindow[windowIndex] = filteredFlexValues[2];
-  ringWindow[windowIndex] = filteredFlexValues[3];
-  pinkyWindow[windowIndex] = filteredFlexValues[4];
+  #ifdef USE_FIXED_POINT
+  // Add the latest Q15 samples to the window
+  for (int ch = 0; ch < WINDOW_CHANNEL_COUNT; ch++) {
+    sensorWindowQ15[ch][windowIndex] = q31ToQ15(filteredQ31[WINDOW_CHANNELS[ch]]);
+  }
+  #else
+  // Add latest data to the window and update the running statistics
+  for (int ch = 0; ch < WINDOW_CHANNEL_COUNT; ch++) {
+    float oldValue = sensorWindow[ch][windowIndex];
+    sensorWindow[ch][windowIndex] = *channelValues[WINDOW_CHANNELS[ch]];
+    #ifndef USE_SIMD_STATISTICS
+    pushRunningStats(&channelStats[ch], sampleSequence, oldValue);
+    #else
+    (void)oldValue;
+    #endif
+  }
+  #endif
+  sampleSequence++;
   
   // Update window index
   windowIndex = (windowIndex + 1) % WINDOW_SIZE;
@@ -174,8 +288,9 @@ void updateDataWindow() {
 }
 
 void calculateStatistics(float* window, float* stats) {
+  float all[STATISTIC_COUNT];
   float sum = 0, sum2 = 0;
-  float min = 1000, max = -1000;
+  float min = window[0], max = window[0];
   
   // Calculate basic statistics
   for (int i = 0; i < WINDOW_SIZE; i++) {
@@ -188,16 +303,16 @@ void calculateStatistics(float* window, float* stats) {
   
   // Average (mean)
   float mean = sum / WINDOW_SIZE;
-  stats[0] = mean;
+  all[STAT_MEAN] = mean;
   
   // Minimum
-  stats[1] = min;
+  all[STAT_MIN] = min;
   
   // Maximum
-  stats[2] = max;
+  all[STAT_MAX] = max;
   
   // Root-mean square
-  stats[3] = sqrt(sum2 / WINDOW_SIZE);
+  all[STAT_RMS] = sqrt(sum2 / WINDOW_SIZE);
   
   // Calculate variance for remaining statistics
   float variance = 0, skewSum = 0, kurtSum = 0;
@@ -214,65 +329,103 @@ void calculateStatistics(float* window, float* stats) {
   
   // Standard deviation
   float stdev = sqrt(variance);
-  stats[4] = stdev;
+  all[STAT_STDEV] = stdev;
   
   // Skewness - Avoid division by zero
-  stats[5] = (stdev > 0.0001) ? (skewSum / (WINDOW_SIZE * stdev * stdev * stdev)) : 0;
+  all[STAT_SKEWNESS] = (stdev > 0.0001) ? (skewSum / (WINDOW_SIZE * stdev * stdev * stdev)) : 0;
   
   // Kurtosis - Avoid division by zero
-  stats[6] = (variance > 0.0001) ? (kurtSum / (WINDOW_SIZE * variance * variance)) - 3 : 0;
+  all[STAT_KURTOSIS] = (variance > 0.0001) ? (kurtSum / (WINDOW_SIZE * variance * variance)) - 3 : 0;
+
+  selectStatistics(all, stats);
 }
 
-void prepareFeatures() {
-  // Only prepare features if window has been filled
-  if (!windowFilled) return;
-  
-  // Arrays to hold statistics for each finger
-  float thumbStats[STATS_PER_SENSOR];
-  float indexStats[STATS_PER_SENSOR];
-  float middleStats[STATS_PER_SENSOR];
-  float ringStats[STATS_PER_SENSOR];
-  float pinkyStats[STATS_PER_SENSOR];
-  
-  // Calculate statistics for each finger
-  calculateStatistics(thumbWindow, thumbStats);
-  calculateStatistics(indexWindow, indexStats);
-  calculateStatistics(middleWindow, middleStats);
-  calculateStatistics(ringWindow, ringStats);
-  calculateStatistics(pinkyWindow, pinkyStats);
-  
-  // Fill feature array in the correct order for Edge Impulse model
-  // Features order: [all thumb stats] [all index stats] [all middle stats] [all ring stats] [all pinky stats]
-  int featureIndex = 0;
-  
-  // Copy thumb statistics
-  for (int i = 0; i < STATS_PER_SENSOR; i++) {
-    features[featureIndex++] = thumbStats[i];
-  }
-  
-  // Copy index finger statistics
-  for (int i = 0; i < STATS_PER_SENSOR; i++) {
-    features[featureIndex++] = indexStats[i];
-  }
-  
-  // Copy middle finger statistics
+void getChannelFeatures(int ch, float* stats) {
+  #if defined(USE_FIXED_POINT)
+  // Integer statistics, converted once for the classifier's float input
+  int32_t statsQ16[STATS_PER_SENSOR];
+  calculateStatisticsQ15(sensorWindowQ15[ch], CHANNEL_SCALE_SHIFT[WINDOW_CHANNELS[ch]], statsQ16);
   for (int i = 0; i < STATS_PER_SENSOR; i++) {
-    features[featureIndex++] = middleStats[i];
+    stats[i] = fromQ16(statsQ16[i]);
   }
-  
-  // Copy ring finger statistics
-  for (int i = 0; i < STATS_PER_SENSOR; i++) {
-    features[featureIndex++] = ringStats[i];
+  #elif defined(USE_SIMD_STATISTICS)
+  // Rescan the channel's window row with the vector kernels
+  calculateStatisticsSimd(sensorWindow[ch], stats);
+  #else
+  // The running statistics are kept up to date by updateDataWindow(), so no window rescan is needed
+  getRunningStatistics(&channelStats[ch], stats);
+  #endif
+}
+
+float getChannelMean(int ch) {
+  #if defined(USE_FIXED_POINT)
+  int32_t sum = 0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    sum += sensorWindowQ15[ch][i];
   }
-  
-  // Copy pinky finger statistics
-  for (int i = 0; i < STATS_PER_SENSOR; i++) {
-    features[featureIndex++] = pinkyStats[i];
+  return fromQ15(sum, CHANNEL_SCALE_SHIFT[WINDOW_CHANNELS[ch]]) / WINDOW_SIZE;
+  #elif defined(USE_SIMD_STATISTICS)
+  float sum = 0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    sum += sensorWindow[ch][i];
   }
+  return sum / WINDOW_SIZE;
+  #else
+  return getRunningMean(&channelStats[ch]);
+  #endif
 }
 
 int get_signal_data(size_t offset, size_t length, float *out_ptr) {
-  memcpy(out_ptr, features + offset, length * sizeof(float));
+  if (offset + length > FEATURE_COUNT) return -1;
+
+  // Features order: [all stats of WINDOW_CHANNELS[0]] [all stats of WINDOW_CHANNELS[1]] ...
+  while (length > 0) {
+    int ch = offset / STATS_PER_SENSOR;
+    size_t first = offset % STATS_PER_SENSOR;
+    size_t count = min(length, STATS_PER_SENSOR - first);
+
+    if (count == STATS_PER_SENSOR) {
+      getChannelFeatures(ch, out_ptr);
+    } else {
+      // Partial channel at either end of the range
+      float stats[STATS_PER_SENSOR];
+      getChannelFeatures(ch, stats);
+      memcpy(out_ptr, stats + first, count * sizeof(float));
+    }
+
+    offset += count;
+    length -= count;
+    out_ptr += count;
+  }
+  return 0;
+}
+
+int get_signal_data_int8(size_t offset, size_t length, float scale, int zeroPoint, int8_t *out_ptr) {
+  if (offset + length > FEATURE_COUNT) return -1;
+
+  while (length > 0) {
+    int ch = offset / STATS_PER_SENSOR;
+    size_t first = offset % STATS_PER_SENSOR;
+    size_t count = min(length, STATS_PER_SENSOR - first);
+
+    #ifdef USE_FIXED_POINT
+    // Quantize from Q16.16 without going through float
+    int32_t statsQ16[STATS_PER_SENSOR];
+    calculateStatisticsQ15(sensorWindowQ15[ch], CHANNEL_SCALE_SHIFT[WINDOW_CHANNELS[ch]], statsQ16);
+    quantizeFeaturesInt8(statsQ16 + first, count, scale, zeroPoint, out_ptr);
+    #else
+    float stats[STATS_PER_SENSOR];
+    getChannelFeatures(ch, stats);
+    for (size_t i = 0; i < count; i++) {
+      long q = lroundf(stats[first + i] / scale) + zeroPoint;
+      out_ptr[i] = (int8_t)constrain(q, -128L, 127L);
+    }
+    #endif
+
+    offset += count;
+    length -= count;
+    out_ptr += count;
+  }
   return 0;
 }
 
@@ -0,0 +1,254 @@
+/*
+ * temporal.h - Streaming Temporal Gesture Model
+ *
+ * Classifies the sample stream itself rather than statistics of a window,
+ * so the order of the readings counts - what dynamic gestures need. The
+ * model is a stack of dilated causal 1D convolutions (a temporal
+ * convolutional network) over the filtered value of every sensor channel,
+ * with a dense softmax head on the newest time step; its weights are in
+ * temporal_model.h, trained by host/glove_temporal. Every layer keeps the
+ * inputs its taps still need in a ring, so each new sample costs one output
+ * step per layer instead of recomputing the receptive field. The scores
+ * fill an ei_impulse_result_t like run_classifier(), and with
+ * USE_TEMPORAL_MODEL they are blended into the static classifier's result
+ * with TEMPORAL_WEIGHT before the decision layer.
+ */
+
+#ifndef TEMPORAL_H
+#define TEMPORAL_H
+
+#include <Arduino.h>
+#include <Sign-Language-Glove_inferencing.h>
+#include "config.h"
+
+// One causal convolution: output(t) = bias + sum over taps j of weights[j] * input(t - j * dilation), then ReLU
+struct TemporalConvLayer {
+  uint8_t inputs;
+  uint8_t outputs;
+  uint8_t kernel;
+  uint8_t dilation;
+  uint16_t span;              // Input rows the taps reach: (kernel - 1) * dilation + 1
+  uint16_t stateOffset;       // Start of the layer's input ring in the streaming state
+  const float* weights;       // [outputs][kernel][inputs], tap 0 the newest input
+  const float* bias;
+};
+
+// Convolution stack and softmax head
+struct TemporalModel {
+  const TemporalConvLayer* layers;
+  uint8_t layerCount;
+  const float* inputMean;     // Per-channel normalization: (value - mean) * scale
+  const float* inputScale;
+  const float* headWeights;   // [labels][width of the last layer]
+  const float* headBias;
+  const char* const* labels;
+};
+
+#include "temporal_model.h"
+
+// Streaming state and per-step counters
+struct TemporalState {
+  float history[TEMPORAL_STATE_FLOATS];    // Input ring of each layer
+  float scores[TEMPORAL_LABEL_COUNT];      // Softmax of the newest step
+  uint32_t steps;                          // Samples fed since initTemporalModel()
+
+  int8_t labelIndex[TEMPORAL_LABEL_COUNT]; // Classifier label of each model label, -1 if the classifier lacks it
+  bool mapped;
+
+  unsigned long stepUs;                    // Time spent in stepTemporalModel()
+  unsigned long stepMaxUs;
+};
+
+extern TemporalState temporal;
+
+/**
+ * @brief Clear the layer history and the counters
+ */
+void initTemporalModel();
+
+/**
+ * @brief Feed the newest filtered sample through every layer, updating temporal.scores
+ * @param values Filtered value of each sensor channel, indexed by SensorChannel
+ */
+void stepTemporalModel(const float* const* values);
+
+/**
+ * @brief Scores of the newest sample computed from scratch over the receptive field, without the streaming state
+ * @param samples TEMPORAL_RECEPTIVE_FIELD rows of TEMPORAL_INPUT_COUNT channel values, oldest first
+ * @param scores Receives the softmax of the newest row
+ * @note Reference for the streaming step - the host tools check it gives the same scores, and it is
+ *       what each sample would cost without the cached layer state
+ */
+void temporalWindowScores(const float* samples, float* scores);
+
+/**
+ * @brief Fill a classifier result with the latest scores, as run_classifier() does
+ */
+EI_IMPULSE_ERROR runTemporalClassifier(ei_impulse_result_t* result);
+
+/**
+ * @brief Blend the latest scores into a static classifier result with TEMPORAL_WEIGHT
+ */
+void blendTemporalScores(ei_impulse_result_t* result);
+
+/**
+ * @brief Print the step count and time per sample
+ */
+void printTemporalStats();
+
+// Implementation section ---------------------------------
+
+TemporalState temporal;
+
+void initTemporalModel() {
+  memset(&temporal, 0, sizeof(temporal));
+  for (int i = 0; i < TEMPORAL_LABEL_COUNT; i++) {
+    temporal.scores[i] = 1.0F / TEMPORAL_LABEL_COUNT;
+  }
+}
+
+/**
+ * @brief Softmax of the dense head over the last layer's output
+ */
+void temporalHead(const float* features, float* scores) {
+  const TemporalConvLayer* last = &TEMPORAL_MODEL.layers[TEMPORAL_MODEL.layerCount - 1];
+  float maxLogit = -INFINITY;
+  for (int label = 0; label < TEMPORAL_LABEL_COUNT; label++) {
+    const float* row = TEMPORAL_MODEL.headWeights + label * last->outputs;
+    float logit = TEMPORAL_MODEL.headBias[label];
+    for (int i = 0; i < last->outputs; i++) logit += row[i] * features[i];
+    scores[label] = logit;
+    if (logit > maxLogit) maxLogit = logit;
+  }
+  float total = 0;
+  for (int label = 0; label < TEMPORAL_LABEL_COUNT; label++) {
+    scores[label] = expf(scores[label] - maxLogit);
+    total += scores[label];
+  }
+  for (int label = 0; label < TEMPORAL_LABEL_COUNT; label++) scores[label] /= total;
+}
+
+void stepTemporalModel(const float* const* values) {
+  unsigned long startUs = micros();
+  float a[TEMPORAL_MAX_WIDTH], b[TEMPORAL_MAX_WIDTH];
+  float* in = a;
+  float* out = b;
+  for (int ch = 0; ch < TEMPORAL_INPUT_COUNT; ch++) {
+    in[ch] = (*values[ch] - TEMPORAL_MODEL.inputMean[ch]) * TEMPORAL_MODEL.inputScale[ch];
+  }
+
+  for (int l = 0; l < TEMPORAL_MODEL.layerCount; l++) {
+    const TemporalConvLayer* layer = &TEMPORAL_MODEL.layers[l];
+    float* ring = temporal.history + layer->stateOffset;
+    int newest = temporal.steps % layer->span;
+    memcpy(ring + newest * layer->inputs, in, layer->inputs * sizeof(float));
+
+    for (int o = 0; o < layer->outputs; o++) {
+      float acc = layer->bias[o];
+      const float* w = layer->weights + o * layer->kernel * layer->inputs;
+      for (int tap = 0; tap < layer->kernel; tap++) {
+        // Row of the input tap * dilation samples ago
+        int row = newest - tap * layer->dilation;
+        if (row < 0) row += layer->span;
+        const float* x = ring + row * layer->inputs;
+        for (int i = 0; i < layer->inputs; i++) acc += w[i] * x[i];
+        w += layer->inputs;
+      }
+      out[o] = acc > 0 ? acc : 0;
+    }
+    float* swap = in;
+    in = out;
+    out = swap;
+  }
+  temporalHead(in, temporal.scores);
+  temporal.steps++;
+
+  unsigned long elapsedUs = micros() - startUs;
+  temporal.stepUs += elapsedUs;
+  if (elapsedUs > temporal.stepMaxUs) temporal.stepMaxUs = elapsedUs;
+}
+
+void temporalWindowScores(const float* samples, float* scores) {
+  // Every layer's output over the part of the field its successors still need
+  static float buffers[2][TEMPORAL_RECEPTIVE_FIELD * TEMPORAL_MAX_WIDTH];
+  float* in = buffers[0];
+  float* out = buffers[1];
+  int length = TEMPORAL_RECEPTIVE_FIELD;
+  for (int t = 0; t < length; t++) {
+    for (int ch = 0; ch < TEMPORAL_INPUT_COUNT; ch++) {
+      in[t * TEMPORAL_INPUT_COUNT + ch] =
+        (samples[t * TEMPORAL_INPUT_COUNT + ch] - TEMPORAL_MODEL.inputMean[ch]) * TEMPORAL_MODEL.inputScale[ch];
+    }
+  }
+
+  for (int l = 0; l < TEMPORAL_MODEL.layerCount; l++) {
+    const TemporalConvLayer* layer = &TEMPORAL_MODEL.layers[l];
+    int outLength = length - (layer->span - 1);
+    for (int t = 0; t < outLength; t++) {
+      int newest = t + layer->span - 1;
+      for (int o = 0; o < layer->outputs; o++) {
+        float acc = layer->bias[o];
+        const float* w = layer->weights + o * layer->kernel * layer->inputs;
+        for (int tap = 0; tap < layer->kernel; tap++) {
+          const float* x = in + (newest - tap * layer->dilation) * layer->inputs;
+          for (int i = 0; i < layer->inputs; i++) acc += w[i] * x[i];
+          w += layer->inputs;
+        }
+        out[t * layer->outputs + o] = acc > 0 ? acc : 0;
+      }
+    }
+    float* swap = in;
+    in = out;
+    out = swap;
+    length = outLength;
+  }
+  temporalHead(in + (length - 1) * TEMPORAL_MODEL.layers[TEMPORAL_MODEL.layerCount - 1].outputs, scores);
+}
+
+/**
+ * @brief Look up the classifier label of each model label
+ */
+void mapTemporalLabels() {
+  for (int i = 0; i < TEMPORAL_LABEL_COUNT; i++) {
+    temporal.labelIndex[i] = -1;
+    for (int label = 0; label < EI_CLASSIFIER_LABEL_COUNT; label++) {
+      if (strcmp(TEMPORAL_MODEL.labels[i], ei_classifier_inferencing_categories[label]) == 0) {
+        temporal.labelIndex[i] = label;
+      }
+    }
+  }
+  temporal.mapped = true;
+}
+
+EI_IMPULSE_ERROR runTemporalClassifier(ei_impulse_result_t* result) {
+  if (!temporal.mapped) mapTemporalLabels();
+  memset(result, 0, sizeof(*result));
+  for (int i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+    result->classification[i].label = ei_classifier_inferencing_categories[i];
+  }
+  for (int i = 0; i < TEMPORAL_LABEL_COUNT; i++) {
+    if (temporal.labelIndex[i] >= 0) result->classification[temporal.labelIndex[i]].value = temporal.scores[i];
+  }
+  return EI_IMPULSE_OK;
+}
+
+void blendTemporalScores(ei_impulse_result_t* result) {
+  ei_impulse_result_t streamed;
+  runTemporalClassifier(&streamed);
+  for (int i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+    result->classification[i].value += (float)TEMPORAL_WEIGHT *
+                                       (streamed.classification[i].value - result->classification[i].value);
+  }
+}
+
+void printTemporalStats() {
+  Serial.println("\nTemporal model:");
+  Serial.print("  steps ");
+  Serial.print(temporal.steps);
+  Serial.print(", time per sample (us): mean ");
+  Serial.print(temporal.steps ? temporal.stepUs / temporal.steps : 0);
+  Serial.print(", max ");
+  Serial.println(temporal.stepMaxUs);
+}
+
+#endif // TEMPORAL_H
@@ -0,0 +1,367 @@
+/*
+ * temporal_model.h - Streaming Temporal Model Weights
+ *
+ * Generated by host/glove_temporal from 18 captures - do not edit. Causal
+ * convolutions of width 12 and kernel 3 with dilations 1, 2, 4, 8 and 16,
+ * a receptive field of 63 samples.
+ */
+
+#ifndef TEMPORAL_MODEL_H
+#define TEMPORAL_MODEL_H
+
+#define TEMPORAL_INPUT_COUNT 11
+#define TEMPORAL_LABEL_COUNT 6
+#define TEMPORAL_MAX_WIDTH 12
+#define TEMPORAL_RECEPTIVE_FIELD 63
+#define TEMPORAL_STATE_FLOATS 801   // Input rings of the layers
+
+const char* const TEMPORAL_LABELS[TEMPORAL_LABEL_COUNT] = {"five", "four", "love", "one", "three", "two"};
+
+const float TEMPORAL_INPUT_MEAN[11] = {
+  47.67526F, 19.81797F, 33.46471F, 60.01779F, 47.48462F, -0.02324538F,
+  -0.007171009F, 0.9941817F, -0.004348698F, -0.01153752F, -0.0145825F
+};
+
+const float TEMPORAL_INPUT_SCALE[11] = {
+  0.02431699F, 0.03277174F, 0.02574643F, 0.02534775F, 0.02403975F, 15.68402F,
+  12.82069F, 119.2959F, 2.668557F, 2.838499F, 2.905587F
+};
+
+const float TEMPORAL_WEIGHTS_0[396] = {
+  0.5577374F, -0.2914247F, 0.2642881F, -0.6469495F, -0.3369421F, -0.03710882F, -0.05941898F, -0.175181F,
+  -0.01674476F, -0.1120671F, 0.102186F, 0.3779263F, 0.01515782F, 0.3830905F, -0.8212175F, -0.3688406F,
+  0.2223028F, 0.5096799F, 0.01114949F, -0.170333F, -0.03154363F, 0.01226918F, 0.3348787F, -0.312655F,
+  0.490553F, -0.2398786F, -0.4111387F, -0.3914123F, -0.4683384F, 0.4353823F, 0.1542498F, -0.05372884F,
+  0.01107527F, 0.1536331F, -0.03461877F, 0.01202538F, 0.1231197F, 0.3748049F, 0.05455481F, 0.1093163F,
+  0.109422F, 0.02818158F, 0.1013212F, -0.3162593F, -0.05498354F, 0.1993518F, -0.2811291F, 0.1125106F,
+  -0.3448046F, 0.2139086F, -0.292386F, -0.008038889F, 0.2756658F, 0.01420484F, 0.1103344F, 0.2969067F,
+  0.1918212F, 0.3910418F, -0.1244336F, 0.2195572F, -0.1456436F, -0.5172572F, 0.01406463F, 0.2872573F,
+  -0.1949562F, -0.340994F, -0.5434701F, 0.2514536F, -0.6460909F, -0.1734104F, 0.2310907F, -0.2008059F,
+  -0.2159059F, 0.296553F, -0.03782125F, -0.03244317F, 0.2678483F, -0.7118756F, 0.4040712F, -0.5570063F,
+  0.3139416F, 0.4506118F, -0.3006439F, -0.2088656F, -0.09185701F, 0.3759019F, 0.1338147F, -0.461477F,
+  -0.4731898F, 0.399993F, -0.3315451F, 0.2522234F, 0.3473766F, -0.4945025F, -0.4950357F, 0.07447232F,
+  0.1018426F, 0.1429836F, 0.04024108F, 0.4549987F, 0.4529746F, -0.3757673F, 0.07562469F, 0.576171F,
+  -0.08388707F, -0.4050467F, 0.1078634F, 0.07368685F, 0.1796372F, -0.5816233F, 0.4567986F, 0.06162681F,
+  -0.3956408F, 0.06936389F, 0.4301884F, -0.4836726F, 0.07342184F, 0.2600793F, -0.1444919F, -0.2313426F,
+  0.2078685F, 0.4728704F, 0.7123997F, 0.03129456F, -0.3375326F, 0.4486182F, 0.280657F, -0.2724183F,
+  -0.193927F, -0.230625F, -0.1768525F, 0.1743352F, 0.7443954F, -0.1283365F, -0.3313119F, 0.6429331F,
+  0.08905311F, 0.3208359F, 0.3597582F, 0.1550696F, 0.0851448F, -0.1246887F, 0.08001816F, 0.4786477F,
+  -0.5012624F, -0.607419F, 0.3188622F, 0.0516463F, 0.2948404F, 0.3353891F, -0.1428852F, 0.2981485F,
+  -0.3491865F, 0.0400599F, 0.5893162F, -0.4956175F, -0.2892789F, 0.1161995F, 0.2955604F, 0.3701025F,
+  0.1346284F, -0.2363587F, -0.003874692F, -0.3078424F, -0.1815866F, 0.8846286F, 0.1881066F, 1.183004F,
+  0.08210845F, -0.3281265F, 0.01866301F, -0.02609286F, 0.07124569F, 0.1257009F, -0.1323823F, 0.0302691F,
+  0.04358583F, 0.2411952F, 0.6384376F, 0.5075459F, -0.04312263F, -0.1054322F, 0.1164117F, 0.04334914F,
+  -0.1035713F, -0.1851176F, -0.2820855F, 0.1028263F, -0.02647274F, 0.6889803F, -0.3399519F, 0.03919793F,
+  0.0317734F, 0.1490378F, -0.01982608F, 0.03451754F, -0.1123505F, -0.2812853F, -1.407686F, 0.1927385F,
+  0.3154462F, 0.5455598F, -0.1425949F, 0.1263452F, -0.4698512F, 0.2351645F, -0.04692954F, -0.07835606F,
+  -0.05333881F, -1.28967F, 0.3157362F, 0.21123F, -0.2670245F, -0.5626163F, 0.1199363F, 0.1422604F,
+  -0.09287371F, 0.02456844F, -0.1664994F, -0.1019418F, -0.918331F, -0.08445385F, -0.07450917F, -0.05401561F,
+  0.09437887F, -0.3007155F, 0.4707096F, 0.09067804F, 0.01220917F, -0.1727957F, -0.02354574F, 0.3760881F,
+  -0.5947104F, 1.133372F, -0.09159371F, -0.07766737F, -0.1166278F, -0.03644209F, -0.3553508F, -0.1416532F,
+  0.1792003F, 0.2228048F, -0.01201834F, -0.3548735F, 0.5825265F, 0.06993463F, 0.03748947F, 0.06164625F,
+  -0.05051789F, -0.1031672F, 0.008129529F, -0.05956671F, 0.3817421F, 0.2345049F, -0.4050177F, 1.420561F,
+  0.1634756F, -0.5263063F, -0.1985426F, -0.1059069F, 0.130162F, -0.8377223F, -0.1866621F, 0.2641691F,
+  0.4790633F, 0.2052704F, 0.1944982F, 0.7770214F, -0.1764565F, -0.3312166F, -0.3740517F, 0.0330977F,
+  -0.2434737F, -0.02665721F, -0.2488326F, 0.3206771F, 0.00419861F, 0.3532118F, 0.1798748F, -0.1993797F,
+  -0.3377469F, -0.1108768F, 0.005814588F, -0.07553174F, 0.1900335F, -0.001180437F, 0.5956653F, 0.2020938F,
+  0.225807F, 0.3651593F, -0.2805121F, -0.5260117F, -0.01324254F, -0.009858059F, -0.2930645F, 0.4077813F,
+  -0.2984318F, 0.6054889F, -0.07354403F, 0.1700367F, -0.4868028F, -0.1242916F, 0.1126185F, -0.02318412F,
+  0.4506652F, 0.2219161F, -0.1736583F, 0.001312002F, -0.01685685F, 0.005143589F, 0.2262475F, -0.4058574F,
+  -0.4348072F, -0.2847037F, -0.1164674F, -0.05082481F, 0.1585661F, -0.05846956F, -0.3712966F, 0.7604887F,
+  -0.05471876F, 0.2570679F, -0.04960222F, -0.4260179F, -0.205526F, -0.06393336F, 0.01927039F, -0.1241485F,
+  -0.08620169F, 0.2398104F, 0.3153791F, -0.1803418F, 0.1885737F, 0.4202657F, -0.1237909F, 0.002889579F,
+  -0.09590251F, -0.3365018F, 0.08831249F, 0.3568978F, -0.4389515F, 0.07505414F, -0.1412272F, 0.3792464F,
+  0.381422F, -0.08232182F, 0.003143936F, 0.03735156F, -0.3269529F, 0.162282F, -0.2408903F, -0.008485718F,
+  0.3465168F, 0.2328274F, 0.02974549F, 0.05455915F, 0.0502887F, 0.03546172F, -0.4630242F, 0.3833495F,
+  0.1830301F, 0.3037778F, -0.4766892F, -0.09765536F, -0.0794973F, 0.02245034F, -0.885185F, -0.5560918F,
+  0.2380423F, 0.3050345F, 0.08423208F, -0.327856F, 0.1836897F, 0.2983271F, -0.1412631F, -0.0390682F,
+  -0.1187005F, -0.5467589F, -0.4903341F, 0.2802187F, -0.2199085F, 0.1516903F, -0.1708188F, -0.2066232F,
+  0.005296378F, 0.05676756F, -0.1333462F, 0.2010698F, -0.8954234F, 0.216587F, -0.4879271F, 0.04782555F,
+  0.1085801F, 0.04711853F, 0.2410913F, 0.2244185F
+};
+
+const float TEMPORAL_BIAS_0[12] = {
+  0.1388276F, -0.5668181F, 0.393586F, 0.5636057F, 0.07001539F, 0.1306379F, 0.1752433F, -0.07506187F,
+  0.08539495F, 0.4816192F, -0.4148069F, 0.2227802F
+};
+
+const float TEMPORAL_WEIGHTS_1[432] = {
+  -0.2926264F, 0.2071332F, 0.5965889F, 0.4221559F, 0.189942F, -0.1633651F, 0.0134472F, -0.8473601F,
+  -0.01466711F, 0.4355496F, -0.379164F, -0.3163883F, -0.4533069F, -0.04511187F, 0.1546201F, 0.3539401F,
+  0.1295109F, -0.6770198F, 0.005510289F, -0.5448861F, 0.3216319F, 0.5754482F, -0.2850752F, 0.07328793F,
+  0.09203547F, 0.2159503F, 0.4364636F, 0.50638F, -0.1537805F, -0.1615458F, 0.009144437F, -0.5067274F,
+  -0.1391699F, 0.04225701F, -0.04609176F, 0.0722608F, -0.42256F, 0.5819113F, -0.2830143F, -0.311606F,
+  0.1400095F, 0.6030385F, 0.355823F, -0.3008493F, 0.1098511F, 0.03804414F, -0.1835819F, -0.2383685F,
+  -0.6947291F, 0.2338368F, -0.1688261F, -0.04476101F, 0.3626015F, 0.02541104F, 0.2486062F, -0.5275915F,
+  0.4255082F, -0.3112976F, -0.02087746F, -0.01499386F, 0.06993847F, -0.1800603F, 0.033983F, -0.01383766F,
+  0.3096504F, 0.2691008F, -0.3633333F, -0.05350434F, 0.09544675F, -0.3879525F, 0.217816F, 0.1017056F,
+  -0.7743611F, -0.1881805F, 0.3864388F, 0.2567073F, 0.3579827F, -0.2657456F, -0.2712926F, -0.291795F,
+  -0.05171867F, -0.01534226F, -0.1688353F, -0.2024726F, -0.1465203F, -0.03289328F, 0.1182817F, 0.1970701F,
+  0.06484802F, -0.3847861F, -0.2393197F, -0.1530732F, 0.08939108F, -0.2056182F, 0.08296671F, -0.1395041F,
+  0.3527577F, 0.02417262F, 0.3093518F, 0.5676175F, -0.1525909F, 0.01648623F, 0.392644F, -0.190468F,
+  -0.1652721F, 0.2175419F, -0.2402178F, 0.3501883F, 0.4224295F, 0.4806026F, -0.01857619F, 0.319231F,
+  -0.03210428F, 0.611215F, -0.7519343F, -0.0168506F, 0.6979865F, 0.3196069F, 0.1355788F, 0.145661F,
+  -0.3970473F, -0.05546192F, 0.1644533F, 0.4358675F, 0.002874321F, 0.1476492F, -0.2325605F, 0.0300095F,
+  0.2007224F, 0.3303945F, 0.02700187F, 0.1270453F, 0.236223F, 0.2274631F, -0.2423027F, 0.4364415F,
+  -0.04537936F, -0.007424655F, -0.1162003F, -0.2161384F, -0.124712F, 0.201446F, -0.2562607F, -0.1803589F,
+  -0.03063452F, -0.0299196F, 0.4866024F, 0.3833316F, 0.05083869F, -0.0008883257F, -0.03105749F, 0.2116023F,
+  0.5195591F, -0.002743754F, -0.180279F, -0.09679744F, -0.2292402F, -0.1805797F, 0.1291375F, 0.2648946F,
+  -0.581986F, 0.2145098F, -0.2999082F, 0.006846256F, 0.4210071F, 0.1945577F, 0.06210418F, 0.02922413F,
+  0.007949059F, -0.2385799F, 0.09582447F, -0.03922088F, -0.2077192F, -0.2939116F, 0.03225345F, -0.2953159F,
+  -0.1311802F, -0.05802088F, 0.1400292F, -0.0213538F, -0.07022048F, 0.128518F, -0.2368548F, -0.07268328F,
+  -0.371883F, 0.525803F, 0.5973787F, 0.02166715F, 0.355051F, -0.4374393F, -0.4308767F, 0.2528252F,
+  -0.03869563F, 0.166458F, -0.5676441F, -0.07760385F, -0.3419018F, -0.1572202F, 0.3900377F, -0.1164557F,
+  0.05226851F, 0.1368656F, -0.2959545F, 0.1062237F, -0.5741973F, 0.2141912F, -0.1029791F, 0.4051409F,
+  0.1838365F, 0.1973866F, 0.08207619F, -0.5398104F, -0.3534131F, 0.1501843F, -0.03790253F, 0.1634385F,
+  0.3308927F, -0.1415755F, 0.1784375F, 0.386759F, 0.4868243F, 0.09530957F, -1.096679F, -0.2924524F,
+  -0.1135502F, 0.4425377F, -0.2823317F, 0.117523F, -0.001041683F, 0.2952274F, -0.4783139F, 0.2652282F,
+  0.1601194F, -0.3366151F, -0.06049125F, -0.4101836F, 0.1891167F, -0.1892894F, -0.6670628F, 0.01159249F,
+  -0.2610391F, 0.1782443F, -0.03156195F, 0.4076197F, -0.01677183F, 0.3723402F, 0.191551F, 0.07269195F,
+  0.3008972F, -0.1901111F, -0.4510248F, 0.382209F, 0.08978433F, -0.01941456F, 0.1989465F, 0.2522209F,
+  0.116376F, -0.1043705F, 0.1566113F, -0.4712747F, 0.2701823F, -0.04805345F, 0.3739239F, -0.4792232F,
+  -0.3813817F, -0.2156051F, -0.3242696F, -0.2130423F, 0.1072782F, 0.09870365F, 0.09596416F, -0.2701243F,
+  0.6880118F, -0.07056902F, 0.170685F, -0.01064681F, -0.142451F, -0.0594284F, 0.2517155F, -0.0647288F,
+  0.02238949F, -0.2048261F, 0.06883386F, -0.4191228F, 0.4477622F, 0.2635522F, -0.4005477F, 0.08903547F,
+  0.3752817F, 0.110292F, -0.1830519F, -0.2996918F, -0.2876767F, -0.7480518F, 0.2733453F, -0.325137F,
+  0.1120569F, 0.3383363F, -0.1758566F, 0.6824121F, 0.3311996F, 0.189417F, -0.3215213F, -0.162154F,
+  0.06770859F, -0.4774337F, 0.140774F, -0.4236856F, -0.1626215F, -0.1681751F, -0.0656452F, 0.1930257F,
+  0.06532983F, 0.0333091F, 0.1740045F, -0.3512359F, -0.02965082F, 0.2288769F, -0.3863949F, -0.1972615F,
+  0.1430295F, -0.1398394F, 0.09481862F, 0.6786569F, 0.7626885F, -0.01718664F, -0.2538006F, -0.1246961F,
+  -0.4246825F, 0.1296694F, -0.5880035F, 0.1479237F, -0.0001556694F, 0.9081929F, -0.0835877F, 0.5688016F,
+  -0.1624075F, 0.2270746F, 0.001050495F, -0.1028847F, -0.1305193F, 0.6675691F, -0.2657735F, 0.2332855F,
+  0.2248467F, 0.1381129F, -0.1746389F, 0.6510366F, -0.08052922F, -0.04999154F, -0.2732902F, -0.02275399F,
+  -0.1822721F, 0.01570477F, 0.2889094F, -0.04104344F, -0.00591231F, 0.2613775F, -0.4012061F, 0.06975866F,
+  -0.3407745F, 0.07066483F, 0.05039932F, -0.06493967F, -0.159492F, 0.3504741F, 0.08481159F, -0.1577408F,
+  -0.4592524F, 0.2312514F, -0.2937182F, -0.314117F, -0.3253061F, -0.3504108F, -0.3128069F, -0.3424338F,
+  -0.1399066F, -0.07794079F, -0.2755135F, -0.1912659F, -0.1888624F, 0.02344835F, -0.2018488F, 0.01473411F,
+  -0.1643313F, -0.4300374F, -0.2133826F, -0.4761802F, -0.01267058F, -0.1791105F, 0.02328725F, 0.4655221F,
+  -0.2910448F, -0.5999559F, -0.01925278F, -0.02291343F, -0.2234057F, -0.1046335F, 0.5557442F, 0.05363763F,
+  -0.5786935F, -0.2283131F, 0.4174708F, -0.6194235F, 0.04990275F, -0.1485035F, -0.3375835F, 0.4090049F,
+  -0.3266686F, -0.03011153F, 0.1918701F, 0.1379228F, 0.09454834F, 0.05793533F, 0.3189058F, -0.3474587F,
+  -0.4519796F, -0.3324515F, -0.2010254F, 0.210365F, -0.03819846F, 0.09472828F, -0.05308003F, 0.1092989F,
+  -0.1437466F, -0.09424438F, 0.2237945F, 0.1284745F, -0.1858788F, 0.0309719F, -0.623572F, -0.06828696F
+};
+
+const float TEMPORAL_BIAS_1[12] = {
+  0.3780057F, -0.05980061F, 0.3256437F, -0.00718248F, 0.009436624F, 0.1066352F, 0.3831389F, -0.1329689F,
+  0.1089035F, 0.1527512F, -0.1362125F, 0.1745622F
+};
+
+const float TEMPORAL_WEIGHTS_2[432] = {
+  0.1445638F, -0.269903F, -0.5046496F, -0.108721F, -0.1790329F, 0.4346813F, -0.6737402F, -0.4217599F,
+  0.5701031F, -0.1262085F, -0.22769F, -0.1422801F, -0.2674605F, 0.3820775F, -0.233825F, -0.3244611F,
+  0.02642619F, -0.2465133F, -0.008487077F, 0.02450947F, -0.3396502F, 0.03894525F, -0.02878454F, -0.06378387F,
+  0.2924568F, 0.140365F, 0.2916813F, 0.1534647F, -0.3249693F, 0.2339866F, 0.05493339F, -0.1035049F,
+  -0.03979728F, -0.2334149F, 0.06263163F, 0.1803672F, 1.043728F, 0.1341242F, 0.5919943F, 0.02537877F,
+  0.5452325F, -0.3875441F, 0.7257174F, 0.1653835F, -0.4906988F, -0.5880718F, -0.1709219F, 0.3525914F,
+  0.2273879F, 0.1886782F, -0.2669195F, 0.2367578F, 0.07740459F, 0.1208756F, -0.02303453F, -0.1233793F,
+  -0.01108766F, -0.5704207F, 0.8571755F, 0.1165059F, 0.1450332F, 0.2878253F, -0.2213379F, -0.3096509F,
+  -0.2147027F, -0.249936F, 0.1936779F, -0.00795953F, 0.000950455F, -0.09648899F, 0.1828358F, 0.1397375F,
+  0.4340081F, -0.9637581F, -0.09284219F, -0.06054847F, -0.202571F, -0.01802265F, 0.3040837F, -0.3405588F,
+  0.3523251F, 0.712245F, 0.07671153F, 0.4273685F, 0.0195243F, -0.1647351F, 0.1330962F, -0.483469F,
+  -0.0925414F, -0.1328781F, 0.1139523F, -0.3248043F, 0.3616176F, -0.1439126F, 0.2715171F, 0.3894728F,
+  0.1364419F, 0.330474F, 0.2027191F, -0.394561F, 0.1464466F, -0.2851618F, -0.09983323F, 0.08729812F,
+  -0.02406092F, 0.2944416F, -0.05640906F, 0.0147032F, 0.1922951F, -0.8873064F, 0.1377704F, 0.3386729F,
+  0.6343104F, -0.3505729F, -0.3340122F, -0.0706968F, -0.2609514F, -0.1646868F, -0.2943155F, 0.3260544F,
+  0.2707273F, -0.822108F, -0.2483837F, -0.5173193F, -0.1267781F, -0.6070744F, -0.3089878F, -0.003526347F,
+  -0.2113086F, 0.5395157F, 0.1654779F, 0.2043681F, -0.09421334F, -0.1677447F, 0.31383F, 0.08041784F,
+  -0.3833164F, -0.3658813F, -0.1968114F, -0.1674803F, -0.1934071F, 0.1131954F, -0.08900632F, 0.06997004F,
+  0.02450204F, -0.4231016F, -0.317886F, 0.1615992F, 0.07170669F, -0.2969366F, -0.02663221F, -0.4237233F,
+  -0.3198318F, -0.1515867F, -0.3819543F, -0.54081F, 0.1852939F, -0.3904091F, -0.6497245F, -0.005999393F,
+  0.3966715F, -0.2174829F, -0.05957476F, -0.2007572F, -0.05936835F, -0.583728F, 0.4615531F, -0.07011909F,
+  -0.08375823F, -0.5639353F, 0.05027847F, -0.3886674F, -0.1501165F, 0.1164151F, -0.1235565F, -0.09716464F,
+  0.2991672F, -0.1825167F, -0.08161998F, -0.4943696F, 0.3756047F, 0.4877112F, -0.2213144F, 0.1286484F,
+  -0.1473222F, 0.4703718F, -0.8193163F, 0.4481128F, 0.1497681F, -0.5869551F, 0.2406447F, 0.6111374F,
+  0.01467708F, 0.3227969F, -0.2363324F, -0.1345735F, -0.1089648F, 0.3305186F, 0.379675F, 0.1036037F,
+  0.3816761F, -0.2809874F, 0.006204354F, 0.2727986F, 0.04107519F, 0.2264326F, 0.1295471F, -0.2705621F,
+  0.1266219F, -0.01869494F, 0.02538093F, 0.1541836F, 0.05890746F, 0.04743286F, 0.5734732F, 0.2817048F,
+  -0.01693233F, 0.07594892F, -0.8609245F, -0.4507073F, -0.4626732F, 0.257759F, -0.03743369F, -0.05309194F,
+  0.509352F, 0.4962787F, -0.3641742F, 0.1241187F, -0.1780115F, 0.0253939F, -0.2377286F, 0.1406364F,
+  -0.0542947F, -0.01256073F, 0.0274361F, -0.4348187F, -0.2694743F, -0.4132181F, 0.1568358F, 0.04241363F,
+  -0.2995668F, 0.002685234F, 0.141929F, -0.1761432F, 0.006922462F, -0.3500873F, -0.01587954F, -0.1475769F,
+  -0.08549887F, -0.1961693F, 0.2912839F, -0.05643667F, -0.7822012F, -0.5659872F, -0.206809F, 0.2027069F,
+  0.6228628F, 0.3856472F, 0.4967981F, -0.3850698F, -0.4965188F, -0.4451696F, -0.45422F, 0.1776966F,
+  -0.2607782F, -0.1120331F, 0.2423618F, -0.1492499F, -0.191632F, -0.1393659F, 0.2934918F, 0.192038F,
+  0.03252499F, 0.1689412F, -0.7603823F, -0.4517931F, -0.1680329F, 0.1062636F, 0.06397126F, -0.2100769F,
+  -0.1995784F, 0.1301522F, -0.2892556F, -0.1021556F, 0.3620717F, 0.1185606F, -0.09435F, 0.1185338F,
+  -0.3198655F, -0.1531119F, 0.07932654F, 0.8012794F, 0.247993F, -0.8439691F, 0.8730323F, 0.1984081F,
+  0.04893011F, 0.2359818F, -0.5508628F, -0.5337406F, 0.2153226F, 0.1323409F, 0.1469611F, 0.3011211F,
+  0.2060484F, -0.1082472F, 0.2927455F, 0.08286914F, -0.02551921F, -0.06943963F, -0.1324715F, -0.001039165F,
+  0.05394522F, -0.2803092F, 0.09579922F, 0.1094783F, 0.3997585F, -0.3742508F, 0.2396102F, -0.1139225F,
+  0.1323455F, 0.08520699F, 0.4073596F, -0.3539677F, -1.136839F, -0.4478634F, -0.387301F, 0.5670786F,
+  0.07557799F, -0.209453F, 0.4276586F, -0.314735F, -0.1063756F, 0.6267307F, -0.1044891F, -0.6420395F,
+  -0.5664719F, -0.01852072F, -0.1917087F, -0.1496156F, 0.6607067F, -0.05126562F, 0.2038447F, -0.2252013F,
+  -0.2034776F, -0.1174555F, -0.1980762F, 0.07180275F, -0.3675704F, -0.095819F, 0.2801743F, 0.03818861F,
+  -0.1550451F, 0.0908741F, -0.0456546F, 0.2519022F, -0.3436454F, -0.148198F, 0.01228713F, 0.3573362F,
+  -0.04832633F, -0.2916892F, -0.3421271F, -0.4935531F, 0.09842562F, -0.2195305F, -0.1953236F, -0.1162231F,
+  0.1065493F, -0.8483163F, -0.09570044F, -0.3130016F, 0.001896105F, -0.01490948F, 0.00466049F, 0.2027016F,
+  -0.469342F, -0.3821741F, -0.2514863F, 0.09386413F, -0.2162614F, 0.3041929F, 0.06964916F, -0.348324F,
+  0.06769899F, 0.03966038F, -0.1477167F, -0.3016235F, 0.1354516F, -0.4421868F, -0.4312283F, -0.0819124F,
+  -0.08202095F, -0.133444F, -0.02521855F, -0.3573661F, -0.589121F, 0.4703092F, -0.4797225F, 0.2718842F,
+  0.3071817F, 0.6066916F, -0.2097811F, -0.02608388F, -0.3185441F, 0.3685426F, -0.2491565F, 0.1776426F,
+  -0.4993732F, 0.3560959F, -0.01061519F, 0.3905842F, 0.3307429F, -0.1585263F, -0.04224172F, 0.1527377F,
+  -0.2868739F, -0.4176971F, -0.03448071F, 0.2610118F, -0.3056293F, 0.3880119F, 0.1686747F, -0.3466464F,
+  -0.1414849F, -0.004176465F, -0.04873222F, -0.3512405F, 0.05088192F, 0.04880217F, 0.06989558F, -0.2500204F
+};
+
+const float TEMPORAL_BIAS_2[12] = {
+  -0.0837492F, 0.0914007F, 0.1974844F, 0.2470783F, -0.2435772F, 0.05286297F, 0.07471867F, 0.009634724F,
+  0.1784348F, 0.2446998F, -0.06607988F, -0.02179714F
+};
+
+const float TEMPORAL_WEIGHTS_3[432] = {
+  0.3909342F, -0.6471394F, -0.04562306F, -0.2158703F, -0.3451489F, 0.3511808F, 0.7167504F, 0.07346673F,
+  -0.5673662F, 0.05170786F, -0.1464858F, -0.4848817F, 0.2711779F, -0.5491788F, -0.4182337F, -0.1894747F,
+  0.1963995F, -0.4354085F, -0.2979129F, 0.2455048F, -0.3095742F, 0.2022319F, 0.1148352F, 0.3719374F,
+  -0.1411552F, 0.08510551F, 0.02335845F, -0.184665F, 0.04343957F, -0.134348F, -0.2748948F, 0.07864776F,
+  -0.0257869F, 0.1246136F, 0.1827999F, 0.1190155F, -0.281022F, -0.69911F, 0.7310064F, -0.3699962F,
+  0.1835713F, -0.4562569F, 0.4413224F, -0.01645551F, 0.2020122F, 0.2966959F, -0.005602711F, 0.2001444F,
+  0.2107178F, 0.1061406F, -0.003177918F, -0.4076235F, 0.2127939F, -0.06021702F, 0.3231405F, 0.6525348F,
+  -0.4326122F, -0.1272161F, 0.1130022F, -0.02420299F, 0.339873F, 0.1300662F, -0.01630178F, -0.04477692F,
+  -0.004728852F, 0.2329641F, -0.008861651F, 0.09584599F, 0.06701583F, 0.3294775F, 0.2273047F, 0.3076166F,
+  0.3090689F, -0.2412734F, 0.4975837F, -0.5856348F, -0.02976239F, -0.2821128F, 0.1511803F, -0.07695904F,
+  -0.01378408F, 0.5739698F, -0.4812512F, 0.1917742F, 0.005578903F, 0.003258935F, -0.2014948F, -0.07289542F,
+  0.3571601F, -0.1098137F, 0.1865954F, 0.3910857F, -0.09700654F, -0.4890933F, -0.05510939F, -0.2628404F,
+  -0.2042012F, 0.1252429F, -0.3235404F, 0.09798806F, -0.2250536F, -0.1207914F, -0.2249772F, 0.1157717F,
+  -0.06025541F, -0.04328226F, 0.4883215F, -0.321309F, -0.1181563F, 1.005646F, -0.5443454F, 0.1882959F,
+  0.1152218F, 0.01806902F, -0.3381897F, -0.158355F, 0.5458575F, -0.4778688F, -0.03112651F, -0.1904241F,
+  0.1933911F, -0.1625262F, 0.1000067F, 0.1616648F, 0.2510278F, 0.006568923F, -0.131181F, 0.1921629F,
+  -0.2141111F, 0.002757573F, 0.04963269F, -0.386001F, 0.1503922F, 0.2121564F, 0.01599846F, 0.239986F,
+  0.3458174F, -0.06003989F, 0.3780221F, 0.3219067F, -0.01085103F, 0.0523932F, -0.2723722F, 0.2226767F,
+  0.2604916F, 0.3087923F, 0.562587F, 0.2211331F, -0.6174758F, 0.3960265F, -0.02671742F, -0.3698162F,
+  -1.579956F, -0.8741626F, -0.7553579F, -0.4141042F, 0.009360254F, -0.1871186F, 0.2414068F, -0.005495701F,
+  0.2436034F, -0.1818974F, -0.1011656F, 0.4936021F, -0.6495323F, 0.5971351F, 0.3952248F, -0.06174733F,
+  0.207303F, 0.1997958F, 0.07762551F, -0.01013361F, 0.08023958F, -0.05445046F, 0.1429992F, 0.344059F,
+  0.2130085F, 0.2628477F, 0.08921202F, 0.03534613F, -0.7546833F, -0.01386095F, -0.1614338F, 0.0104203F,
+  -0.138796F, -0.1332781F, -0.3619291F, 0.0210767F, -0.1685756F, -0.03993749F, 0.06311362F, 0.1179173F,
+  -0.3542204F, -0.1699132F, 0.05698178F, 0.004107396F, -0.1556608F, -0.2371146F, -0.2310939F, 0.326916F,
+  0.1108688F, -0.5989741F, 0.0985036F, -0.3207709F, -0.04121484F, -0.06445351F, -0.4314803F, -0.2738091F,
+  0.1315459F, -0.1629709F, -0.3683397F, 0.2711379F, -0.02184159F, -0.2425955F, -0.09478654F, -0.3137729F,
+  -0.2345925F, -0.1658052F, -0.02102328F, 0.2288084F, 0.2902518F, -0.1668965F, -0.2114153F, -0.6191596F,
+  -0.3796923F, 0.150917F, -0.07221121F, 0.1362458F, -0.02944002F, -0.03779803F, -0.6481073F, -0.2155339F,
+  0.1677367F, -0.2410122F, -0.1705418F, 0.05191354F, 0.3504052F, -0.09632196F, -0.4733188F, 0.4008283F,
+  -0.05829073F, 0.08191172F, -0.3343244F, -0.2104786F, -0.2395786F, -0.14503F, -0.08851842F, -0.1401946F,
+  0.2022738F, -0.4154689F, -0.5077952F, -0.07096139F, -0.1622426F, -0.3590127F, 0.06687354F, -0.01649282F,
+  -0.2546757F, -0.2694083F, -0.5134133F, -0.3924173F, -0.3217337F, -0.0666641F, 0.3022983F, -0.08711809F,
+  -0.06982139F, -0.1574297F, -0.1882168F, 0.2467324F, -0.09699219F, -0.5209609F, 0.4153264F, 0.003755933F,
+  0.04498554F, -0.6032606F, -0.5249841F, 0.007354993F, -0.180181F, -0.4385818F, 0.03898112F, 0.004175562F,
+  -0.06190967F, -0.07047741F, -0.07845871F, -0.4787395F, -0.2047583F, 0.292475F, -0.1495122F, 0.04033967F,
+  0.6649264F, -0.8273917F, 0.6083653F, -0.8548774F, -0.1215783F, -0.5430933F, 0.5384666F, -0.02239103F,
+  0.2706194F, 0.3034939F, -0.4524097F, -0.01483091F, 0.3156726F, -0.3530589F, -0.06970998F, 0.1747632F,
+  -0.3953929F, 0.07803418F, 0.08889595F, 0.1238256F, 0.2117676F, -0.2727813F, -0.1517055F, 0.2691324F,
+  0.3483673F, 0.08020237F, -0.1304567F, -0.1037294F, 0.5061908F, -0.09923896F, 0.2399125F, 0.422704F,
+  0.07645793F, -0.1849779F, -0.1359777F, 0.1040577F, 0.3081401F, 0.1734221F, -0.7170916F, -0.4399544F,
+  -0.3526148F, 0.1235803F, -0.3115613F, -0.6089527F, -0.4560571F, -0.9242728F, -0.07188273F, 0.3936841F,
+  0.1061663F, -0.1002408F, -0.6300821F, -0.6410105F, -0.1578551F, 0.5030434F, -0.1527366F, 0.0702847F,
+  0.006834581F, -0.2857001F, -0.4228846F, 0.1713562F, 0.09197995F, -0.2065383F, 0.216237F, -0.05052152F,
+  -0.0299189F, 0.09369523F, -0.08791137F, 0.1689885F, 0.1559474F, 0.03702962F, 0.02891614F, 0.1179795F,
+  -0.03823424F, -0.157341F, -0.8836119F, 0.2789488F, 0.2196009F, -0.05639452F, -0.1651031F, 0.5510592F,
+  0.3172868F, 0.8125027F, -0.01288689F, 0.9409731F, 0.03381965F, -0.369652F, -0.3412841F, 0.08908272F,
+  -0.05943884F, 0.2956988F, -0.09392995F, -0.2508714F, 0.01169125F, -0.1355999F, 0.03385898F, 0.1840047F,
+  0.2602316F, 0.2305453F, 0.266205F, 0.05820685F, -0.07760467F, -0.2160008F, 0.01692725F, -0.001069794F,
+  -0.1200686F, 0.03260934F, 0.24621F, -0.1616022F, 0.5327801F, -0.3599739F, -0.2767009F, -1.220382F,
+  -0.2194294F, 0.7204853F, 0.4496266F, 0.1338808F, -0.5716778F, -0.4784324F, -0.477072F, 0.8891407F,
+  -0.1170896F, -0.009693759F, 0.008958088F, 0.2331694F, -0.2669095F, 0.06779304F, 0.3275676F, -0.2584462F,
+  0.04097675F, -0.02539387F, -0.06763243F, 0.2849487F, 0.1240733F, -0.02609814F, 0.09413008F, -0.004626442F,
+  0.3504601F, 0.03654191F, 0.1366678F, -0.02539326F, 0.1377872F, 0.1113883F, 0.1615544F, 0.05949721F
+};
+
+const float TEMPORAL_BIAS_3[12] = {
+  -0.09477831F, -0.001480326F, -0.2355182F, -0.1890237F, 0.06817985F, -0.13387F, -0.1860635F, -0.1040533F,
+  -0.1326194F, -0.04562096F, -0.2073715F, 0.1174702F
+};
+
+const float TEMPORAL_WEIGHTS_4[432] = {
+  0.4682131F, 0.1554798F, 0.329345F, -0.3838115F, 0.6729426F, -0.3928719F, -0.5499862F, 0.5027428F,
+  0.5419783F, 0.09323824F, -0.172994F, 0.831253F, 0.2012901F, -0.2500627F, 0.04677629F, 0.1157815F,
+  -0.07807335F, 0.1863205F, -0.1272625F, 0.02563483F, -0.03145175F, -0.2199538F, 0.1539476F, 0.1613873F,
+  -0.07349201F, -0.04090246F, -0.2159072F, -0.2434915F, 0.2141033F, 0.2931573F, 0.08950824F, -0.02483193F,
+  0.004441663F, 0.1286371F, 0.08610455F, -0.06602643F, 0.4955286F, 0.31677F, 0.1663395F, -0.1560664F,
+  0.7258078F, -0.625308F, -0.033082F, -0.02901399F, 0.4671184F, -0.2738904F, -0.5557644F, 0.4450595F,
+  0.4954926F, 0.07420639F, -0.3213494F, -0.0458375F, -0.02779921F, -0.2757294F, 0.2834649F, -0.02497894F,
+  0.360206F, -0.07818202F, -0.1541826F, -0.03944255F, 0.062677F, -0.1745048F, 0.04919153F, 0.009632953F,
+  -0.03466109F, 0.1069221F, -0.06236454F, -0.07392558F, 0.05316481F, -0.01241513F, -0.2468202F, -0.02688738F,
+  -0.1446623F, -0.6520456F, -0.07401409F, 0.8728929F, -0.03177378F, -0.08819208F, -0.117471F, 0.2753357F,
+  -0.5756656F, 0.3668408F, 1.093015F, 0.05208488F, 0.4085116F, -0.1134587F, -0.1478126F, 0.1198259F,
+  -0.2326362F, -0.2535948F, -0.03608629F, 0.1811283F, 0.2508135F, 0.3980609F, 0.2215596F, 0.3882693F,
+  -0.1869217F, 0.03031076F, 0.002050288F, 0.02383772F, 0.3204755F, 0.1138451F, 0.1035463F, 0.1974968F,
+  0.308716F, -0.06355125F, 0.1102888F, -0.1511658F, 0.6186433F, 0.03832164F, 0.3120679F, -0.4461064F,
+  -0.3142781F, 0.4098758F, -0.7245352F, 0.2511015F, 0.2643333F, -0.08879938F, -0.6885921F, -0.04086541F,
+  0.105732F, -0.2804852F, 0.2258946F, 0.1243038F, -0.09849301F, 0.317268F, 0.4606148F, 0.1842201F,
+  0.2036016F, 0.3095828F, -0.3191957F, -0.02725946F, -0.1781567F, -0.2966105F, 0.3601463F, -0.2160458F,
+  -0.03792962F, -0.1971973F, 0.06143495F, -0.07289383F, 0.1047388F, -0.01100165F, 0.2808748F, 0.1743018F,
+  0.2448412F, -0.4357105F, 0.1211079F, -0.1287532F, 0.8556604F, -0.1176615F, 0.3652628F, 0.1770976F,
+  0.1005819F, 1.009215F, 0.3920759F, 0.9629778F, -0.1290273F, -0.2314446F, 0.1253866F, -0.07683323F,
+  0.03472261F, -0.3694896F, 0.2947926F, -0.05881933F, 0.01902154F, 0.6275197F, -0.02949685F, -0.0977623F,
+  0.1347375F, -0.01856064F, 0.05267118F, 0.1226163F, -0.2348902F, 0.2133208F, 0.05861145F, -0.4203328F,
+  0.2914917F, 0.04161156F, 0.008346217F, 0.01381344F, -0.09953807F, 0.782299F, 0.8389295F, -0.1232991F,
+  -0.4282215F, -0.0103298F, 0.09610758F, -0.01484327F, 1.000337F, -0.6353025F, 0.6765537F, -0.7746355F,
+  0.3329525F, 0.05697126F, 0.008520976F, -0.1605315F, 0.06207172F, 0.08799091F, 0.02632508F, 0.5360609F,
+  -0.2680183F, 0.04806042F, 0.005835831F, 0.1907099F, -0.2335793F, -0.05912257F, -0.2440597F, 0.05785007F,
+  -0.280714F, 0.5390317F, 0.01454336F, 0.08578829F, 0.5999299F, 0.0873221F, -0.3380163F, 0.1743106F,
+  -0.1409347F, -0.1093807F, -0.06997309F, 0.1436755F, -0.4032737F, 0.2888633F, -0.212043F, -0.2940718F,
+  -0.2650671F, -0.1738435F, -0.2509726F, -0.1645131F, 0.01756817F, -0.002389946F, 0.0692862F, -0.2147387F,
+  0.03745298F, 0.09401392F, -0.1074732F, 0.02466105F, -0.05839004F, -0.07050415F, -0.1346917F, 0.2334378F,
+  -0.07999416F, -0.1197612F, 0.1246924F, -0.3104736F, 0.2330993F, 0.08845822F, -0.2727683F, 0.2086448F,
+  -0.1013021F, 0.03273322F, -0.2019316F, -0.846683F, -0.5958198F, -0.2637691F, -0.4715142F, -0.08526503F,
+  0.7928097F, -0.07340931F, 0.03639113F, -0.07468514F, -0.3235988F, 0.1148883F, -0.6818981F, -1.004093F,
+  -0.310817F, -0.02649911F, -0.0526382F, 0.3924254F, -0.2484F, -0.1333241F, -0.0121976F, -0.03312777F,
+  0.1651516F, 0.2156445F, 0.193561F, 0.2113638F, -0.3454743F, 0.1861925F, -0.2047714F, -0.2320603F,
+  -0.02634764F, -0.1158734F, 0.2197491F, 0.1296227F, 0.1570054F, -0.1922604F, -0.02789465F, -0.07488158F,
+  -0.6714034F, -0.004828554F, 0.3048466F, 0.3195221F, 0.7129272F, -0.01584082F, 0.2084666F, -0.03765311F,
+  -0.0295075F, -0.3319587F, -0.5031906F, -0.488822F, 0.102007F, 0.1085367F, 0.1488212F, -0.3445009F,
+  0.1243961F, -0.3347098F, -0.01731393F, 0.04715085F, -0.09005576F, -0.02501329F, 0.03888998F, 0.05176388F,
+  -0.05255569F, 0.04874818F, 0.01997982F, -0.0298343F, -0.1109366F, -0.2067364F, -0.0685394F, 0.1323183F,
+  -0.1053452F, 0.447287F, -0.2815045F, -0.01216899F, -0.3567255F, 0.2407921F, 0.3661817F, 0.5497178F,
+  -0.08842129F, 0.20719F, -0.6785238F, 0.003533956F, 0.06406403F, 0.5381599F, -0.4413426F, -0.1071789F,
+  -0.5081311F, 0.1126636F, -0.07609375F, -0.1055878F, 0.1982025F, 0.3940986F, -0.3464577F, -0.06264434F,
+  0.0689245F, 0.06185007F, 0.03383623F, -0.003080572F, 0.3021811F, -0.2523805F, -0.1921541F, 0.2527637F,
+  -0.2349757F, -0.1302581F, -0.1522637F, -0.1038645F, 0.4305283F, 0.03142492F, -0.0624775F, -0.03860612F,
+  -0.1231529F, -0.7076086F, -0.25195F, 0.3952328F, -0.5192454F, 0.1007926F, -0.6197422F, 0.4241535F,
+  -0.2860003F, 0.8493299F, 0.2654336F, 0.8238814F, -0.326578F, 0.1447829F, -0.06675851F, 0.1211667F,
+  0.249294F, -0.1846632F, 0.004856518F, 0.08022829F, 0.02037995F, 0.1393336F, 0.03036004F, -0.2813106F,
+  -0.2661292F, 0.2620246F, -0.0369443F, -0.0813056F, -0.1683687F, 0.05001187F, 0.3693337F, -0.3342738F,
+  -0.1390132F, 0.5882156F, -0.5314873F, 0.06054329F, 0.137884F, 0.04438379F, 0.3819434F, 0.02518764F,
+  -0.1615635F, 0.2920676F, 0.1029136F, 0.4179814F, -0.164353F, -0.05904524F, 0.3731336F, -0.3162431F,
+  0.0254261F, -0.5301184F, 0.2907425F, 0.0914312F, -0.04388387F, 0.04340156F, 0.4445695F, 0.1788806F,
+  -0.01474982F, 0.04328564F, 0.4120341F, -0.3426333F, -0.153281F, 0.123703F, -0.3674784F, -0.1457108F,
+  -0.2696637F, -0.2448428F, -0.138735F, 0.009570361F, 0.1227861F, 0.1372196F, -0.009185502F, -0.2646279F
+};
+
+const float TEMPORAL_BIAS_4[12] = {
+  -0.1171453F, -0.1265252F, -0.1604314F, 0.1633626F, -0.1595984F, 0.03196481F, -0.1601146F, 0.001390439F,
+  -0.08131808F, 0.002331903F, -0.1454994F, -0.03599535F
+};
+
+const float TEMPORAL_HEAD_WEIGHTS[72] = {
+  0.4645092F, 0.1192932F, -0.8334689F, 0.6304001F, 0.2907056F, -0.09748625F, -0.4143562F, 0.003816799F,
+  -0.4162265F, -0.4884359F, -0.3483064F, 0.007865721F, 0.1965611F, 0.03411086F, -0.814343F, 0.6537715F,
+  -0.3070669F, 0.556986F, -0.2616296F, 0.43026F, -0.2772092F, -0.2404151F, -0.3796277F, -0.1393331F,
+  0.14037F, 0.0212597F, 0.0752262F, 0.3594113F, 0.497396F, -0.4090114F, -0.9547749F, -0.2852699F,
+  -0.7791769F, -0.3384027F, 0.2940359F, -0.8784522F, -0.4394388F, -0.7802089F, 0.1552123F, 0.04618558F,
+  -0.06274778F, 0.4420888F, -0.3178726F, -0.678634F, -0.3004951F, -0.7615216F, -0.01505512F, 0.4718608F,
+  -0.3754523F, -0.1371928F, -0.01919181F, 0.2106573F, -0.1045194F, -0.2937776F, -1.331625F, 0.9644904F,
+  0.337933F, -0.03227847F, -1.285346F, 0.05710354F, -0.6323234F, -0.5931112F, 0.4011012F, 0.643533F,
+  -0.6276916F, -0.1941191F, 0.4730043F, 0.3906255F, -0.06094288F, 0.08546294F, 0.1191839F, 0.3441362F
+};
+
+const float TEMPORAL_HEAD_BIAS[6] = {
+  -0.01365826F, 0.1820552F, -0.1864438F, -0.1830465F, -0.1045132F, 0.02050965F
+};
+
+const TemporalConvLayer TEMPORAL_LAYERS[] = {
+  {11, 12, 3, 1, 3, 0, TEMPORAL_WEIGHTS_0, TEMPORAL_BIAS_0},
+  {12, 12, 3, 2, 5, 33, TEMPORAL_WEIGHTS_1, TEMPORAL_BIAS_1},
+  {12, 12, 3, 4, 9, 93, TEMPORAL_WEIGHTS_2, TEMPORAL_BIAS_2},
+  {12, 12, 3, 8, 17, 201, TEMPORAL_WEIGHTS_3, TEMPORAL_BIAS_3},
+  {12, 12, 3, 16, 33, 405, TEMPORAL_WEIGHTS_4, TEMPORAL_BIAS_4},
+};
+
+const TemporalModel TEMPORAL_MODEL = {
+  TEMPORAL_LAYERS, 5,
+  TEMPORAL_INPUT_MEAN, TEMPORAL_INPUT_SCALE,
+  TEMPORAL_HEAD_WEIGHTS, TEMPORAL_HEAD_BIAS,
+  TEMPORAL_LABELS
+};
+
+#endif // TEMPORAL_MODEL_H
@@ -12,6 +12,26 @@
 #include "config.h"
 #include "sensors.h"
 #include "lcd_ui.h"  // Added LCD UI header
+#include "scheduler.h"
+#include "decision.h"
+#ifdef ENABLE_BENCHMARK
+#include "benchmark.h"
+#endif
+#ifdef USE_MOTION_TRIGGER
+#include "motion.h"
+#endif
+#ifdef USE_CASCADE
+#include "cascade.h"
+#endif
+#ifdef USE_TEMPORAL_MODEL
+#include "temporal.h"
+#endif
+#ifdef USE_DTW_MATCHER
+#include "dtw.h"
+#endif
+
+#define COMMAND_LINE_SIZE 32     // Longest command line kept, including the terminator
+#define COMMAND_TIMEOUT_MS 1000  // A line without line ending is handled after this much silence
 
 // Display mode flag
 extern bool debugMode;
@@ -37,9 +57,42 @@ void printFingerBending();
 void printFeatures();
 
 /**
- * @brief Process command
+ * @brief Feed the received serial bytes to the command parser
+ * @note Never blocks and handles at most one command per call - a line ends at '\n' or '\r',
+ *       or after COMMAND_TIMEOUT_MS without more bytes for serial monitors that send no line ending
+ */
+void pollSerialCommands();
+
+/**
+ * @brief Advance the command parser by one received byte
+ * @return Whether the byte completed a command line
  */
-void handleCommand(String command);
+bool feedCommandByte(char c);
+
+/**
+ * @brief Look up a command in the command table and run its handler
+ * @note A command that takes an argument finds it after the first space in commandArgument
+ */
+void handleCommand(const char* command);
+
+/**
+ * @brief Print each command of the command table with its help text
+ */
+void printCommandList();
+
+/**
+ * @brief Hand the newest raw flex readings to a running guided calibration and prompt for its next step
+ * @note Called once per sample; saves the calibration to flash when both poses have been captured
+ */
+void updateCalibrationPrompts();
+
+#ifdef USE_DTW_MATCHER
+/**
+ * @brief Advance a running motion sign enrollment and prompt for its next step
+ * @note Called once per sample after pushDtwSample(); saves the template to flash when it has been recorded
+ */
+void updateEnrollmentPrompts();
+#endif
 
 /**
  * @brief Display welcome message and initialization status
@@ -51,16 +104,28 @@ void showWelcomeMessage();
 // Debug mode flag
 bool debugMode = false;
 
+// Command parser states
+enum CommandParserState {
+  COMMAND_IDLE,        // Between lines, skipping line endings and leading whitespace
+  COMMAND_RECEIVING,   // Collecting a command line
+  COMMAND_DISCARDING   // Line too long for commandLine - dropping it up to its line ending
+};
+
+// Command line being received
+CommandParserState commandState = COMMAND_IDLE;
+char commandLine[COMMAND_LINE_SIZE];
+int commandLength = 0;
+unsigned long lastCommandByteMs = 0;
+
+// Argument of the command being handled, "" if none was given
+const char* commandArgument = "";
+
 void printSensorData() {
   const char* fingerNames[] = {"Thumb", "Index", "Middle", "Ring", "Pinky"};
   int flexRawValues[5];
   
   // Read raw ADC values
-  flexRawValues[0] = analogRead(FLEX_PIN_THUMB);
-  flexRawValues[1] = analogRead(FLEX_PIN_INDEX);
-  flexRawValues[2] = analogRead(FLEX_PIN_MIDDLE);
-  flexRawValues[3] = analogRead(FLEX_PIN_RING);
-  flexRawValues[4] = analogRead(FLEX_PIN_PINKY);
+  readFlexRaw(flexRawValues);
   
   Serial.println("\nCurrent Sensor Data:");
   
@@ -185,27 +250,25 @@ void printFingerBending() {
 }
 
 void printFeatures() {
-  const char* statNames[] = {"Average", "Minimum", "Maximum", "RMS", "StdDev", "Skewness", "Kurtosis"};
-  const char* fingerNames[] = {"Thumb", "Index", "Middle", "Ring", "Pinky"};
-  
   Serial.println("\nCurrent Statistical Features:");
-  Serial.println("These 35 values are used as input to the Edge Impulse model:");
-  
-  // First make sure features are up-to-date
-  prepareFeatures();
+  Serial.print("These ");
+  Serial.print(FEATURE_COUNT);
+  Serial.println(" values are used as input to the Edge Impulse model:");
   
-  // Print all feature values by finger and statistic
-  int featureIndex = 0;
-  for (int finger = 0; finger < 5; finger++) {
+  // Print all feature values by channel and statistic, as the model would read them
+  for (int ch = 0; ch < WINDOW_CHANNEL_COUNT; ch++) {
+    float stats[STATS_PER_SENSOR];
+    getChannelFeatures(ch, stats);
+    
     Serial.print("\n");
-    Serial.print(fingerNames[finger]);
+    Serial.print(SENSOR_CHANNEL_NAMES[WINDOW_CHANNELS[ch]]);
     Serial.println(" Statistics:");
     
     for (int stat = 0; stat < STATS_PER_SENSOR; stat++) {
       Serial.print("  ");
-      Serial.print(statNames[stat]);
+      Serial.print(STATISTIC_NAMES[WindowFeatures::ORDER[stat]]);
       Serial.print(": ");
-      Serial.println(features[featureIndex++], 4);
+      Serial.println(stats[stat], 4);
     }
   }
   
@@ -213,107 +276,472 @@ void printFeatures() {
   // Show summary on LCD
   char line1[21], line2[21];
   sprintf(line1, "Features Calculated");
-  sprintf(line2, "35 values for model");
+  sprintf(line2, "%d values for model", FEATURE_COUNT);
   showTempMessage(line1, line2, "See serial output", "for details", 3000);
   #endif
 }
 
-void handleCommand(String command) {
-  if (command == "info") {
-    // Display current sensor data
-    printSensorData();
-  } else if (command == "raw") {
-    // Display raw ADC values
-    Serial.println("Raw ADC values:");
-    Serial.print("Thumb: ");
-    Serial.println(analogRead(FLEX_PIN_THUMB));
-    Serial.print("Index: ");
-    Serial.println(analogRead(FLEX_PIN_INDEX));
-    Serial.print("Middle: ");
-    Serial.println(analogRead(FLEX_PIN_MIDDLE));
-    Serial.print("Ring: ");
-    Serial.println(analogRead(FLEX_PIN_RING));
-    Serial.print("Pinky: ");
-    Serial.println(analogRead(FLEX_PIN_PINKY));
-    
-    #ifdef USE_LCD
-    // Show on LCD
-    int t = analogRead(FLEX_PIN_THUMB);
-    int i = analogRead(FLEX_PIN_INDEX);
-    int m = analogRead(FLEX_PIN_MIDDLE);
-    int r = analogRead(FLEX_PIN_RING);
-    int p = analogRead(FLEX_PIN_PINKY);
-    
-    char line1[21], line2[21], line3[21];
-    sprintf(line1, "Raw ADC Values:");
-    sprintf(line2, "T:%d I:%d", t, i);
-    sprintf(line3, "M:%d R:%d P:%d", m, r, p);
-    
-    showTempMessage(line1, line2, line3, "", 3000);
-    #endif
-  } else if (command == "list") {
-    // Display list of supported gestures
-    printGestureList();
-  } else if (command == "finger") {
-    // Display finger bend angle visualization
-    printFingerBending();
-  } else if (command == "features") {
-    // Display current feature values
-    printFeatures();
-  } else if (command == "debug") {
-    // Toggle debug mode
-    debugMode = !debugMode;
-    Serial.print("Debug mode ");
-    Serial.println(debugMode ? "ON" : "OFF");
-    
-    #ifdef USE_LCD
-    // Show confirmation on LCD
-    char message[21];
-    sprintf(message, "Debug mode: %s", debugMode ? "ON" : "OFF");
-    showTempMessage("Status Change", message, "", "", 1500);
-    #endif
-  } 
+/**
+ * @brief Display raw ADC values
+ */
+void printRawValues() {
+  int raw[5];
+  readFlexRaw(raw);
+  Serial.println("Raw ADC values:");
+  Serial.print("Thumb: ");
+  Serial.println(raw[0]);
+  Serial.print("Index: ");
+  Serial.println(raw[1]);
+  Serial.print("Middle: ");
+  Serial.println(raw[2]);
+  Serial.print("Ring: ");
+  Serial.println(raw[3]);
+  Serial.print("Pinky: ");
+  Serial.println(raw[4]);
+  
   #ifdef USE_LCD
-  else if (command == "lcd") {
-    // Toggle LCD backlight
-    bool backlight = toggleLCDBacklight();
-    Serial.print("LCD backlight ");
-    Serial.println(backlight ? "ON" : "OFF");
+  // Show on LCD
+  char line1[21], line2[21], line3[21];
+  sprintf(line1, "Raw ADC Values:");
+  sprintf(line2, "T:%d I:%d", raw[0], raw[1]);
+  sprintf(line3, "M:%d R:%d P:%d", raw[2], raw[3], raw[4]);
+  
+  showTempMessage(line1, line2, line3, "", 3000);
+  #endif
+}
+
+/**
+ * @brief Toggle debug mode
+ */
+void toggleDebugMode() {
+  debugMode = !debugMode;
+  Serial.print("Debug mode ");
+  Serial.println(debugMode ? "ON" : "OFF");
+  
+  #ifdef USE_LCD
+  // Show confirmation on LCD
+  char message[21];
+  sprintf(message, "Debug mode: %s", debugMode ? "ON" : "OFF");
+  showTempMessage("Status Change", message, "", "", 1500);
+  #endif
+}
+
+/**
+ * @brief Display scheduler timing, inference trigger, classifier stage and decision statistics
+ */
+void printTaskStats() {
+  printSchedulerStats();
+  #ifdef USE_MOTION_TRIGGER
+  printMotionStats();
+  #endif
+  #ifdef USE_CASCADE
+  printCascadeStats();
+  #endif
+  #ifdef USE_TEMPORAL_MODEL
+  printTemporalStats();
+  #endif
+  printDecisionStats();
+}
+
+#ifdef ENABLE_BENCHMARK
+/**
+ * @brief Time each stage of the sensor-to-gesture path
+ */
+void runBenchmarkCommand() {
+  Serial.println("Running stage benchmarks...");
+  runBenchmarks(20000);
+  printBenchmarkReport();
+}
+#endif
+
+#ifdef USE_LCD
+/**
+ * @brief Toggle LCD backlight
+ */
+void toggleBacklightCommand() {
+  bool backlight = toggleLCDBacklight();
+  Serial.print("LCD backlight ");
+  Serial.println(backlight ? "ON" : "OFF");
+}
+#endif
+
+/**
+ * @brief Display the flex calibration in use and where it came from
+ */
+void printCalibration() {
+  const char* fingerNames[] = {"Thumb", "Index", "Middle", "Ring", "Pinky"};
+  
+  Serial.print("\nFlex calibration (");
+  Serial.print(calibrationSourceName(flexCalibration.source));
+  Serial.println("):");
+  for (int i = 0; i < 5; i++) {
+    Serial.print(fingerNames[i]);
+    Serial.print(": straight=");
+    Serial.print(flexCalibration.straightAdc[i]);
+    Serial.print(", bent=");
+    Serial.println(flexCalibration.bentAdc[i]);
   }
+  #ifdef USE_ADAPTIVE_CALIBRATION
+  printDriftStats();
   #endif
-  else if (command == "help") {
-    // Display help
-    Serial.println("\nAvailable commands:");
-    Serial.println("  info - Display current sensor data");
-    Serial.println("  raw - Display raw ADC values");
-    Serial.println("  list - Display list of supported gestures");
-    Serial.println("  finger - Display finger bend angle visualization");
-    Serial.println("  features - Display statistical features used by the model");
-    Serial.println("  debug - Toggle debug mode");
-    #ifdef USE_LCD
-    Serial.println("  lcd - Toggle LCD backlight");
-    #endif
-    Serial.println("  help - Display this help message");
+  
+  #ifdef USE_LCD
+  // One finger per line - two to a line do not fit 20 columns with 12-bit readings - over two screens
+  char lines[6][21];
+  snprintf(lines[0], sizeof(lines[0]), "Calib: %s", flexCalibration.source == CALIBRATION_DEFAULTS ? "defaults" : "custom");
+  for (int i = 0; i < 5; i++) {
+    snprintf(lines[i + 1], sizeof(lines[i + 1]), "%-6.6s %d-%d", fingerNames[i], flexCalibration.straightAdc[i],
+             flexCalibration.bentAdc[i]);
+  }
+  showTempMessage(lines[0], lines[1], lines[2], lines[3], 3000);
+  showTempMessage(lines[4], lines[5], "", "", 3000);
+  #endif
+}
+
+/**
+ * @brief Start the guided calibration
+ */
+void startCalibrationCommand() {
+  if (calibrationActive()) {
+    Serial.println("Calibration already running.");
+    return;
+  }
+  
+  startCalibrationCapture();
+  Serial.println("\nCalibration started - recognition pauses until it is done.");
+  Serial.println("Hold all fingers straight...");
+  
+  #ifdef USE_LCD
+  showTempMessage("Calibration", "Hold all fingers", "straight...", "", CALIBRATION_SETTLE_SAMPLES * SAMPLING_INTERVAL_MS);
+  #endif
+}
+
+/**
+ * @brief Erase the stored calibration and use the config.h values again
+ */
+void resetCalibrationCommand() {
+  if (calibrationActive()) {
+    Serial.println("Calibration running - wait for it to finish.");
+    return;
+  }
+  
+  bool erased = eraseCalibration();
+  Serial.println(erased ? "Stored calibration erased - using config.h values."
+                        : "Could not erase the stored calibration!");
+  
+  #ifdef USE_LCD
+  showTempMessage("Calibration", erased ? "Reset to defaults" : "Erase failed!", "", "", 2000);
+  #endif
+}
+
+void updateCalibrationPrompts() {
+  if (!calibrationActive() || !updateCalibrationCapture(lastFlexRawValues)) return;
+  
+  switch (calibrationCapture.phase) {
+    case CALIBRATION_CAPTURE_STRAIGHT:
+    case CALIBRATION_CAPTURE_BENT:
+      Serial.println("Capturing - hold still...");
+      #ifdef USE_LCD
+      showTempMessage("Calibration", "Capturing...", "Hold still", "", CALIBRATION_CAPTURE_SAMPLES * SAMPLING_INTERVAL_MS);
+      #endif
+      break;
+      
+    case CALIBRATION_WAIT_BENT:
+      Serial.println("Now bend all fingers fully (make a fist)...");
+      #ifdef USE_LCD
+      showTempMessage("Calibration", "Bend all fingers", "fully (fist)...", "", CALIBRATION_SETTLE_SAMPLES * SAMPLING_INTERVAL_MS);
+      #endif
+      break;
+      
+    case CALIBRATION_COMPLETE: {
+      bool saved = saveCalibration();
+      Serial.println(saved ? "Calibration saved to flash."
+                           : "Calibration applied, but could not be saved to flash!");
+      printCalibration();
+      calibrationCapture.phase = CALIBRATION_IDLE;
+      break;
+    }
+    
+    case CALIBRATION_FAILED: {
+      const char* fingerNames[] = {"Thumb", "Index", "Middle", "Ring", "Pinky"};
+      int finger = calibrationCapture.failedFinger;
+      Serial.print("Calibration failed: ");
+      Serial.print(fingerNames[finger]);
+      Serial.print(" moved only ");
+      Serial.print(abs(calibrationCapture.bentAdc[finger] - calibrationCapture.straightAdc[finger]));
+      Serial.print(" ADC steps (at least ");
+      Serial.print(CALIBRATION_MIN_RANGE);
+      Serial.println(" needed). Keeping the previous calibration.");
+      #ifdef USE_LCD
+      char line2[21];
+      snprintf(line2, sizeof(line2), "%s range small", fingerNames[finger]);
+      showTempMessage("Calibration failed", line2, "Keeping previous", "values", 3000);
+      #endif
+      calibrationCapture.phase = CALIBRATION_IDLE;
+      break;
+    }
     
-    #ifdef USE_LCD
-    // Show on LCD
-    showTempMessage(
-      "Available Commands:",
-      "info, raw, list,",
-      "finger, features,",
-      "debug, lcd, help",
-      3000
-    );
-    #endif
+    default:
+      break;
+  }
+}
+
+#ifdef USE_DTW_MATCHER
+/**
+ * @brief Record a motion sign under the name given as argument
+ */
+void enrollCommand() {
+  if (dtwEnrollmentActive() || calibrationActive()) {
+    Serial.println("Enrollment or calibration running - wait for it to finish.");
+    return;
+  }
+  if (commandArgument[0] == '\0' || strlen(commandArgument) >= DTW_NAME_SIZE) {
+    Serial.print("Give the sign a name of 1 to ");
+    Serial.print(DTW_NAME_SIZE - 1);
+    Serial.println(" characters, e.g. 'enroll wave'.");
+    return;
+  }
+  if (!startDtwEnrollment(commandArgument)) {
+    Serial.println("Template store full - forget a sign first.");
+    return;
+  }
+  
+  Serial.print("\nRecording '");
+  Serial.print(commandArgument);
+  Serial.println("' - get ready to make the sign...");
+  
+  #ifdef USE_LCD
+  showTempMessage("Enroll sign", commandArgument, "Get ready...", "", DTW_ENROLL_SETTLE_SAMPLES * SAMPLING_INTERVAL_MS);
+  #endif
+}
+
+/**
+ * @brief Remove the motion sign named by the argument
+ */
+void forgetCommand() {
+  if (dtwEnrollmentActive()) {
+    Serial.println("Enrollment running - wait for it to finish.");
+    return;
+  }
+  if (commandArgument[0] == '\0') {
+    Serial.println("Give the name of the sign, e.g. 'forget wave'.");
+    return;
+  }
+  
+  int removed = forgetDtwTemplates(commandArgument);
+  if (removed < 0) {
+    Serial.println("Templates removed, but the store could not be rewritten in flash!");
+  } else if (removed == 0) {
+    Serial.print("No motion sign named '");
+    Serial.print(commandArgument);
+    Serial.println("'.");
   } else {
-    Serial.println("Unknown command. Type 'help' for available commands.");
+    Serial.print("Forgot ");
+    Serial.print(removed);
+    Serial.print(" template(s) of '");
+    Serial.print(commandArgument);
+    Serial.println("'.");
+  }
+}
+
+void updateEnrollmentPrompts() {
+  if (!dtwEnrollmentActive() || !updateDtwEnrollment()) return;
+  
+  switch (dtw.enrollPhase) {
+    case DTW_ENROLL_RECORD:
+      Serial.println("Go - make the sign now...");
+      #ifdef USE_LCD
+      showTempMessage("Enroll sign", dtw.enrollName, "Go!", "", DTW_HISTORY_SAMPLES * SAMPLING_INTERVAL_MS);
+      #endif
+      break;
+      
+    case DTW_ENROLL_COMPLETE: {
+      bool saved = appendDtwTemplate(dtw.count - 1);
+      Serial.print("Recorded '");
+      Serial.print(dtw.enrollName);
+      Serial.print("' (");
+      Serial.print(dtw.count);
+      Serial.print(" of ");
+      Serial.print(dtwCapacity());
+      Serial.println(saved ? " templates), saved to flash." : " templates), but could not save it to flash!");
+      #ifdef USE_LCD
+      showTempMessage("Enroll sign", dtw.enrollName, saved ? "Saved" : "Save failed!", "", 2000);
+      #endif
+      dtw.enrollPhase = DTW_ENROLL_IDLE;
+      break;
+    }
     
-    #ifdef USE_LCD
-    showTempMessage("Unknown Command", "Type 'help' for", "available commands", "", 2000);
-    #endif
+    default:
+      break;
+  }
+}
+#endif
+
+void printHelp();
+
+// A serial command, its handler and its line in the help output
+struct Command {
+  const char* name;
+  void (*handler)();
+  const char* help;
+  const char* argument;   // Name of the argument in the help output, NULL if the command takes none
+};
+
+// Command table - handleCommand(), the help output and the welcome menu all come from here
+constexpr Command COMMANDS[] = {
+  {"info", printSensorData, "Display current sensor data", nullptr},
+  {"raw", printRawValues, "Display raw ADC values", nullptr},
+  {"list", printGestureList, "Display list of supported gestures", nullptr},
+  {"finger", printFingerBending, "Display finger bend angle visualization", nullptr},
+  {"features", printFeatures, "Display statistical features used by the model", nullptr},
+  {"debug", toggleDebugMode, "Toggle debug mode", nullptr},
+  {"tasks", printTaskStats, "Display task timing, inference trigger, classifier stage and decision statistics", nullptr},
+  {"calibrate", startCalibrationCommand, "Capture straight and bent values of each finger and save them", nullptr},
+  {"calibration", printCalibration, "Display the flex calibration in use", nullptr},
+  {"calreset", resetCalibrationCommand, "Erase the stored calibration and use the config.h values", nullptr},
+#ifdef USE_DTW_MATCHER
+  {"enroll", enrollCommand, "Record a motion sign and save it", "name"},
+  {"templates", printDtwStats, "Display the motion signs and matcher statistics", nullptr},
+  {"forget", forgetCommand, "Remove the motion sign with this name", "name"},
+#endif
+#ifdef ENABLE_BENCHMARK
+  {"bench", runBenchmarkCommand, "Time each processing stage", nullptr},
+#endif
+#ifdef USE_LCD
+  {"lcd", toggleBacklightCommand, "Toggle LCD backlight", nullptr},
+#endif
+  {"help", printHelp, "Display this help message", nullptr},
+};
+
+constexpr int COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+void printCommandList() {
+  for (int i = 0; i < COMMAND_COUNT; i++) {
+    Serial.print("  ");
+    Serial.print(COMMANDS[i].name);
+    if (COMMANDS[i].argument) {
+      Serial.print(" <");
+      Serial.print(COMMANDS[i].argument);
+      Serial.print(">");
+    }
+    Serial.print(" - ");
+    Serial.println(COMMANDS[i].help);
   }
 }
 
+/**
+ * @brief Display help
+ */
+void printHelp() {
+  Serial.println("\nAvailable commands:");
+  printCommandList();
+  
+  #ifdef USE_LCD
+  // Show the command names on LCD, packed into as many words per line as fit,
+  // one screen after another
+  char lines[4][21] = {"Commands:"};
+  int row = 0;
+  for (int i = 0; i < COMMAND_COUNT; i++) {
+    size_t length = strlen(lines[row]);
+    size_t needed = strlen(COMMANDS[i].name) + (i < COMMAND_COUNT - 1 ? 1 : 0);
+    if (length > 0 && length + 1 + needed > 20) {
+      if (++row == 4) {
+        showTempMessage(lines[0], lines[1], lines[2], lines[3], 3000);
+        memset(lines, 0, sizeof(lines));
+        row = 0;
+      }
+      length = 0;
+    }
+    snprintf(lines[row] + length, sizeof(lines[row]) - length, "%s%s%s",
+             length > 0 ? " " : "", COMMANDS[i].name, i < COMMAND_COUNT - 1 ? "," : "");
+  }
+  showTempMessage(lines[0], lines[1], lines[2], lines[3], 3000);
+  #endif
+}
+
+/**
+ * @brief Terminate the received line, trim trailing whitespace and handle it as a command
+ */
+void runCommandLine() {
+  commandLine[commandLength] = '\0';
+  while (commandLength > 0 && isspace((unsigned char)commandLine[commandLength - 1])) {
+    commandLine[--commandLength] = '\0';
+  }
+  commandLength = 0;
+  commandState = COMMAND_IDLE;
+  handleCommand(commandLine);
+}
+
+bool feedCommandByte(char c) {
+  bool lineEnd = c == '\n' || c == '\r';
+  
+  switch (commandState) {
+    case COMMAND_IDLE:
+      // Line endings of the previous line (CR LF) and leading whitespace are skipped
+      if (lineEnd || isspace((unsigned char)c)) return false;
+      commandState = COMMAND_RECEIVING;
+      commandLine[commandLength++] = c;
+      return false;
+      
+    case COMMAND_RECEIVING:
+      if (lineEnd) {
+        runCommandLine();
+        return true;
+      }
+      if (commandLength < COMMAND_LINE_SIZE - 1) {
+        commandLine[commandLength++] = c;
+      } else {
+        commandState = COMMAND_DISCARDING;
+      }
+      return false;
+      
+    case COMMAND_DISCARDING:
+      if (!lineEnd) return false;
+      commandLength = 0;
+      commandState = COMMAND_IDLE;
+      Serial.println("Command too long. Type 'help' for available commands.");
+      return true;
+  }
+  return false;
+}
+
+void pollSerialCommands() {
+  // Bytes after a completed line stay in the RX buffer until the next poll
+  while (Serial.available()) {
+    lastCommandByteMs = millis();
+    if (feedCommandByte((char)Serial.read())) return;
+  }
+  
+  // No line ending - end the line once the input has gone quiet
+  if (commandState != COMMAND_IDLE && millis() - lastCommandByteMs >= COMMAND_TIMEOUT_MS) {
+    feedCommandByte('\n');
+  }
+}
+
+void handleCommand(const char* command) {
+  // The name ends at the first space, the argument starts after the spaces that follow it
+  const char* space = strchr(command, ' ');
+  size_t nameLength = space ? (size_t)(space - command) : strlen(command);
+  const char* argument = command + nameLength;
+  while (*argument == ' ') argument++;
+  
+  for (int i = 0; i < COMMAND_COUNT; i++) {
+    if (strlen(COMMANDS[i].name) == nameLength && strncmp(command, COMMANDS[i].name, nameLength) == 0 &&
+        (COMMANDS[i].argument || *argument == '\0')) {
+      commandArgument = argument;
+      COMMANDS[i].handler();
+      commandArgument = "";
+      return;
+    }
+  }
+  
+  Serial.println("Unknown command. Type 'help' for available commands.");
+  
+  #ifdef USE_LCD
+  showTempMessage("Unknown Command", "Type 'help' for", "available commands", "", 2000);
+  #endif
+}
+
 void showWelcomeMessage() {
   Serial.println("==================================================");
   Serial.println("|      Sign Language Glove - Gesture Recognition |");
@@ -339,10 +767,21 @@ void showWelcomeMessage() {
   Serial.println("\nFeature configuration:");
   Serial.print("Using ");
   Serial.print(FEATURE_COUNT);
-  Serial.println(" statistical features (7 statistics for 5 flex sensors)");
+  Serial.print(" statistical features (");
+  Serial.print(STATS_PER_SENSOR);
+  Serial.print(" statistics for ");
+  Serial.print(WINDOW_CHANNEL_COUNT);
+  Serial.println(" sensor channels)");
   Serial.print("Data window size: ");
   Serial.print(WINDOW_SIZE);
   Serial.println(" samples");
+  Serial.print("Flex calibration: ");
+  Serial.println(calibrationSourceName(flexCalibration.source));
+  #ifdef USE_DTW_MATCHER
+  Serial.print("Motion signs: ");
+  Serial.print(dtw.count);
+  Serial.println(" templates in flash");
+  #endif
   
   // Display all supported gestures
   printGestureList();
@@ -350,16 +789,7 @@ void showWelcomeMessage() {
   Serial.println("\nReady to recognize gestures...");
   Serial.println("--------------------------------------------------");
   Serial.println("Command Menu:");
-  Serial.println("  info - Display current sensor data");
-  Serial.println("  raw - Display raw ADC values");
-  Serial.println("  list - Display list of supported gestures");
-  Serial.println("  finger - Display finger bend angle visualization");
-  Serial.println("  features - Display statistical features used by the model");
-  #ifdef USE_LCD
-  Serial.println("  lcd - Toggle LCD backlight");
-  #endif
-  Serial.println("  debug - Toggle debug mode");
-  Serial.println("  help - Display all available commands");
+  printCommandList();
   Serial.println("--------------------------------------------------");
   
   #ifdef USE_LCD
@@ -0,0 +1,286 @@
+/*
+ * window_simd.h - Vectorized Window Kernels
+ *
+ * Full-window sums, extremes and central moments computed with the widest
+ * vector unit available: CMSIS-DSP on the Cortex-M4F, AVX or SSE on the host
+ * build, and plain loops elsewhere. With USE_SIMD_STATISTICS the features are
+ * rescanned from the whole window at each inference instead of being tracked
+ * per sample in double precision, which the single-precision FPU of the
+ * Cortex-M4F has to emulate. Central power sums above the highest moment
+ * the feature spec needs are not computed.
+ */
+
+#ifndef WINDOW_SIMD_H
+#define WINDOW_SIMD_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "feature_spec.h"
+
+#if defined(__arm__) && defined(ARDUINO)
+#include <edge-impulse-sdk/CMSIS/DSP/Include/arm_math.h>
+#define WINDOW_SIMD_CMSIS
+#define WINDOW_SIMD_NAME "CMSIS-DSP"
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define WINDOW_SIMD_AVX
+#define WINDOW_SIMD_NAME "AVX"
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define WINDOW_SIMD_SSE
+#define WINDOW_SIMD_NAME "SSE"
+#else
+#define WINDOW_SIMD_NAME "scalar"
+#endif
+
+// Raw sums and extremes of a window
+struct WindowSums {
+  float sum;
+  float sum2;
+  float min;
+  float max;
+};
+
+// Power sums of (value - center) over a window
+struct WindowCentralSums {
+  float s1, s2, s3, s4;
+};
+
+/**
+ * @brief Sum, sum of squares, minimum and maximum of n samples
+ */
+void windowRawSums(const float* window, int n, WindowSums* out);
+
+/**
+ * @brief Sums of the first MOMENTS powers (2 to 4) of (value - center) over n samples - the others are left at 0
+ */
+template <int MOMENTS>
+void windowCentralSums(const float* window, int n, float center, WindowCentralSums* out);
+
+/**
+ * @brief Vectorized equivalent of calculateStatistics() for one window row
+ * @param window WINDOW_SIZE samples
+ * @param stats Array to store the STATS_PER_SENSOR statistics
+ */
+void calculateStatisticsSimd(const float* window, float* stats);
+
+// Implementation section ---------------------------------
+
+#if defined(WINDOW_SIMD_CMSIS)
+
+// Deviations and their squares for the central moment kernels
+float simdDeviation[WINDOW_STRIDE];
+float simdDeviation2[WINDOW_STRIDE];
+
+void windowRawSums(const float* window, int n, WindowSums* out) {
+  uint32_t index;
+  float mean;
+  arm_mean_f32(window, n, &mean);
+  out->sum = mean * n;
+  arm_power_f32(window, n, &out->sum2);
+  arm_min_f32(window, n, &out->min, &index);
+  arm_max_f32(window, n, &out->max, &index);
+}
+
+template <int MOMENTS>
+void windowCentralSums(const float* window, int n, float center, WindowCentralSums* out) {
+  float mean;
+  arm_offset_f32(window, -center, simdDeviation, n);
+  arm_mean_f32(simdDeviation, n, &mean);
+  out->s1 = mean * n;
+  out->s3 = out->s4 = 0;
+  if (MOMENTS >= 3) {
+    arm_mult_f32(simdDeviation, simdDeviation, simdDeviation2, n);
+    arm_mean_f32(simdDeviation2, n, &mean);
+    out->s2 = mean * n;
+    arm_dot_prod_f32(simdDeviation2, simdDeviation, n, &out->s3);
+    if (MOMENTS >= 4) arm_power_f32(simdDeviation2, n, &out->s4);
+  } else {
+    arm_power_f32(simdDeviation, n, &out->s2);
+  }
+}
+
+#elif defined(WINDOW_SIMD_AVX) || defined(WINDOW_SIMD_SSE)
+
+#if defined(WINDOW_SIMD_AVX)
+#define SIMD_WIDTH 8
+typedef __m256 simd_t;
+#define simdLoad _mm256_loadu_ps
+#define simdSet1 _mm256_set1_ps
+#define simdAdd _mm256_add_ps
+#define simdSub _mm256_sub_ps
+#define simdMul _mm256_mul_ps
+#define simdMin _mm256_min_ps
+#define simdMax _mm256_max_ps
+
+// Fold the upper half onto the lower one, then reduce as SSE
+inline __m128 simdFold(__m256 v, __m128 (*op)(__m128, __m128)) {
+  __m128 r = op(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  r = op(r, _mm_movehl_ps(r, r));
+  return op(r, _mm_shuffle_ps(r, r, 0x55));
+}
+#else
+#define SIMD_WIDTH 4
+typedef __m128 simd_t;
+#define simdLoad _mm_loadu_ps
+#define simdSet1 _mm_set1_ps
+#define simdAdd _mm_add_ps
+#define simdSub _mm_sub_ps
+#define simdMul _mm_mul_ps
+#define simdMin _mm_min_ps
+#define simdMax _mm_max_ps
+
+inline __m128 simdFold(__m128 r, __m128 (*op)(__m128, __m128)) {
+  r = op(r, _mm_movehl_ps(r, r));
+  return op(r, _mm_shuffle_ps(r, r, 0x55));
+}
+#endif
+
+inline __m128 simdAdd4(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+inline __m128 simdMin4(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
+inline __m128 simdMax4(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+
+inline float simdSum(simd_t v) { return _mm_cvtss_f32(simdFold(v, simdAdd4)); }
+inline float simdMinOf(simd_t v) { return _mm_cvtss_f32(simdFold(v, simdMin4)); }
+inline float simdMaxOf(simd_t v) { return _mm_cvtss_f32(simdFold(v, simdMax4)); }
+
+void windowRawSums(const float* window, int n, WindowSums* out) {
+  int i = 0;
+  float sum = 0, sum2 = 0;
+  float min = window[0], max = window[0];
+
+  if (n >= SIMD_WIDTH) {
+    simd_t vSum = simdSet1(0), vSum2 = simdSet1(0);
+    simd_t vMin = simdLoad(window), vMax = vMin;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+      simd_t v = simdLoad(window + i);
+      vSum = simdAdd(vSum, v);
+      vSum2 = simdAdd(vSum2, simdMul(v, v));
+      vMin = simdMin(vMin, v);
+      vMax = simdMax(vMax, v);
+    }
+    sum = simdSum(vSum);
+    sum2 = simdSum(vSum2);
+    min = simdMinOf(vMin);
+    max = simdMaxOf(vMax);
+  }
+
+  // Samples past the last full vector
+  for (; i < n; i++) {
+    float v = window[i];
+    sum += v;
+    sum2 += v * v;
+    if (v < min) min = v;
+    if (v > max) max = v;
+  }
+
+  out->sum = sum;
+  out->sum2 = sum2;
+  out->min = min;
+  out->max = max;
+}
+
+template <int MOMENTS>
+void windowCentralSums(const float* window, int n, float center, WindowCentralSums* out) {
+  int i = 0;
+  float s1 = 0, s2 = 0, s3 = 0, s4 = 0;
+
+  if (n >= SIMD_WIDTH) {
+    simd_t vCenter = simdSet1(center);
+    simd_t v1 = simdSet1(0), v2 = simdSet1(0), v3 = simdSet1(0), v4 = simdSet1(0);
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+      simd_t d = simdSub(simdLoad(window + i), vCenter);
+      simd_t d2 = simdMul(d, d);
+      v1 = simdAdd(v1, d);
+      v2 = simdAdd(v2, d2);
+      if (MOMENTS >= 3) v3 = simdAdd(v3, simdMul(d2, d));
+      if (MOMENTS >= 4) v4 = simdAdd(v4, simdMul(d2, d2));
+    }
+    s1 = simdSum(v1);
+    s2 = simdSum(v2);
+    s3 = simdSum(v3);
+    s4 = simdSum(v4);
+  }
+
+  for (; i < n; i++) {
+    float d = window[i] - center;
+    float d2 = d * d;
+    s1 += d;
+    s2 += d2;
+    if (MOMENTS >= 3) s3 += d2 * d;
+    if (MOMENTS >= 4) s4 += d2 * d2;
+  }
+
+  out->s1 = s1;
+  out->s2 = s2;
+  out->s3 = s3;
+  out->s4 = s4;
+}
+
+#else
+
+void windowRawSums(const float* window, int n, WindowSums* out) {
+  out->sum = out->sum2 = 0;
+  out->min = out->max = window[0];
+  for (int i = 0; i < n; i++) {
+    float v = window[i];
+    out->sum += v;
+    out->sum2 += v * v;
+    if (v < out->min) out->min = v;
+    if (v > out->max) out->max = v;
+  }
+}
+
+template <int MOMENTS>
+void windowCentralSums(const float* window, int n, float center, WindowCentralSums* out) {
+  out->s1 = out->s2 = out->s3 = out->s4 = 0;
+  for (int i = 0; i < n; i++) {
+    float d = window[i] - center;
+    float d2 = d * d;
+    out->s1 += d;
+    out->s2 += d2;
+    if (MOMENTS >= 3) out->s3 += d2 * d;
+    if (MOMENTS >= 4) out->s4 += d2 * d2;
+  }
+}
+
+#endif
+
+void calculateStatisticsSimd(const float* window, float* stats) {
+  float all[STATISTIC_COUNT] = {0};
+  WindowSums raw;
+  windowRawSums(window, WINDOW_SIZE, &raw);
+
+  float mean = raw.sum / WINDOW_SIZE;
+  all[STAT_MEAN] = mean;
+  all[STAT_MIN] = raw.min;
+  all[STAT_MAX] = raw.max;
+  all[STAT_RMS] = sqrt(raw.sum2 / WINDOW_SIZE);
+
+  if (WindowFeatures::MOMENTS >= 2) {
+    WindowCentralSums central;
+    windowCentralSums<WindowFeatures::MOMENTS>(window, WINDOW_SIZE, mean, &central);
+
+    // The float mean is off by up to half an ulp, which biases the odd moments of windows whose
+    // spread is small next to their mean - correct the sums for the residual offset s1 / n
+    float m1 = central.s1 / WINDOW_SIZE;
+    float r2 = central.s2 / WINDOW_SIZE;
+    float r3 = central.s3 / WINDOW_SIZE;
+    float r4 = central.s4 / WINDOW_SIZE;
+    float variance = r2 - m1 * m1;
+    if (variance < 0) variance = 0;
+    float m3 = r3 - 3 * m1 * r2 + 2 * m1 * m1 * m1;
+    float m4 = r4 - 4 * m1 * r3 + 6 * m1 * m1 * r2 - 3 * m1 * m1 * m1 * m1;
+
+    float stdev = sqrt(variance);
+    all[STAT_STDEV] = stdev;
+
+    // Same thresholds as calculateStatistics()
+    all[STAT_SKEWNESS] = (stdev > 0.0001) ? (m3 / (stdev * stdev * stdev)) : 0;
+    all[STAT_KURTOSIS] = (variance > 0.0001) ? (m4 / (variance * variance)) - 3 : 0;
+  }
+
+  selectStatistics(all, stats);
+}
+
+#endif // WINDOW_SIMD_H
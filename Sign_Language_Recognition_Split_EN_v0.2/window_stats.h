@@ -0,0 +1,226 @@
+/*
+ * window_stats.h - Sliding Window Statistics
+ *
+ * Maintains running moments and min/max for a sensor data window so the
+ * statistical features can be read at any time without rescanning the window.
+ * Only the moments and extremes the feature spec needs are tracked
+ */
+
+#ifndef WINDOW_STATS_H
+#define WINDOW_STATS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "feature_spec.h"
+
+// Running statistics state for one sensor window
+struct RunningStats {
+  const float* window;      // Ring buffer the statistics are tracking
+  int count;                // Number of valid samples in the window
+
+  // Power sums of (value - shift), kept in double to limit cancellation
+  double shift;
+  double sum, sum2, sum3, sum4;
+  uint32_t rebasedSeq;      // Sequence number of the sample that last triggered an early recomputation
+
+  // Monotonic deques of sample sequence numbers for min/max
+  uint32_t minDeque[WINDOW_SIZE];
+  uint32_t maxDeque[WINDOW_SIZE];
+  int minHead, minCount;
+  int maxHead, maxCount;
+};
+
+/**
+ * @brief Initialize running statistics for a sensor window
+ * @param rs Running statistics state
+ * @param window Ring buffer of WINDOW_SIZE samples the state tracks
+ */
+void initRunningStats(RunningStats* rs, const float* window);
+
+/**
+ * @brief Update running statistics after a sample has been written to the window
+ * @param rs Running statistics state
+ * @param seq Sequence number of the new sample (its slot is seq % WINDOW_SIZE)
+ * @param oldValue Value that was overwritten in that slot
+ */
+void pushRunningStats(RunningStats* rs, uint32_t seq, float oldValue);
+
+/**
+ * @brief Recompute the power sums from the window contents around its current mean
+ */
+void rebaseRunningStats(RunningStats* rs);
+
+/**
+ * @brief Read the feature spec's statistics in O(1)
+ * @param rs Running statistics state
+ * @param stats Array to store the STATS_PER_SENSOR statistics
+ */
+void getRunningStatistics(const RunningStats* rs, float* stats);
+
+/**
+ * @brief Mean of the window in O(1), whatever the feature spec
+ */
+float getRunningMean(const RunningStats* rs);
+
+// Implementation section ---------------------------------
+
+void initRunningStats(RunningStats* rs, const float* window) {
+  rs->window = window;
+  rs->count = 0;
+  rs->shift = 0;
+  rs->sum = rs->sum2 = rs->sum3 = rs->sum4 = 0;
+  rs->rebasedSeq = 0;
+  rs->minHead = rs->minCount = 0;
+  rs->maxHead = rs->maxCount = 0;
+}
+
+void pushRunningStats(RunningStats* rs, uint32_t seq, float oldValue) {
+  float newValue = rs->window[seq % WINDOW_SIZE];
+
+  // First sample sets the shift so the sums start out well conditioned
+  if (rs->count == 0) {
+    rs->shift = newValue;
+  }
+
+  // Remove the sample leaving the window
+  if (rs->count == WINDOW_SIZE) {
+    double d = oldValue - rs->shift;
+    double d2 = d * d;
+    rs->sum -= d;
+    rs->sum2 -= d2;
+    if (WindowFeatures::MOMENTS >= 3) rs->sum3 -= d2 * d;
+    if (WindowFeatures::MOMENTS >= 4) rs->sum4 -= d2 * d2;
+  } else {
+    rs->count++;
+  }
+
+  // Add the sample entering the window
+  double d = newValue - rs->shift;
+  double d2 = d * d;
+  rs->sum += d;
+  rs->sum2 += d2;
+  if (WindowFeatures::MOMENTS >= 3) rs->sum3 += d2 * d;
+  if (WindowFeatures::MOMENTS >= 4) rs->sum4 += d2 * d2;
+
+  // Drop the expired position from the front of each deque, pop dominated positions
+  // from the back, then append the new one
+  uint32_t oldest = seq - (WINDOW_SIZE - 1);
+  if (WindowFeatures::NEEDS_MIN) {
+    if (rs->minCount > 0 && (int32_t)(rs->minDeque[rs->minHead] - oldest) < 0) {
+      rs->minHead = (rs->minHead + 1) % WINDOW_SIZE;
+      rs->minCount--;
+    }
+    while (rs->minCount > 0) {
+      int back = (rs->minHead + rs->minCount - 1) % WINDOW_SIZE;
+      if (rs->window[rs->minDeque[back] % WINDOW_SIZE] < newValue) break;
+      rs->minCount--;
+    }
+    rs->minDeque[(rs->minHead + rs->minCount) % WINDOW_SIZE] = seq;
+    rs->minCount++;
+  }
+
+  if (WindowFeatures::NEEDS_MAX) {
+    if (rs->maxCount > 0 && (int32_t)(rs->maxDeque[rs->maxHead] - oldest) < 0) {
+      rs->maxHead = (rs->maxHead + 1) % WINDOW_SIZE;
+      rs->maxCount--;
+    }
+    while (rs->maxCount > 0) {
+      int back = (rs->maxHead + rs->maxCount - 1) % WINDOW_SIZE;
+      if (rs->window[rs->maxDeque[back] % WINDOW_SIZE] > newValue) break;
+      rs->maxCount--;
+    }
+    rs->maxDeque[(rs->maxHead + rs->maxCount) % WINDOW_SIZE] = seq;
+    rs->maxCount++;
+  }
+
+  // Once per lap, recompute the sums to stop rounding error from accumulating. A window that
+  // has moved far from the shift compared to its spread (the filter settling on a held pose)
+  // also loses most digits of the higher moments to cancellation, so it is recomputed early -
+  // at most every STATS_REBASE_INTERVAL samples, so a window that keeps moving away cannot
+  // make every sample a full pass
+  if (rs->count == WINDOW_SIZE) {
+    double m1 = rs->sum / WINDOW_SIZE;
+    double variance = rs->sum2 / WINDOW_SIZE - m1 * m1;
+    if ((seq + 1) % WINDOW_SIZE == 0) {
+      rebaseRunningStats(rs);
+    } else if (m1 * m1 > 1e4 * variance && seq - rs->rebasedSeq >= STATS_REBASE_INTERVAL) {
+      rebaseRunningStats(rs);
+      rs->rebasedSeq = seq;
+    }
+  }
+}
+
+void rebaseRunningStats(RunningStats* rs) {
+  if (rs->count < WINDOW_SIZE) return;
+
+  double mean = 0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    mean += rs->window[i];
+  }
+  mean /= WINDOW_SIZE;
+
+  rs->shift = mean;
+  rs->sum = rs->sum2 = rs->sum3 = rs->sum4 = 0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    double d = rs->window[i] - mean;
+    double d2 = d * d;
+    rs->sum += d;
+    rs->sum2 += d2;
+    if (WindowFeatures::MOMENTS >= 3) rs->sum3 += d2 * d;
+    if (WindowFeatures::MOMENTS >= 4) rs->sum4 += d2 * d2;
+  }
+}
+
+float getRunningMean(const RunningStats* rs) {
+  return rs->count ? (float)(rs->shift + rs->sum / rs->count) : 0;
+}
+
+void getRunningStatistics(const RunningStats* rs, float* stats) {
+  float all[STATISTIC_COUNT] = {0};
+  if (rs->count == 0) {
+    selectStatistics(all, stats);
+    return;
+  }
+
+  double n = rs->count;
+
+  // Raw moments of the shifted samples
+  double m1 = rs->sum / n;
+  double r2 = rs->sum2 / n;
+  double r3 = rs->sum3 / n;
+  double r4 = rs->sum4 / n;
+
+  // Average (mean)
+  double mean = rs->shift + m1;
+  all[STAT_MEAN] = mean;
+
+  // Minimum and maximum from the front of the deques
+  if (WindowFeatures::NEEDS_MIN) all[STAT_MIN] = rs->window[rs->minDeque[rs->minHead] % WINDOW_SIZE];
+  if (WindowFeatures::NEEDS_MAX) all[STAT_MAX] = rs->window[rs->maxDeque[rs->maxHead] % WINDOW_SIZE];
+
+  // Root-mean square - sum of squares of the unshifted values
+  double meanSquare = r2 + 2 * rs->shift * m1 + rs->shift * rs->shift;
+  all[STAT_RMS] = sqrt(meanSquare > 0 ? meanSquare : 0);
+
+  if (WindowFeatures::MOMENTS >= 2) {
+    // Central moments
+    double variance = r2 - m1 * m1;
+    if (variance < 0) variance = 0;
+    double m3 = r3 - 3 * m1 * r2 + 2 * m1 * m1 * m1;
+    double m4 = r4 - 4 * m1 * r3 + 6 * m1 * m1 * r2 - 3 * m1 * m1 * m1 * m1;
+
+    // Standard deviation
+    double stdev = sqrt(variance);
+    all[STAT_STDEV] = stdev;
+
+    // Skewness - Avoid division by zero
+    all[STAT_SKEWNESS] = (stdev > 0.0001) ? m3 / (stdev * stdev * stdev) : 0;
+
+    // Kurtosis - Avoid division by zero
+    all[STAT_KURTOSIS] = (variance > 0.0001) ? m4 / (variance * variance) - 3 : 0;
+  }
+
+  selectStatistics(all, stats);
+}
+
+#endif // WINDOW_STATS_H
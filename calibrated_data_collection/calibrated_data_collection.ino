@@ -7,6 +7,7 @@
  * 3. 从所有传感器收集数据(内置IMU和弯曲传感器)
  * 4. 数据预处理和格式化
  * 5. 通过串口将数据发送到Edge Impulse Studio进行模型训练
+ * 6. 可选二进制遥测模式(USE_BINARY_TELEMETRY)，以200Hz发送带CRC的紧凑帧
  * 
  * 使用方法:
  * 1. 将下面的FLEX_XXX_STRAIGHT_ADC和FLEX_XXX_BENT_ADC替换为校准程序输出的值
@@ -17,6 +18,10 @@
  */
 
 #include <Arduino_LSM9DS1.h>
+#include "telemetry.h"
+
+// 二进制遥测 - 取消注释此行以发送二进制帧代替CSV文本(帧格式见telemetry.h，用host/glove_decode转换回CSV)
+// #define USE_BINARY_TELEMETRY
 
 // 弯曲传感器引脚定义
 #define FLEX_PIN_THUMB A0
@@ -61,8 +66,16 @@ const int FLEX_BENT_ADC[5] = {
 };
 
 // 采样配置
+#ifdef USE_BINARY_TELEMETRY
+#define FREQUENCY_HZ        200   // 数据采样频率 - 二进制帧平均约20字节，200Hz仍远低于串口带宽
+#else
 #define FREQUENCY_HZ        50    // 数据采样频率
-#define INTERVAL_MS         (1000 / FREQUENCY_HZ)
+#endif
+#define INTERVAL_US         (1000000UL / FREQUENCY_HZ)
+
+// 二进制遥测配置
+#define TELEMETRY_KEY_INTERVAL   50    // 每50帧发送一个完整的关键帧，其余帧只发送差值
+#define TELEMETRY_INFO_INTERVAL  1000  // 每1000帧重发一次采集设置，方便中途连接的主机解码
 
 // 滤波参数
 const float ALPHA = 0.2;  // 低通滤波系数
@@ -72,6 +85,14 @@ float filteredFlexValues[5] = {0};
 float filteredAx = 0, filteredAy = 0, filteredAz = 0;
 float filteredGx = 0, filteredGy = 0, filteredGz = 0;
 
+// 最近一次的原始读数 - 二进制遥测发送原始值，由主机端重新计算弯曲度和滤波
+int rawFlexValues[5] = {0};
+float rawImuValues[6] = {0};  // ax, ay, az (g), gx, gy, gz (dps)
+
+// 二进制遥测编码器和已发送的帧数
+TelemetryEncoder telemetry;
+unsigned long telemetryFrames = 0;
+
 // 时间记录
 unsigned long lastSampleTime = 0;
 
@@ -121,17 +142,16 @@ float lowPassFilter(float currentValue, float previousFilteredValue, float alpha
  */
 void readAllSensors() {
   // 读取弯曲传感器数据
-  int flexRawValues[5];
-  flexRawValues[0] = analogRead(FLEX_PIN_THUMB);
-  flexRawValues[1] = analogRead(FLEX_PIN_INDEX);
-  flexRawValues[2] = analogRead(FLEX_PIN_MIDDLE);
-  flexRawValues[3] = analogRead(FLEX_PIN_RING);
-  flexRawValues[4] = analogRead(FLEX_PIN_PINKY);
+  rawFlexValues[0] = analogRead(FLEX_PIN_THUMB);
+  rawFlexValues[1] = analogRead(FLEX_PIN_INDEX);
+  rawFlexValues[2] = analogRead(FLEX_PIN_MIDDLE);
+  rawFlexValues[3] = analogRead(FLEX_PIN_RING);
+  rawFlexValues[4] = analogRead(FLEX_PIN_PINKY);
   
   // 将ADC值转换为弯曲百分比并应用滤波
   for (int i = 0; i < 5; i++) {
     float bendPercentage = calculateBendPercentage(
-      flexRawValues[i], 
+      rawFlexValues[i], 
       FLEX_STRAIGHT_ADC[i], 
       FLEX_BENT_ADC[i]
     );
@@ -147,6 +167,9 @@ void readAllSensors() {
     IMU.readAcceleration(ax, ay, az);
     IMU.readGyroscope(gx, gy, gz);
     
+    rawImuValues[0] = ax; rawImuValues[1] = ay; rawImuValues[2] = az;
+    rawImuValues[3] = gx; rawImuValues[4] = gy; rawImuValues[5] = gz;
+    
     // 应用低通滤波
     filteredAx = lowPassFilter(ax, filteredAx, ALPHA);
     filteredAy = lowPassFilter(ay, filteredAy, ALPHA);
@@ -162,11 +185,7 @@ void readAllSensors() {
  */
 void sendDataToEdgeImpulse() {
   // 创建并发送CSV格式数据
-  // 格式: timestamp,value1,value2,...,valueN
-  unsigned long timestamp = millis();
-  
-  // Serial.print(timestamp);
-  // Serial.print(",");
+  // 格式: value1,value2,...,valueN
   Serial.print(filteredFlexValues[0]);
   Serial.print(",");
   Serial.print(filteredFlexValues[1]);
@@ -190,6 +209,50 @@ void sendDataToEdgeImpulse() {
   Serial.println(filteredGz);
 }
 
+/**
+ * @brief 将IMU读数换算回LSM9DS1寄存器值
+ */
+int16_t imuToRaw(float value, float lsbPerUnit) {
+  long raw = lroundf(value * lsbPerUnit);
+  return (int16_t)constrain(raw, -32768L, 32767L);
+}
+
+/**
+ * @brief 发送二进制遥测帧 - 原始ADC和IMU值，一次Serial.write()发送整帧
+ * @param sampleUs 采样时间(微秒)
+ */
+void sendTelemetryFrame(unsigned long sampleUs) {
+  static uint8_t frame[TELEMETRY_MAX_FRAME];
+  size_t length;
+  
+  // 开始时和每TELEMETRY_INFO_INTERVAL帧发送一次采集设置(采样率、滤波系数、校准值)
+  if (telemetryFrames % TELEMETRY_INFO_INTERVAL == 0) {
+    TelemetryInfo info;
+    info.sampleRateHz = FREQUENCY_HZ;
+    info.alphaQ16 = (uint32_t)(ALPHA * 65536.0F + 0.5F);
+    for (int i = 0; i < 5; i++) {
+      info.straightAdc[i] = FLEX_STRAIGHT_ADC[i];
+      info.bentAdc[i] = FLEX_BENT_ADC[i];
+    }
+    length = encodeTelemetryInfo(&telemetry, info, frame);
+    Serial.write(frame, length);
+  }
+  
+  TelemetrySample sample;
+  sample.timeUs = sampleUs;
+  for (int i = 0; i < 5; i++) {
+    sample.values[i] = rawFlexValues[i];
+  }
+  for (int i = 0; i < 3; i++) {
+    sample.values[5 + i] = imuToRaw(rawImuValues[i], TELEMETRY_ACCEL_LSB_PER_G);
+    sample.values[8 + i] = imuToRaw(rawImuValues[3 + i], TELEMETRY_GYRO_LSB_PER_DPS);
+  }
+  
+  length = encodeTelemetrySample(&telemetry, sample, frame);
+  Serial.write(frame, length);
+  telemetryFrames++;
+}
+
 /**
  * @brief 显示传感器校准状态
  */
@@ -337,23 +400,34 @@ void setup() {
   
   // 表示准备就绪
   isCalibrated = true;
+  initTelemetryEncoder(&telemetry, TELEMETRY_KEY_INTERVAL);
+  lastSampleTime = micros();
 }
 
 /**
  * @brief 主循环函数
  */
 void loop() {
-  unsigned long currentMillis = millis();
+  unsigned long currentMicros = micros();
   
-  // 按照固定频率采样
-  if (currentMillis - lastSampleTime >= INTERVAL_MS) {
-    lastSampleTime = currentMillis;
+  // 按照固定频率采样 - 采样时刻按整周期推进，不随loop()耗时漂移
+  if (currentMicros - lastSampleTime >= INTERVAL_US) {
+    lastSampleTime += INTERVAL_US;
+    if (currentMicros - lastSampleTime >= INTERVAL_US) {
+      // 落后超过一个周期(例如等待串口命令)时重新对齐
+      lastSampleTime = currentMicros;
+    }
     
     // 采集传感器数据
     readAllSensors();
     
+    #ifdef USE_BINARY_TELEMETRY
+    // 发送二进制遥测帧
+    sendTelemetryFrame(currentMicros);
+    #else
     // 发送数据到Edge Impulse
     sendDataToEdgeImpulse();
+    #endif
     
     // LED闪烁表示数据发送
     digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
@@ -0,0 +1,221 @@
+/*
+ * telemetry.h - Binary Telemetry Frames
+ *
+ * Framing of the binary capture stream of calibrated_data_collection.ino,
+ * shared with the host decoder (host/telemetry_decoder.h). Every frame is
+ *
+ *   0xA5 0x5A | type | payload length | sequence (u16) | payload | CRC-16 (u16)
+ *
+ * little-endian, with a CRC-16/CCITT-FALSE over type..payload. Samples carry
+ * the raw flex ADC readings and the IMU readings at LSM9DS1 register
+ * resolution, so the host can redo calibration and filtering. A key frame
+ * holds absolute values; the frames between key frames hold zigzag varint
+ * differences from the previous sample, which mostly fit in one byte each.
+ * An info frame describes the capture (rate, filter, calibration).
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_SYNC_0 0xA5
+#define TELEMETRY_SYNC_1 0x5A
+#define TELEMETRY_CHANNELS 11      // Thumb..pinky ADC, accel xyz, gyro xyz
+#define TELEMETRY_HEADER_SIZE 6    // Sync, type, length and sequence
+#define TELEMETRY_MAX_PAYLOAD 64
+#define TELEMETRY_MAX_FRAME (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + 2)
+
+// Raw IMU resolution - LSM9DS1 registers at +/-4 g and +/-2000 dps, as configured by Arduino_LSM9DS1
+#define TELEMETRY_ACCEL_LSB_PER_G 8192.0F
+#define TELEMETRY_GYRO_LSB_PER_DPS 16.384F
+
+enum TelemetryFrameType {
+  TELEMETRY_FRAME_INFO = 1,   // TelemetryInfo
+  TELEMETRY_FRAME_KEY = 2,    // Timestamp (u32) and values (i16), absolute
+  TELEMETRY_FRAME_DELTA = 3   // Timestamp and value differences from the previous sample, as varints
+};
+
+// Capture settings, sent at the start of the stream and repeated for late listeners
+struct TelemetryInfo {
+  uint16_t sampleRateHz;
+  uint32_t alphaQ16;          // Low-pass filter coefficient of the CSV output in Q16
+  int16_t straightAdc[5];     // Flex calibration, thumb..pinky
+  int16_t bentAdc[5];
+};
+
+// One sample as sent
+struct TelemetrySample {
+  uint32_t timeUs;
+  int16_t values[TELEMETRY_CHANNELS];
+};
+
+// Encoder state - the last sample sent, for the differences
+struct TelemetryEncoder {
+  uint16_t sequence;
+  uint16_t keyInterval;       // Frames from one key frame to the next, 1 sends only key frames
+  uint16_t sinceKey;
+  TelemetrySample previous;
+};
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+ */
+uint16_t telemetryCrc16(const uint8_t* data, size_t length);
+
+/**
+ * @brief Reset an encoder so its next sample frame is a key frame
+ * @param keyInterval Frames from one key frame to the next
+ */
+void initTelemetryEncoder(TelemetryEncoder* encoder, uint16_t keyInterval);
+
+/**
+ * @brief Encode an info frame
+ * @param frame Receives the frame, at least TELEMETRY_MAX_FRAME bytes
+ * @return Frame length in bytes
+ */
+size_t encodeTelemetryInfo(TelemetryEncoder* encoder, const TelemetryInfo& info, uint8_t* frame);
+
+/**
+ * @brief Encode a sample as a key frame or a delta frame
+ * @param frame Receives the frame, at least TELEMETRY_MAX_FRAME bytes
+ * @return Frame length in bytes
+ */
+size_t encodeTelemetrySample(TelemetryEncoder* encoder, const TelemetrySample& sample, uint8_t* frame);
+
+/**
+ * @brief Append an unsigned LEB128 varint
+ * @return Bytes written (at most 5)
+ */
+size_t putVarint(uint32_t value, uint8_t* out);
+
+/**
+ * @brief Read an unsigned LEB128 varint
+ * @return Bytes read, 0 if the varint runs past end
+ */
+size_t getVarint(const uint8_t* in, const uint8_t* end, uint32_t* value);
+
+/**
+ * @brief Map a signed difference to an unsigned varint value (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+ */
+uint32_t zigzagEncode(int32_t value);
+
+/**
+ * @brief Inverse of zigzagEncode()
+ */
+int32_t zigzagDecode(uint32_t value);
+
+// Implementation section ---------------------------------
+
+uint16_t telemetryCrc16(const uint8_t* data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+void initTelemetryEncoder(TelemetryEncoder* encoder, uint16_t keyInterval) {
+  encoder->sequence = 0;
+  encoder->keyInterval = keyInterval > 0 ? keyInterval : 1;
+  encoder->sinceKey = encoder->keyInterval;
+  encoder->previous = TelemetrySample();
+}
+
+size_t putVarint(uint32_t value, uint8_t* out) {
+  size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  out[length++] = (uint8_t)value;
+  return length;
+}
+
+uint32_t zigzagEncode(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+int32_t zigzagDecode(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+size_t getVarint(const uint8_t* in, const uint8_t* end, uint32_t* value) {
+  uint32_t result = 0;
+  for (size_t i = 0; i < 5 && in + i < end; i++) {
+    result |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+    if (!(in[i] & 0x80)) {
+      *value = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Little-endian stores
+ */
+uint8_t* putU16(uint8_t* out, uint16_t value) {
+  out[0] = (uint8_t)value;
+  out[1] = (uint8_t)(value >> 8);
+  return out + 2;
+}
+
+uint8_t* putU32(uint8_t* out, uint32_t value) {
+  out = putU16(out, (uint16_t)value);
+  return putU16(out, (uint16_t)(value >> 16));
+}
+
+/**
+ * @brief Fill in the header and CRC around a payload already written at frame + TELEMETRY_HEADER_SIZE
+ */
+size_t finishTelemetryFrame(TelemetryEncoder* encoder, uint8_t type, size_t payloadLength, uint8_t* frame) {
+  frame[0] = TELEMETRY_SYNC_0;
+  frame[1] = TELEMETRY_SYNC_1;
+  frame[2] = type;
+  frame[3] = (uint8_t)payloadLength;
+  putU16(frame + 4, encoder->sequence++);
+
+  size_t length = TELEMETRY_HEADER_SIZE + payloadLength;
+  putU16(frame + length, telemetryCrc16(frame + 2, length - 2));
+  return length + 2;
+}
+
+size_t encodeTelemetryInfo(TelemetryEncoder* encoder, const TelemetryInfo& info, uint8_t* frame) {
+  uint8_t* p = frame + TELEMETRY_HEADER_SIZE;
+  *p++ = TELEMETRY_VERSION;
+  p = putU16(p, info.sampleRateHz);
+  p = putU32(p, info.alphaQ16);
+  for (int i = 0; i < 5; i++) p = putU16(p, (uint16_t)info.straightAdc[i]);
+  for (int i = 0; i < 5; i++) p = putU16(p, (uint16_t)info.bentAdc[i]);
+  return finishTelemetryFrame(encoder, TELEMETRY_FRAME_INFO, p - frame - TELEMETRY_HEADER_SIZE, frame);
+}
+
+size_t encodeTelemetrySample(TelemetryEncoder* encoder, const TelemetrySample& sample, uint8_t* frame) {
+  uint8_t* p = frame + TELEMETRY_HEADER_SIZE;
+  uint8_t type;
+
+  if (encoder->sinceKey >= encoder->keyInterval) {
+    type = TELEMETRY_FRAME_KEY;
+    p = putU32(p, sample.timeUs);
+    for (int i = 0; i < TELEMETRY_CHANNELS; i++) p = putU16(p, (uint16_t)sample.values[i]);
+    encoder->sinceKey = 1;
+  } else {
+    type = TELEMETRY_FRAME_DELTA;
+    p += putVarint(sample.timeUs - encoder->previous.timeUs, p);
+    for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+      p += putVarint(zigzagEncode((int32_t)sample.values[i] - encoder->previous.values[i]), p);
+    }
+    encoder->sinceKey++;
+  }
+
+  encoder->previous = sample;
+  return finishTelemetryFrame(encoder, type, p - frame - TELEMETRY_HEADER_SIZE, frame);
+}
+
+#endif // TELEMETRY_H
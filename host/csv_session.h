@@ -0,0 +1,155 @@
+/*
+ * csv_session.h - Recorded Glove Session Loading
+ *
+ * Reads the 11-column CSV written by calibrated_data_collection.ino
+ * (5 flex bend percentages, acceleration xyz, gyroscope xyz), optionally
+ * preceded by a timestamp column in milliseconds as in Edge Impulse exports,
+ * and turns a session into the channel values the sketch computes from it
+ */
+
+#ifndef CSV_SESSION_H
+#define CSV_SESSION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include "config.h"
+#include "calibration.h"
+#include "filter_bank.h"
+
+#define CSV_CHANNEL_COUNT 11
+
+// One recorded sample
+struct CsvSample {
+  unsigned long timeMs;
+  float values[CSV_CHANNEL_COUNT];  // thumb..pinky bend (%), ax, ay, az (g), gx, gy, gz (dps)
+};
+
+// One recorded session
+struct CsvSession {
+  std::string path;
+  std::string label;               // Gesture label taken from the file name, empty if unknown
+  bool raw = false;                // Unprocessed capture - flex ADC readings and unfiltered IMU values
+  std::vector<CsvSample> samples;
+};
+
+/**
+ * @brief Take the label from an Edge Impulse style file name ("<label>.<id>.csv")
+ */
+inline std::string csvLabelFromPath(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+  size_t dot = name.find('.');
+  return (dot == std::string::npos) ? name : name.substr(0, dot);
+}
+
+/**
+ * @brief Load a recorded session
+ * @param path CSV file to read
+ * @param periodMs Sample period used when the file has no timestamp column
+ * @param session Loaded session
+ * @return Whether the file could be read and contained at least one sample
+ */
+inline bool loadCsvSession(const char* path, unsigned long periodMs, CsvSession* session) {
+  FILE* file = fopen(path, "r");
+  if (!file) return false;
+
+  session->path = path;
+  session->label = csvLabelFromPath(path);
+  session->raw = false;
+  session->samples.clear();
+
+  char line[512];
+  while (fgets(line, sizeof(line), file)) {
+    float columns[CSV_CHANNEL_COUNT + 1];
+    int count = 0;
+    char* p = line;
+    bool numeric = true;
+
+    while (count < CSV_CHANNEL_COUNT + 1) {
+      char* end;
+      columns[count] = strtof(p, &end);
+      if (end == p) { numeric = false; break; }
+      count++;
+      p = end;
+      while (*p == ' ' || *p == '\t') p++;
+      if (*p != ',') break;
+      p++;
+    }
+
+    // Skip header lines and anything that is not a full sample
+    if (!numeric || count < CSV_CHANNEL_COUNT) continue;
+
+    CsvSample sample;
+    const float* values = columns;
+    if (count == CSV_CHANNEL_COUNT + 1) {
+      sample.timeMs = (unsigned long)columns[0];
+      values++;
+    } else {
+      sample.timeMs = session->samples.size() * periodMs;
+    }
+    memcpy(sample.values, values, sizeof(sample.values));
+    session->samples.push_back(sample);
+  }
+
+  fclose(file);
+
+  // Make timestamps relative to the first sample
+  if (!session->samples.empty()) {
+    unsigned long start = session->samples[0].timeMs;
+    for (CsvSample& sample : session->samples) sample.timeMs -= start;
+  }
+  return !session->samples.empty();
+}
+
+/**
+ * @brief Convert a bend percentage back to the ADC reading that produces it
+ */
+inline int bendToAdc(float bend, int straightAdc, int bentAdc) {
+  float adc = straightAdc + (bentAdc - straightAdc) * bend / 100.0F;
+  return (int)(adc + (adc >= 0 ? 0.5F : -0.5F));
+}
+
+/**
+ * @brief Channel values of a session as the sketch computes them
+ *
+ * Flex values go through the bend table of the config.h calibration, so they are clamped to
+ * 0..100 % and quantized like readAllSensors() output. Raw captures then run through the
+ * configured FLEX_FILTER and IMU_FILTER chains; CSV captures were filtered when recorded.
+ * @return One frame of CSV_CHANNEL_COUNT values per sample
+ */
+inline std::vector<std::vector<float>> sessionFrames(const CsvSession& session) {
+  static int16_t bendTables[5][FLEX_ADC_LEVELS];
+  static bool tablesBuilt = false;
+  if (!tablesBuilt) {
+    for (int finger = 0; finger < 5; finger++) {
+      buildBendTable(FLEX_STRAIGHT_ADC[finger], FLEX_BENT_ADC[finger], bendTables[finger]);
+    }
+    tablesBuilt = true;
+  }
+
+  FLEX_FILTER flexChain;
+  IMU_FILTER imuChain;
+  std::vector<std::vector<float>> frames;
+  frames.reserve(session.samples.size());
+  for (const CsvSample& sample : session.samples) {
+    std::vector<float> frame(sample.values, sample.values + CSV_CHANNEL_COUNT);
+    for (int finger = 0; finger < 5; finger++) {
+      int adc = session.raw ? (int)frame[finger]
+                            : bendToAdc(frame[finger], FLEX_STRAIGHT_ADC[finger], FLEX_BENT_ADC[finger]);
+      frame[finger] = bendTables[finger][constrain(adc, 0, FLEX_ADC_LEVELS - 1)] * (1.0F / 256);
+    }
+    if (session.raw) {
+      flexChain.process(frame.data());
+      imuChain.process(frame.data() + 5);
+    }
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+#endif // CSV_SESSION_H
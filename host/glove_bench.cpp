@@ -0,0 +1,113 @@
+/*
+ * glove_bench.cpp - Host backend of the hot path microbenchmarks
+ *
+ * Runs the stage benchmarks from benchmark.h against the host build and
+ * compares the ns/call of each stage with a baseline file, so changes to
+ * the hot path show their cost in review. The same stages are timed on the
+ * glove with the DWT cycle counter through the 'bench' serial command.
+ *
+ * Usage: glove_bench [--min-time-ms N] [--baseline FILE] [--write-baseline FILE] [--tolerance PCT]
+ */
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+#include "Sign_Language_Recognition_Split_EN_v0.2.ino"
+
+/**
+ * @brief Read "<stage> <ns_per_call>" lines, ignoring comments
+ */
+static bool readBaseline(const char* path, std::map<std::string, float>* baseline) {
+  FILE* file = fopen(path, "r");
+  if (!file) return false;
+
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == '#') continue;
+    char name[128];
+    float ns;
+    if (sscanf(line, "%127s %f", name, &ns) == 2) (*baseline)[name] = ns;
+  }
+  fclose(file);
+  return true;
+}
+
+static bool writeBaseline(const char* path) {
+  FILE* file = fopen(path, "w");
+  if (!file) return false;
+
+  fprintf(file, "# glove_bench baseline - host ns per call for each stage\n");
+  fprintf(file, "# Regenerate with: glove_bench --write-baseline %s\n", path);
+  for (int i = 0; i < benchResultCount; i++) {
+    fprintf(file, "%s %.1f\n", benchResults[i].name, benchResults[i].nsPerCall);
+  }
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned long minTimeMs = 50;
+  const char* baselinePath = nullptr;
+  const char* writePath = nullptr;
+  float tolerance = 25;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+      minTimeMs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+      baselinePath = argv[++i];
+    } else if (strcmp(argv[i], "--write-baseline") == 0 && i + 1 < argc) {
+      writePath = argv[++i];
+    } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+      tolerance = atof(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--min-time-ms N] [--baseline FILE] [--write-baseline FILE] [--tolerance PCT]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Bring the sketch up silently with a steady mid-range pose on every flex sensor
+  hostReset();
+  const int flexPins[5] = {FLEX_PIN_THUMB, FLEX_PIN_INDEX, FLEX_PIN_MIDDLE, FLEX_PIN_RING, FLEX_PIN_PINKY};
+  for (int finger = 0; finger < 5; finger++) {
+    hostSetAnalog(flexPins[finger], (FLEX_STRAIGHT_ADC[finger] + FLEX_BENT_ADC[finger]) / 2);
+  }
+  Serial.echo = false;
+  setup();
+  Serial.echo = true;
+
+  runBenchmarks(minTimeMs * 1000);
+  printBenchmarkReport();
+
+  int regressions = 0;
+  if (baselinePath) {
+    std::map<std::string, float> baseline;
+    if (!readBaseline(baselinePath, &baseline)) {
+      fprintf(stderr, "Could not read baseline %s\n", baselinePath);
+      return 2;
+    }
+
+    printf("\nAgainst baseline %s (tolerance %.0f%%):\n", baselinePath, tolerance);
+    for (int i = 0; i < benchResultCount; i++) {
+      const BenchResult& r = benchResults[i];
+      auto it = baseline.find(r.name);
+      if (it == baseline.end()) {
+        printf("  %-24s %11.1f ns   (new)\n", r.name, r.nsPerCall);
+        continue;
+      }
+      float change = it->second > 0 ? 100.0F * (r.nsPerCall - it->second) / it->second : 0;
+      bool regressed = change > tolerance;
+      if (regressed) regressions++;
+      printf("  %-24s %11.1f ns   baseline %11.1f ns   %+7.1f%%%s\n", r.name, r.nsPerCall, it->second, change,
+             regressed ? "   REGRESSION" : "");
+    }
+  }
+
+  if (writePath && !writeBaseline(writePath)) {
+    fprintf(stderr, "Could not write baseline %s\n", writePath);
+    return 2;
+  }
+
+  return regressions ? 1 : 0;
+}
@@ -0,0 +1,240 @@
+/*
+ * glove_cascade.cpp - Train the first stage of the cascade classifier on recorded captures
+ *
+ * Computes, for each gesture label, the centroid of the mean finger bends
+ * over WINDOW_SIZE samples - the feature the first stage of cascade.h
+ * classifies on - from every window of its captures that starts after the
+ * pose has settled. The captures are then classified window by window, from
+ * their first full window on, with the CASCADE_MAX_DISTANCE and
+ * CASCADE_MIN_MARGIN thresholds of config.h and a sweep of other margins:
+ *   fast path   windows the first stage answers
+ *   errors      answers that differ from the capture's label
+ * so the thresholds can be set for no errors with as many answers as the
+ * data allows. --write stores the centroids as cascade_model.h.
+ *
+ * The captures are read with sessionFrames() (csv_session.h), so the
+ * centroids are those of the bends the sketch computes: flex readings go
+ * through its bend table, clamped to 0..100 %, and binary telemetry
+ * captures (.bin) through its filter chains. The captures in recordings/
+ * were made through calibrated_data_collection.ino (host/glove_collect).
+ *
+ * Usage: glove_cascade [--rate HZ] [--write FILE] file.bin|file.csv...
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "csv_session.h"
+#include "telemetry_decoder.h"
+
+// Samples at the start of a capture, while the hand moves into the pose, left out of the centroids
+static const size_t SETTLE_SAMPLES = 50;
+
+// Margins of the sweep, bend %
+static const float SWEEP_MARGINS[] = {0, 10, 20, 30, 40, 60, 80};
+
+// Mean finger bends of one window
+struct PoseWindow {
+  float bend[5];
+  int label;        // Index into the trained labels
+  bool settled;     // Starts after SETTLE_SAMPLES
+};
+
+// Trained centroid of a label
+struct Centroid {
+  std::string label;
+  double bend[5] = {};
+  unsigned long windows = 0;
+  double spread = 0;   // RMS distance of its windows from it
+};
+
+/**
+ * @brief Append the sliding-window mean bends of a capture, as the sketch computes them
+ */
+static void appendWindows(const CsvSession& session, int label, std::vector<PoseWindow>* windows) {
+  std::vector<std::vector<float>> frames = sessionFrames(session);
+  size_t length = frames.size();
+  for (size_t start = 0; start + WINDOW_SIZE <= length; start++) {
+    PoseWindow window;
+    for (int finger = 0; finger < 5; finger++) {
+      double sum = 0;
+      for (size_t n = start; n < start + WINDOW_SIZE; n++) sum += frames[n][finger];
+      window.bend[finger] = (float)(sum / WINDOW_SIZE);
+    }
+    window.label = label;
+    window.settled = start >= SETTLE_SAMPLES;
+    windows->push_back(window);
+  }
+}
+
+static double distance(const float* bend, const double* centroid) {
+  double d2 = 0;
+  for (int finger = 0; finger < 5; finger++) {
+    double d = bend[finger] - centroid[finger];
+    d2 += d * d;
+  }
+  return sqrt(d2);
+}
+
+/**
+ * @brief The first stage's rule: the nearest centroid, or -1 if it is too far or the second is too close
+ */
+static int classifyWindow(const PoseWindow& window, const std::vector<Centroid>& centroids, double maxDistance,
+                          double minMargin) {
+  int nearest = -1;
+  double d1 = INFINITY, d2 = INFINITY;
+  for (size_t i = 0; i < centroids.size(); i++) {
+    double d = distance(window.bend, centroids[i].bend);
+    if (d < d1) {
+      d2 = d1;
+      d1 = d;
+      nearest = (int)i;
+    } else if (d < d2) {
+      d2 = d;
+    }
+  }
+  return (d1 <= maxDistance && d2 - d1 >= minMargin) ? nearest : -1;
+}
+
+static void printEvaluation(const char* name, const std::vector<PoseWindow>& windows,
+                            const std::vector<Centroid>& centroids, double maxDistance, double minMargin) {
+  unsigned long answered = 0, errors = 0;
+  for (const PoseWindow& window : windows) {
+    int label = classifyWindow(window, centroids, maxDistance, minMargin);
+    if (label < 0) continue;
+    answered++;
+    if (label != window.label) errors++;
+  }
+  printf("  %-10s %8.0f %8.0f %9.1f%% %8lu\n", name, maxDistance, minMargin,
+         windows.empty() ? 0 : 100.0 * answered / windows.size(), errors);
+}
+
+static bool writeModel(const char* path, const std::vector<Centroid>& centroids, size_t files) {
+  FILE* file = fopen(path, "w");
+  if (!file) return false;
+
+  fprintf(file, "/*\n");
+  fprintf(file, " * cascade_model.h - Cascade First-Stage Centroids\n");
+  fprintf(file, " *\n");
+  fprintf(file, " * Generated by host/glove_cascade from %zu captures (window %d samples) - do\n", files, WINDOW_SIZE);
+  fprintf(file, " * not edit. Mean bend (%%) of each finger, thumb to pinky, of each gesture.\n");
+  fprintf(file, " */\n\n");
+  fprintf(file, "#ifndef CASCADE_MODEL_H\n#define CASCADE_MODEL_H\n\n");
+  fprintf(file, "const CascadeCentroid CASCADE_CENTROIDS[] = {\n");
+  for (const Centroid& centroid : centroids) {
+    fprintf(file, "  {\"%s\", {%.2fF, %.2fF, %.2fF, %.2fF, %.2fF}},\n", centroid.label.c_str(), centroid.bend[0],
+            centroid.bend[1], centroid.bend[2], centroid.bend[3], centroid.bend[4]);
+  }
+  fprintf(file, "};\n\n");
+  fprintf(file, "#define CASCADE_CENTROID_COUNT ((int)(sizeof(CASCADE_CENTROIDS) / sizeof(CASCADE_CENTROIDS[0])))\n\n");
+  fprintf(file, "#endif // CASCADE_MODEL_H\n");
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned long periodMs = SAMPLING_INTERVAL_MS;
+  const char* writePath = nullptr;
+  std::vector<const char*> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+      periodMs = 1000 / strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+      writePath = argv[++i];
+    } else if (argv[i][0] == '-') {
+      files.clear();
+      break;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+
+  if (files.empty()) {
+    fprintf(stderr, "Usage: %s [--rate HZ] [--write FILE] file.bin|file.csv...\n", argv[0]);
+    return 2;
+  }
+
+  // Labels in order of first appearance
+  std::vector<Centroid> centroids;
+  std::map<std::string, int> labelIndex;
+  std::vector<PoseWindow> windows;
+  for (const char* path : files) {
+    CsvSession session;
+    size_t length = strlen(path);
+    bool loaded = (length > 4 && strcmp(path + length - 4, ".bin") == 0) ? loadTelemetrySession(path, &session)
+                                                                        : loadCsvSession(path, periodMs, &session);
+    if (!loaded) {
+      fprintf(stderr, "%s: could not be loaded\n", path);
+      return 1;
+    }
+    if (session.label.empty()) {
+      fprintf(stderr, "%s: no gesture label in the file name\n", path);
+      return 1;
+    }
+    if (labelIndex.find(session.label) == labelIndex.end()) {
+      labelIndex[session.label] = (int)centroids.size();
+      centroids.push_back(Centroid());
+      centroids.back().label = session.label;
+    }
+    appendWindows(session, labelIndex[session.label], &windows);
+  }
+
+  // Centroids and spread of the settled windows
+  for (const PoseWindow& window : windows) {
+    if (!window.settled) continue;
+    Centroid& centroid = centroids[window.label];
+    for (int finger = 0; finger < 5; finger++) centroid.bend[finger] += window.bend[finger];
+    centroid.windows++;
+  }
+  for (Centroid& centroid : centroids) {
+    if (centroid.windows == 0) {
+      fprintf(stderr, "%s: no capture is longer than %zu samples\n", centroid.label.c_str(),
+              SETTLE_SAMPLES + WINDOW_SIZE);
+      return 1;
+    }
+    for (int finger = 0; finger < 5; finger++) centroid.bend[finger] /= centroid.windows;
+  }
+  for (const PoseWindow& window : windows) {
+    if (window.settled) centroids[window.label].spread += pow(distance(window.bend, centroids[window.label].bend), 2);
+  }
+
+  printf("%zu captures, %zu windows of %d samples\n\n", files.size(), windows.size(), WINDOW_SIZE);
+  printf("  %-10s %30s %9s %12s\n", "label", "mean bend (%) thumb..pinky", "spread", "nearest");
+  for (const Centroid& centroid : centroids) {
+    double nearest = INFINITY;
+    const char* nearestLabel = "-";
+    for (const Centroid& other : centroids) {
+      if (&other == &centroid) continue;
+      float bend[5];
+      for (int finger = 0; finger < 5; finger++) bend[finger] = (float)other.bend[finger];
+      double d = distance(bend, centroid.bend);
+      if (d < nearest) {
+        nearest = d;
+        nearestLabel = other.label.c_str();
+      }
+    }
+    printf("  %-10s %6.1f %5.1f %5.1f %5.1f %5.1f %9.1f %6.1f %-6s\n", centroid.label.c_str(), centroid.bend[0],
+           centroid.bend[1], centroid.bend[2], centroid.bend[3], centroid.bend[4],
+           sqrt(centroid.spread / centroid.windows), nearest, nearestLabel);
+  }
+
+  printf("\n  %-10s %8s %8s %10s %8s\n", "", "distance", "margin", "fast path", "errors");
+  printEvaluation("config.h", windows, centroids, CASCADE_MAX_DISTANCE, CASCADE_MIN_MARGIN);
+  for (float margin : SWEEP_MARGINS) {
+    printEvaluation("", windows, centroids, CASCADE_MAX_DISTANCE, margin);
+  }
+
+  if (writePath) {
+    if (!writeModel(writePath, centroids, files.size())) {
+      fprintf(stderr, "Could not write %s\n", writePath);
+      return 1;
+    }
+    printf("\nCentroids written to %s\n", writePath);
+  }
+  return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * glove_collect.cpp - Host-native build of the data collection sketch
+ *
+ * Builds calibrated_data_collection.ino against the HAL shim and runs it on
+ * the virtual clock while scripted flex sensors and IMU sweep smoothly
+ * through their ranges. Everything the sketch sends over serial is written
+ * to the output file, so text (CSV) and binary telemetry captures can be
+ * produced and checked with glove_decode without hardware. The summary
+ * reports the serial bandwidth the stream needs.
+ *
+ * --pose LABEL holds one of the gesture poses instead: the hand moves from
+ * rest into the pose when the stream starts and holds it with tremor and
+ * ADC noise, the finger positions and hand orientation varying with
+ * --seed. Only the stream is written, so the output is a capture as the
+ * sketch records it - clamped to 0..100 % and filtered - ready for the
+ * host tools. recordings/ holds three such captures of every pose.
+ *
+ * glove_collect_binary is the same run built with USE_BINARY_TELEMETRY.
+ *
+ * Usage: glove_collect [--seconds N] [--step-us N] [--pose LABEL [--seed N]] --output FILE
+ */
+
+#include <Arduino.h>
+#include <Arduino_LSM9DS1.h>
+#include <random>
+
+#include "calibrated_data_collection.ino"
+
+// Finger positions of a gesture pose, thumb..pinky (1 = bent)
+struct ScriptedPose {
+  const char* label;
+  bool bent[5];
+};
+
+static const ScriptedPose SCRIPTED_POSES[] = {
+  {"five",  {false, false, false, false, false}},
+  {"four",  {true,  false, false, false, false}},
+  {"love",  {false, true,  true,  true,  false}},
+  {"one",   {true,  false, true,  true,  true}},
+  {"three", {false, false, false, true,  true}},
+  {"two",   {true,  false, false, true,  true}},
+};
+
+// Pose being held, and its variation for this capture
+static const ScriptedPose* scriptedPose = nullptr;
+static unsigned long long poseStartUs = 0;
+static float poseBend[5];           // Held bend of each finger (%)
+static float poseTremorHz[5];       // Frequency of each finger's tremor
+static float poseTilt[3];           // Gravity direction in the sensor frame (g)
+static std::mt19937 poseNoise;
+
+static const float POSE_REST_BEND = 40;       // Bend of the relaxed hand before the pose (%)
+static const float POSE_MOVE_US = 600000;     // Time to move from rest into the pose
+
+/**
+ * @brief Vary the pose for one capture - each pose and seed gives other finger positions
+ */
+static void initScriptedPose(unsigned long seed) {
+  seed = seed * 64 + (scriptedPose - SCRIPTED_POSES);
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> straight(2, 10), bent(84, 96), tremor(6, 10), tilt(-0.15F, 0.15F);
+  for (int finger = 0; finger < 5; finger++) {
+    poseBend[finger] = scriptedPose->bent[finger] ? bent(rng) : straight(rng);
+    poseTremorHz[finger] = tremor(rng);
+  }
+  poseTilt[0] = tilt(rng);
+  poseTilt[1] = tilt(rng);
+  poseTilt[2] = sqrtf(1 - poseTilt[0] * poseTilt[0] - poseTilt[1] * poseTilt[1]);
+  poseNoise.seed(seed * 7919 + 1);
+}
+
+/**
+ * @brief Scripted flex sensors holding the pose - the hand at rest until the stream starts, then
+ *        moving into the pose, with tremor and about 1 LSB of noise
+ */
+static int scriptedPoseAdc(int pin, unsigned long timeUs) {
+  const int pins[5] = {FLEX_PIN_THUMB, FLEX_PIN_INDEX, FLEX_PIN_MIDDLE, FLEX_PIN_RING, FLEX_PIN_PINKY};
+  std::normal_distribution<float> noise(0, 1);
+  for (int finger = 0; finger < 5; finger++) {
+    if (pins[finger] != pin) continue;
+    float t = (timeUs > poseStartUs) ? (timeUs - poseStartUs) / POSE_MOVE_US : 0;
+    float move = (t >= 1) ? 1 : 0.5F - 0.5F * cosf(PI * t);
+    float bend = POSE_REST_BEND + (poseBend[finger] - POSE_REST_BEND) * move;
+    bend += 0.8F * sinf(2 * PI * poseTremorHz[finger] * timeUs / 1e6F);
+    float adc = FLEX_STRAIGHT_ADC[finger] + (FLEX_BENT_ADC[finger] - FLEX_STRAIGHT_ADC[finger]) * bend / 100;
+    return (int)lroundf(adc + noise(poseNoise));
+  }
+  return 0;
+}
+
+/**
+ * @brief Scripted IMU holding the pose - the tilted hand still but for sensor noise and tremor
+ */
+static bool scriptedPoseImu(unsigned long timeUs, float* accel, float* gyro) {
+  std::normal_distribution<float> accelNoise(0, 0.004F), gyroNoise(0, 0.8F);
+  float t = timeUs / 1e6F;
+  for (int i = 0; i < 3; i++) {
+    float a = poseTilt[i] + accelNoise(poseNoise);
+    float g = 1.5F * sinf(2 * PI * (7 + i) * t + i) + gyroNoise(poseNoise);
+    accel[i] = roundf(a * TELEMETRY_ACCEL_LSB_PER_G) / TELEMETRY_ACCEL_LSB_PER_G;
+    gyro[i] = roundf(g * TELEMETRY_GYRO_LSB_PER_DPS) / TELEMETRY_GYRO_LSB_PER_DPS;
+  }
+  return true;
+}
+
+/**
+ * @brief Scripted flex sensors - each finger bends and straightens at its own pace, with +/-2 LSB of noise
+ */
+static int scriptedAdc(int pin, unsigned long timeUs) {
+  const int pins[5] = {FLEX_PIN_THUMB, FLEX_PIN_INDEX, FLEX_PIN_MIDDLE, FLEX_PIN_RING, FLEX_PIN_PINKY};
+  for (int finger = 0; finger < 5; finger++) {
+    if (pins[finger] == pin) {
+      float bend = 0.5F - 0.5F * cosf(timeUs / 1e6F * (0.7F + 0.3F * finger));
+      int adc = FLEX_STRAIGHT_ADC[finger] + (int)((FLEX_BENT_ADC[finger] - FLEX_STRAIGHT_ADC[finger]) * bend);
+      return adc + (rand() % 5) - 2;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Scripted IMU - a slowly rotating hand, quantized to the LSM9DS1 resolution
+ */
+static bool scriptedImu(unsigned long timeUs, float* accel, float* gyro) {
+  float t = timeUs / 1e6F;
+  float a[3] = {sinf(t), cosf(t) * 0.5F, 0.8F + 0.2F * sinf(2 * t)};
+  float g[3] = {120 * cosf(t), -80 * sinf(1.5F * t), 30 * sinf(3 * t)};
+  for (int i = 0; i < 3; i++) {
+    accel[i] = roundf(a[i] * TELEMETRY_ACCEL_LSB_PER_G) / TELEMETRY_ACCEL_LSB_PER_G;
+    gyro[i] = roundf(g[i] * TELEMETRY_GYRO_LSB_PER_DPS) / TELEMETRY_GYRO_LSB_PER_DPS;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned long seconds = 10;
+  unsigned long stepUs = 100;
+  const char* outputPath = nullptr;
+  const char* poseLabel = nullptr;
+  unsigned long seed = 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      seconds = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--step-us") == 0 && i + 1 < argc) {
+      stepUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--pose") == 0 && i + 1 < argc) {
+      poseLabel = argv[++i];
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+      outputPath = argv[++i];
+    } else {
+      outputPath = nullptr;
+      break;
+    }
+  }
+  if (!outputPath) {
+    fprintf(stderr, "Usage: %s [--seconds N] [--step-us N] [--pose LABEL [--seed N]] --output FILE\n", argv[0]);
+    return 2;
+  }
+  if (poseLabel) {
+    for (const ScriptedPose& pose : SCRIPTED_POSES) {
+      if (strcmp(pose.label, poseLabel) == 0) scriptedPose = &pose;
+    }
+    if (!scriptedPose) {
+      fprintf(stderr, "unknown pose %s\n", poseLabel);
+      return 2;
+    }
+    initScriptedPose(seed);
+  }
+
+  FILE* output = fopen(outputPath, "wb");
+  if (!output) {
+    fprintf(stderr, "cannot create %s\n", outputPath);
+    return 1;
+  }
+
+  hostReset();
+  hostAdcScript = scriptedPose ? scriptedPoseAdc : scriptedAdc;
+  IMU.script = scriptedPose ? scriptedPoseImu : scriptedImu;
+  Serial.echo = false;
+  Serial.capture = true;
+
+  // setup() takes the readings of the hand at rest; a pose capture keeps only the stream after it
+  poseStartUs = ~0ULL;
+  setup();
+  std::string text = Serial.hostTakeOutput();
+  if (!scriptedPose) fwrite(text.data(), 1, text.size(), output);
+  poseStartUs = hostTimeUs;
+
+  // Stream for the requested time, counting only the bytes sent after setup()
+  unsigned long long startUs = hostTimeUs;
+  unsigned long long endUs = startUs + (unsigned long long)seconds * 1000000ULL;
+  size_t streamBytes = 0;
+  while (hostTimeUs < endUs) {
+    loop();
+    std::string data = Serial.hostTakeOutput();
+    fwrite(data.data(), 1, data.size(), output);
+    streamBytes += data.size();
+    hostAdvanceUs(stepUs);
+  }
+  fclose(output);
+
+  double streamSeconds = (hostTimeUs - startUs) / 1e6;
+  fprintf(stderr, "%s: %lu analogRead calls, %zu bytes streamed in %.3f s (%.0f bytes/s at %d Hz)\n",
+          outputPath, hostAnalogReadCount, streamBytes, streamSeconds,
+          streamBytes / streamSeconds, FREQUENCY_HZ);
+  return 0;
+}
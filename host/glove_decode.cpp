@@ -0,0 +1,112 @@
+/*
+ * glove_decode.cpp - Convert binary telemetry captures to Edge Impulse CSV
+ *
+ * Decodes a capture of calibrated_data_collection.ino built with
+ * USE_BINARY_TELEMETRY (the raw serial stream, "-" for stdin) and writes
+ * the 11 CSV columns the sketch prints in text mode: filtered bend (%) of
+ * each finger, acceleration (g) and angular rate (dps). Calibration and
+ * filter coefficient come from the info frames of the capture.
+ *
+ * --timestamps adds a header and a timestamp column in milliseconds, as
+ * expected by the Edge Impulse CSV uploader and accepted by glove_replay.
+ * --raw writes the raw ADC and IMU register values instead.
+ *
+ * Usage: glove_decode [--timestamps] [--raw] [--output FILE] capture.bin
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "telemetry_decoder.h"
+
+int main(int argc, char** argv) {
+  bool timestamps = false;
+  bool raw = false;
+  const char* inputPath = nullptr;
+  const char* outputPath = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--timestamps") == 0) {
+      timestamps = true;
+    } else if (strcmp(argv[i], "--raw") == 0) {
+      raw = true;
+    } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+      outputPath = argv[++i];
+    } else if (!inputPath && (argv[i][0] != '-' || strcmp(argv[i], "-") == 0)) {
+      inputPath = argv[i];
+    } else {
+      inputPath = nullptr;
+      break;
+    }
+  }
+  if (!inputPath) {
+    fprintf(stderr, "Usage: %s [--timestamps] [--raw] [--output FILE] capture.bin\n", argv[0]);
+    return 2;
+  }
+
+  FILE* input = strcmp(inputPath, "-") == 0 ? stdin : fopen(inputPath, "rb");
+  if (!input) {
+    fprintf(stderr, "cannot open %s\n", inputPath);
+    return 1;
+  }
+
+  // Decode the whole capture, keeping the bytes read for the summary
+  TelemetryDecoder decoder;
+  std::vector<TelemetrySample> samples;
+  uint8_t buffer[4096];
+  size_t bytes = 0, length;
+  while ((length = fread(buffer, 1, sizeof(buffer), input)) > 0) {
+    feedTelemetry(&decoder, buffer, length, &samples);
+    bytes += length;
+  }
+  if (input != stdin) fclose(input);
+
+  if (samples.empty()) {
+    fprintf(stderr, "%s: no telemetry samples\n", inputPath);
+    return 1;
+  }
+  if (!raw && !decoder.haveInfo) {
+    fprintf(stderr, "%s: no info frame - calibration unknown, use --raw\n", inputPath);
+    return 1;
+  }
+
+  FILE* output = outputPath ? fopen(outputPath, "w") : stdout;
+  if (!output) {
+    fprintf(stderr, "cannot create %s\n", outputPath);
+    return 1;
+  }
+
+  if (timestamps) {
+    fprintf(output, "timestamp,thumb,index,middle,ring,pinky,accX,accY,accZ,gyrX,gyrY,gyrZ\n");
+  }
+
+  TelemetryFilter filter;
+  uint32_t startUs = samples[0].timeUs;
+  for (const TelemetrySample& sample : samples) {
+    if (timestamps) fprintf(output, "%lu,", (unsigned long)((sample.timeUs - startUs) / 1000));
+
+    if (raw) {
+      for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+        fprintf(output, i ? ",%d" : "%d", sample.values[i]);
+      }
+    } else {
+      float values[TELEMETRY_CHANNELS];
+      telemetryToCsvValues(decoder.info, sample, &filter, values);
+      for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+        fprintf(output, i ? ",%.2f" : "%.2f", values[i]);
+      }
+    }
+    fprintf(output, "\n");
+  }
+  if (output != stdout) fclose(output);
+
+  double seconds = (samples.back().timeUs - startUs) / 1e6;
+  fprintf(stderr, "%s: %lu samples in %.3f s", inputPath, decoder.samples, seconds);
+  if (decoder.haveInfo) fprintf(stderr, " (%u Hz)", decoder.info.sampleRateHz);
+  fprintf(stderr, ", %.1f bytes per sample\n", (double)bytes / decoder.samples);
+  fprintf(stderr, "  frames %lu, lost %lu, CRC errors %lu, undecodable deltas %lu, bytes skipped %lu\n",
+          decoder.frames, decoder.lostFrames, decoder.crcErrors, decoder.droppedDeltas, decoder.skippedBytes);
+  return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * glove_dtw.cpp - Pruning benchmark of the motion sign matcher on recorded captures
+ *
+ * Enrolls templates from the files after --enroll, played back to back as
+ * the sketch would see them: --templates windows of DTW_TEMPLATE_POINTS
+ * points cut with addDtwTemplate() like the 'enroll' command does, one
+ * centred on each change of capture - the only motion in recordings of
+ * static gestures - and the rest evenly spaced over the stream. Each is
+ * named after the capture it ends in, or "a>b" when it spans the change
+ * from capture a to capture b. Then the files
+ * after --stream are played back to back, and at every sample the templates
+ * are searched for the end of the stream with searchDtwTemplates(), as
+ * matchDtwTemplates() does but without its pause after a match. Two
+ * searches are reported, one under the match threshold (DTW_MATCH_THRESHOLD
+ * per point, or --threshold) as on the glove and one for the nearest
+ * template whatever its distance:
+ *   pruning    where the candidates were ruled out - LB_Kim, LB_Keogh
+ *              against the query envelope, LB_Keogh against the template
+ *              envelope, DTW abandoned early - and where the DTW was
+ *              completed, with the DTW cells computed against the cells of
+ *              the full banded DTW of every template
+ *   time       per search, against the full DTW of every template, and
+ *              searches whose nearest distance differs from it (there should
+ *              be none - the bounds never reject the nearest template)
+ *   matches    samples with a template under the threshold, and how many
+ *              are named after what the query covers
+ *
+ * The captures are read with sessionFrames() (csv_session.h): flex readings
+ * go through the sketch's bend table, and binary telemetry captures (.bin),
+ * which hold unfiltered readings, through the FLEX_FILTER and IMU_FILTER
+ * chains of config.h.
+ *
+ * Usage: glove_dtw [--rate HZ] [--templates N] [--threshold PER_POINT] --enroll file... --stream file...
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "dtw.h"
+#include "csv_session.h"
+#include "telemetry_decoder.h"
+
+// Filtered channel values of a capture, as the sketch sees them
+struct Capture {
+  std::vector<std::vector<float>> frames;
+  std::string label;
+};
+
+// One way of searching the stream
+struct SearchRun {
+  const char* name;
+  int32_t bound;
+  DtwSearchStats stats;
+  double searchNs, bruteNs;
+  unsigned long differences, matches, namedMatches;
+};
+
+static bool loadCaptures(const std::vector<const char*>& files, unsigned long periodMs,
+                         std::vector<Capture>* captures) {
+  for (const char* path : files) {
+    CsvSession session;
+    size_t length = strlen(path);
+    bool loaded = (length > 4 && strcmp(path + length - 4, ".bin") == 0)
+                    ? loadTelemetrySession(path, &session)
+                    : loadCsvSession(path, periodMs, &session);
+    if (!loaded || session.samples.empty()) {
+      fprintf(stderr, "%s: could not be loaded\n", path);
+      return false;
+    }
+    Capture capture;
+    capture.frames = sessionFrames(session);
+    capture.label = session.label;
+    captures->push_back(capture);
+  }
+  return true;
+}
+
+// Playback of captures back to back, sample by sample
+struct Playback {
+  const std::vector<Capture>* captures;
+  size_t capture, frame;
+  size_t lastChange;      // Samples played when the capture playing began
+  size_t played;
+  std::string previous;   // Label of the capture before it
+};
+
+/**
+ * @brief Push the next sample of the playback to the matcher
+ * @return Whether there was one
+ */
+static bool playNext(Playback* playback) {
+  while (playback->capture < playback->captures->size() &&
+         playback->frame >= (*playback->captures)[playback->capture].frames.size()) {
+    playback->previous = (*playback->captures)[playback->capture].label;
+    playback->capture++;
+    playback->frame = 0;
+    playback->lastChange = playback->played;
+  }
+  if (playback->capture >= playback->captures->size()) return false;
+
+  float values[SENSOR_CHANNEL_COUNT];
+  const float* pointers[SENSOR_CHANNEL_COUNT];
+  memcpy(values, (*playback->captures)[playback->capture].frames[playback->frame].data(), sizeof(values));
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) pointers[ch] = &values[ch];
+  pushDtwSample(pointers);
+  playback->frame++;
+  playback->played++;
+  return true;
+}
+
+/**
+ * @brief What the history covers: the capture playing, or "a>b" when it reaches back into the capture before
+ */
+static std::string historyName(const Playback& playback) {
+  const std::string& label = (*playback.captures)[playback.capture].label;
+  bool spansChange = playback.lastChange > 0 && playback.played - playback.lastChange < DTW_HISTORY_SAMPLES;
+  return spansChange && playback.previous != label ? playback.previous + ">" + label : label;
+}
+
+static void printShare(const char* name, uint64_t count, uint64_t total) {
+  printf("  %-40s %10llu  %5.1f%%\n", name, (unsigned long long)count, total ? 100.0 * count / total : 0);
+}
+
+static void printRun(const SearchRun& run, unsigned long searches) {
+  const DtwSearchStats& stats = run.stats;
+  uint64_t fullCells = 0;
+  for (int i = 0; i < DTW_TEMPLATE_POINTS; i++) {
+    fullCells += min(i + DTW_BAND, DTW_TEMPLATE_POINTS - 1) - max(i - DTW_BAND, 0) + 1;
+  }
+  fullCells *= stats.compared;
+
+  printf("\n--- %s ---\n", run.name);
+  printf("templates compared %lu (%.1f per search)\n", (unsigned long)stats.compared,
+         searches ? (double)stats.compared / searches : 0);
+  printShare("pruned by LB_Kim", stats.prunedKim, stats.compared);
+  printShare("pruned by LB_Keogh (query envelope)", stats.prunedKeoghQuery, stats.compared);
+  printShare("pruned by LB_Keogh (template envelope)", stats.prunedKeoghTemplate, stats.compared);
+  printShare("DTW abandoned early", stats.abandoned, stats.compared);
+  printShare("DTW completed", stats.completed, stats.compared);
+  printf("DTW cells          %llu, %.1f%% of the full DTW of every template\n", (unsigned long long)stats.cells,
+         fullCells ? 100.0 * stats.cells / fullCells : 0);
+  printf("time per search    %.0f ns, full DTW of every template %.0f ns, %.1fx\n", run.searchNs / searches,
+         run.bruteNs / searches, run.searchNs > 0 ? run.bruteNs / run.searchNs : 0);
+  printf("differences        %lu searches with another nearest distance than the full DTW\n", run.differences);
+  if (run.bound != INT32_MAX) {
+    printf("matches            %lu samples under the threshold, %lu (%.1f%%) named after what the query covers\n",
+           run.matches, run.namedMatches, run.matches ? 100.0 * run.namedMatches / run.matches : 0);
+  }
+}
+
+int main(int argc, char** argv) {
+  typedef std::chrono::steady_clock Clock;
+  unsigned long periodMs = SAMPLING_INTERVAL_MS;
+  int templateCount = DTW_MAX_TEMPLATES;
+  float threshold = DTW_MATCH_THRESHOLD;
+  std::vector<const char*> enrollFiles, streamFiles;
+  std::vector<const char*>* files = nullptr;
+  bool usage = false;
+
+  for (int i = 1; i < argc && !usage; i++) {
+    if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+      periodMs = 1000 / strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--templates") == 0 && i + 1 < argc) {
+      templateCount = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+      threshold = strtof(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--enroll") == 0) {
+      files = &enrollFiles;
+    } else if (strcmp(argv[i], "--stream") == 0) {
+      files = &streamFiles;
+    } else if (argv[i][0] == '-' || !files) {
+      usage = true;
+    } else {
+      files->push_back(argv[i]);
+    }
+  }
+
+  if (usage || enrollFiles.empty() || streamFiles.empty() || templateCount < 1) {
+    fprintf(stderr, "Usage: %s [--rate HZ] [--templates N] [--threshold PER_POINT] --enroll file... --stream file...\n",
+            argv[0]);
+    return 2;
+  }
+
+  std::vector<Capture> enrollCaptures, streamCaptures;
+  if (!loadCaptures(enrollFiles, periodMs, &enrollCaptures) || !loadCaptures(streamFiles, periodMs, &streamCaptures)) {
+    return 1;
+  }
+
+  // Where the templates end: half a template after each change of capture, then at even spacing once the
+  // history has filled
+  initDtwMatcher();
+  templateCount = min(templateCount, dtwCapacity());
+  std::vector<size_t> cuts;
+  size_t enrollSamples = 0;
+  for (const Capture& capture : enrollCaptures) {
+    if (enrollSamples > 0 && (int)cuts.size() < templateCount) cuts.push_back(enrollSamples + DTW_HISTORY_SAMPLES / 2);
+    enrollSamples += capture.frames.size();
+  }
+  if (enrollSamples < (size_t)DTW_HISTORY_SAMPLES) {
+    fprintf(stderr, "The enrollment files hold fewer than %d samples\n", DTW_HISTORY_SAMPLES);
+    return 1;
+  }
+  int spaced = templateCount - (int)cuts.size();
+  for (int k = 0; k < spaced; k++) {
+    double spacing = spaced > 1 ? (double)(enrollSamples - DTW_HISTORY_SAMPLES) / (spaced - 1) : 0;
+    cuts.push_back(DTW_HISTORY_SAMPLES + (size_t)lround(k * spacing));
+  }
+  std::sort(cuts.begin(), cuts.end());
+
+  Playback enroll = {&enrollCaptures, 0, 0, 0, 0, ""};
+  size_t nextCut = 0;
+  while (playNext(&enroll)) {
+    while (nextCut < cuts.size() && cuts[nextCut] <= enroll.played) {
+      if (cuts[nextCut++] == enroll.played) addDtwTemplate(historyName(enroll).c_str());
+    }
+  }
+
+  printf("%zu enrollment captures, %d templates of %d points (%d samples), band %d points\n", enrollCaptures.size(),
+         dtw.count, DTW_TEMPLATE_POINTS, DTW_HISTORY_SAMPLES, DTW_BAND);
+  for (int k = 0; k < dtw.count; k++) printf("%s%s", k ? " " : "  ", dtw.templates[k].name);
+  printf("\n");
+
+  SearchRun runs[2] = {
+    {"search under the match threshold", (int32_t)(threshold * DTW_TEMPLATE_POINTS), {}, 0, 0, 0, 0, 0},
+    {"nearest template search", INT32_MAX, {}, 0, 0, 0, 0, 0},
+  };
+
+  // The history starts out with the end of the enrollment stream, searched once it holds the stream alone
+  Playback stream = {&streamCaptures, 0, 0, 0, 0, ""};
+  unsigned long searches = 0;
+  int8_t query[DTW_TEMPLATE_POINTS][SENSOR_CHANNEL_COUNT];
+  while (playNext(&stream)) {
+    if (stream.played < (size_t)DTW_HISTORY_SAMPLES) continue;
+    buildDtwQuery(query);
+    std::string covered = historyName(stream);
+    searches++;
+
+    for (SearchRun& run : runs) {
+      int32_t distance;
+      Clock::time_point start = Clock::now();
+      int best = searchDtwTemplates(query, run.bound, &distance, &run.stats);
+      Clock::time_point searched = Clock::now();
+      int bruteBest = -1;
+      int32_t bruteDistance = run.bound;
+      for (int k = 0; k < dtw.count; k++) {
+        int32_t d = dtwDistance(query, dtw.templates[k].points, INT32_MAX, NULL, NULL);
+        if (d < bruteDistance) {
+          bruteDistance = d;
+          bruteBest = k;
+        }
+      }
+      Clock::time_point bruteForced = Clock::now();
+      run.searchNs += std::chrono::duration<double, std::nano>(searched - start).count();
+      run.bruteNs += std::chrono::duration<double, std::nano>(bruteForced - searched).count();
+
+      // Templates at the same distance may be found in another order
+      if ((best >= 0) != (bruteBest >= 0) || (best >= 0 && distance != bruteDistance)) run.differences++;
+      if (best >= 0) {
+        run.matches++;
+        if (covered == dtw.templates[best].name) run.namedMatches++;
+      }
+    }
+  }
+
+  printf("%zu stream captures, %lu searches (one per sample once the history is full)\n", streamCaptures.size(),
+         searches);
+  for (const SearchRun& run : runs) printRun(run, searches);
+  return 0;
+}
@@ -0,0 +1,259 @@
+/*
+ * glove_filters.cpp - Delay and noise reduction of filter chains on recorded captures
+ *
+ * Plays the captures back to back, as one continuous recording, through a
+ * set of candidate filter chains (filter_bank.h) for the flex and IMU
+ * channels, and reports for each chain:
+ *   step     time for the output to cover half of a 0 -> 100 step (ms)
+ *   lag      shift of the input that best matches the output around the
+ *            pose changes of the recording (ms), the delay recognition sees
+ *   noise    reduction of the sample-to-sample noise while a pose is held
+ *            (dB), from the residual of each sample against its neighbours
+ * so that delay can be traded against stability on real data.
+ *
+ * Binary telemetry captures (.bin) hold unfiltered readings; the flex ADC
+ * values are converted with the config.h calibration. CSV captures were
+ * low-pass filtered when they were recorded, so they understate the noise
+ * every chain removes.
+ *
+ * Usage: glove_filters [--rate HZ] file.bin|file.csv...
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "filter_bank.h"
+#include "csv_session.h"
+#include "telemetry_decoder.h"
+
+// Samples after a pose change that are left out of the noise measurement
+static const size_t SETTLE_SAMPLES = 50;
+
+// Samples around a pose change used to measure the lag, and the largest lag searched
+static const size_t LAG_BEFORE = 10, LAG_AFTER = 40;
+static const int MAX_LAG = 30;
+
+// Tunings of the candidate stages that are not in config.h
+struct Biquad3Hz { static constexpr float cutoffHz = 3.0F, q = 0.7071F; };
+struct Biquad5Hz { static constexpr float cutoffHz = 5.0F, q = 0.7071F; };
+struct Biquad8Hz { static constexpr float cutoffHz = 8.0F, q = 0.7071F; };
+// 4th-order Butterworth at 5 Hz as two sections
+struct Butterworth4LowQ { static constexpr float cutoffHz = 5.0F, q = 0.5412F; };
+struct Butterworth4HighQ { static constexpr float cutoffHz = 5.0F, q = 1.3066F; };
+struct ImuOneEuroTuning { static constexpr float minCutoffHz = 1.5F, beta = 0.005F, derivativeCutoffHz = 2.0F; };
+
+// Delay and noise reduction of one channel group through one chain
+struct GroupReport {
+  float stepMs;
+  float lagMs;
+  float noiseDb;
+};
+
+// Continuous recording, one vector per channel, and where each capture starts
+struct Recording {
+  std::vector<float> channels[CSV_CHANNEL_COUNT];
+  std::vector<size_t> boundaries;
+  size_t length = 0;
+};
+
+/**
+ * @brief Append a capture to the recording, flex readings as bend (%)
+ */
+static void appendSession(const CsvSession& session, Recording* recording) {
+  recording->boundaries.push_back(recording->length);
+  for (const CsvSample& sample : session.samples) {
+    for (int ch = 0; ch < CSV_CHANNEL_COUNT; ch++) {
+      float value = sample.values[ch];
+      if (session.raw && ch < 5) {
+        value = (value - FLEX_STRAIGHT_ADC[ch]) * 100.0F / (FLEX_BENT_ADC[ch] - FLEX_STRAIGHT_ADC[ch]);
+        value = constrain(value, 0.0F, 100.0F);
+      }
+      recording->channels[ch].push_back(value);
+    }
+  }
+  recording->length += session.samples.size();
+}
+
+/**
+ * @brief Time for a chain to cover half of a 0 -> 100 step on every channel
+ */
+template <class Chain, int N>
+static float stepDelayMs() {
+  Chain chain;
+  float x[N] = {};
+  chain.process(x);
+  float previous = 0;
+  for (int n = 0; n < 1000; n++) {
+    for (int i = 0; i < N; i++) x[i] = 100;
+    chain.process(x);
+    if (x[0] >= 50) {
+      // Interpolate the crossing between this sample and the previous one - the input, interpolated
+      // the same way, crosses half a sample before its first sample at 100
+      float fraction = (x[0] - 50) / (x[0] - previous);
+      return (n + 0.5F - fraction) * SAMPLING_INTERVAL_MS;
+    }
+    previous = x[0];
+  }
+  return -1;
+}
+
+/**
+ * @brief Filter channels [FIRST, FIRST + N) of the recording through a chain and measure it
+ */
+template <class Chain, int FIRST, int N>
+static GroupReport measureGroup(const Recording& recording) {
+  GroupReport report;
+  report.stepMs = stepDelayMs<Chain, N>();
+
+  // Filter the whole recording as the sketch would, sample by sample
+  std::vector<float> output[N];
+  Chain chain;
+  for (size_t n = 0; n < recording.length; n++) {
+    float x[N];
+    for (int i = 0; i < N; i++) x[i] = recording.channels[FIRST + i][n];
+    chain.process(x);
+    for (int i = 0; i < N; i++) output[i].push_back(x[i]);
+  }
+
+  // Noise: residual of each sample against the mean of its neighbours, away from the pose changes
+  double inputNoise = 0, outputNoise = 0;
+  size_t next = 0;
+  for (size_t n = 1; n + 1 < recording.length; n++) {
+    while (next < recording.boundaries.size() && recording.boundaries[next] <= n) next++;
+    size_t start = recording.boundaries[next - 1];
+    if (n < start + SETTLE_SAMPLES || (next < recording.boundaries.size() && n + 1 >= recording.boundaries[next])) {
+      continue;
+    }
+    for (int i = 0; i < N; i++) {
+      const std::vector<float>& in = recording.channels[FIRST + i];
+      double r = in[n] - (in[n - 1] + in[n + 1]) / 2;
+      inputNoise += r * r;
+      r = output[i][n] - (output[i][n - 1] + output[i][n + 1]) / 2;
+      outputNoise += r * r;
+    }
+  }
+  report.noiseDb = (inputNoise > 0 && outputNoise > 0) ? 10 * log10(inputNoise / outputNoise) : 0;
+
+  // Lag: input shift with the smallest squared difference from the output around the pose changes
+  double error[MAX_LAG + 1] = {};
+  for (size_t boundary : recording.boundaries) {
+    if (boundary < LAG_BEFORE + MAX_LAG || boundary + LAG_AFTER > recording.length) continue;
+    for (size_t n = boundary - LAG_BEFORE; n < boundary + LAG_AFTER; n++) {
+      for (int lag = 0; lag <= MAX_LAG; lag++) {
+        for (int i = 0; i < N; i++) {
+          double d = output[i][n] - recording.channels[FIRST + i][n - lag];
+          error[lag] += d * d;
+        }
+      }
+    }
+  }
+  int best = 0;
+  for (int lag = 1; lag <= MAX_LAG; lag++) {
+    if (error[lag] < error[best]) best = lag;
+  }
+  // Refine between samples with a parabola through the neighbouring errors
+  float offset = 0;
+  if (best > 0 && best < MAX_LAG) {
+    double curvature = error[best - 1] - 2 * error[best] + error[best + 1];
+    if (curvature > 0) offset = (float)(0.5 * (error[best - 1] - error[best + 1]) / curvature);
+  }
+  report.lagMs = (best + offset) * SAMPLING_INTERVAL_MS;
+  return report;
+}
+
+typedef GroupReport (*GroupMeasure)(const Recording& recording);
+
+// A candidate filter configuration - flex and IMU chains
+struct FilterCandidate {
+  const char* name;
+  GroupMeasure flex;
+  GroupMeasure imu;
+};
+
+static const FilterCandidate CANDIDATES[] = {
+  {"none",
+   measureGroup<FilterChain<>, 0, 5>,
+   measureGroup<FilterChain<>, 5, 6>},
+  {"low-pass (ALPHA)",
+   measureGroup<FilterChain<LowPassStage<5>>, 0, 5>,
+   measureGroup<FilterChain<LowPassStage<6>>, 5, 6>},
+  {"spike + low-pass",
+   measureGroup<FilterChain<SpikeRejectStage<5>, LowPassStage<5>>, 0, 5>,
+   measureGroup<FilterChain<SpikeRejectStage<6>, LowPassStage<6>>, 5, 6>},
+  {"biquad 3 Hz",
+   measureGroup<FilterChain<BiquadStage<5, Biquad3Hz>>, 0, 5>,
+   measureGroup<FilterChain<BiquadStage<6, Biquad3Hz>>, 5, 6>},
+  {"biquad 5 Hz",
+   measureGroup<FilterChain<BiquadStage<5, Biquad5Hz>>, 0, 5>,
+   measureGroup<FilterChain<BiquadStage<6, Biquad5Hz>>, 5, 6>},
+  {"biquad 8 Hz",
+   measureGroup<FilterChain<BiquadStage<5, Biquad8Hz>>, 0, 5>,
+   measureGroup<FilterChain<BiquadStage<6, Biquad8Hz>>, 5, 6>},
+  {"butterworth4 5 Hz",
+   measureGroup<FilterChain<BiquadStage<5, Butterworth4LowQ>, BiquadStage<5, Butterworth4HighQ>>, 0, 5>,
+   measureGroup<FilterChain<BiquadStage<6, Butterworth4LowQ>, BiquadStage<6, Butterworth4HighQ>>, 5, 6>},
+  {"spike + biquad 5 Hz",
+   measureGroup<FilterChain<SpikeRejectStage<5>, BiquadStage<5, Biquad5Hz>>, 0, 5>,
+   measureGroup<FilterChain<SpikeRejectStage<6>, BiquadStage<6, Biquad5Hz>>, 5, 6>},
+  {"one-euro",
+   measureGroup<FilterChain<OneEuroStage<5, FlexOneEuroTuning>>, 0, 5>,
+   measureGroup<FilterChain<OneEuroStage<6, ImuOneEuroTuning>>, 5, 6>},
+  {"spike + one-euro",
+   measureGroup<FilterChain<SpikeRejectStage<5>, OneEuroStage<5, FlexOneEuroTuning>>, 0, 5>,
+   measureGroup<FilterChain<SpikeRejectStage<6>, OneEuroStage<6, ImuOneEuroTuning>>, 5, 6>},
+  {"sketch (FLEX/IMU_FILTER)",
+   measureGroup<FLEX_FILTER, 0, 5>,
+   measureGroup<IMU_FILTER, 5, 6>},
+};
+
+int main(int argc, char** argv) {
+  unsigned long periodMs = SAMPLING_INTERVAL_MS;
+  std::vector<const char*> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+      periodMs = 1000 / strtoul(argv[++i], nullptr, 10);
+    } else if (argv[i][0] == '-') {
+      files.clear();
+      break;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+
+  if (files.empty()) {
+    fprintf(stderr, "Usage: %s [--rate HZ] file.bin|file.csv...\n", argv[0]);
+    return 2;
+  }
+
+  Recording recording;
+  unsigned long rawFiles = 0;
+  for (const char* path : files) {
+    CsvSession session;
+    size_t length = strlen(path);
+    bool loaded = (length > 4 && strcmp(path + length - 4, ".bin") == 0) ? loadTelemetrySession(path, &session)
+                                                                        : loadCsvSession(path, periodMs, &session);
+    if (!loaded) {
+      fprintf(stderr, "%s: could not be loaded\n", path);
+      return 1;
+    }
+    if (session.raw) rawFiles++;
+    appendSession(session, &recording);
+  }
+
+  printf("%zu captures (%lu raw), %zu samples at %d ms, %zu pose changes\n", files.size(), rawFiles,
+         recording.length, SAMPLING_INTERVAL_MS, recording.boundaries.size() - 1);
+  if (rawFiles < files.size()) printf("CSV captures are pre-filtered - their noise reduction is understated\n");
+  printf("\n%-26s %28s   %20s\n", "", "flex", "imu");
+  printf("%-26s %9s %9s %9s   %9s %9s\n", "chain", "step(ms)", "lag(ms)", "noise(dB)", "step(ms)", "noise(dB)");
+  for (const FilterCandidate& candidate : CANDIDATES) {
+    GroupReport flex = candidate.flex(recording);
+    GroupReport imu = candidate.imu(recording);
+    printf("%-26s %9.1f %9.1f %9.1f   %9.1f %9.1f\n", candidate.name, flex.stepMs, flex.lagMs, flex.noiseDb,
+           imu.stepMs, imu.noiseDb);
+  }
+  return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * glove_host.cpp - Host-native build of the v0.2 recognition sketch
+ *
+ * Builds Sign_Language_Recognition_Split_EN_v0.2 unchanged against the HAL
+ * shim in shim/ and runs setup()/loop() on the virtual clock. A scripted ADC
+ * cycles the glove through the supported poses so the whole pipeline
+ * (sampling, statistics, inference, LCD and serial output) is exercised.
+ *
+ * Every heap allocation is counted, and --check-allocations fails the run if
+ * any loop() call allocated - the sketch must run without touching the heap.
+ *
+ * --type text is typed into the serial port while the sketch runs, in
+ * fragments of 1-3 bytes at random gaps of up to twice --type-ms, so command
+ * lines arrive split across many polls ("\n", "\r" and "\\" escapes are
+ * decoded; a line left without ending exercises the parser timeout).
+ * --check-schedule fails the run if the sampling task ever missed a release
+ * or started more than SCHEDULE_JITTER_LIMIT_US late.
+ *
+ * --flash FILE backs the emulated internal flash with a file, so a
+ * calibration saved by the 'calibrate' command is loaded by the next run.
+ *
+ * Usage: glove_host [--seconds N] [--pose-ms N] [--step-us N] [--command TEXT]... [--type TEXT]...
+ *                   [--type-ms N] [--flash FILE] [--check-allocations] [--check-schedule] [--quiet]
+ */
+
+#include <Arduino.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Heap allocations of the whole process, counted by the replacement operator new
+static std::atomic<unsigned long> heapAllocations{0};
+
+void* operator new(size_t size) {
+  heapAllocations++;
+  if (void* p = malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+#include "Sign_Language_Recognition_Split_EN_v0.2.ino"
+
+// Mean bend (%) per finger {thumb, index, middle, ring, pinky} of each scripted pose
+static const char* const SCRIPT_POSE_NAMES[] = {"one", "two", "three", "four", "five", "love"};
+static const float SCRIPT_POSES[][5] = {
+  {100, 0, 100, 100, 100},
+  {100, 0, 0, 100, 100},
+  {0, 0, 0, 100, 100},
+  {100, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0},
+  {0, 100, 100, 100, 0}
+};
+static const int SCRIPT_POSE_COUNT = sizeof(SCRIPT_POSES) / sizeof(SCRIPT_POSES[0]);
+static unsigned long scriptPoseMs = 2000;
+
+/**
+ * @brief Scripted ADC - holds each pose for scriptPoseMs and adds +/-2 LSB of noise
+ */
+static int scriptedAdc(int pin, unsigned long timeUs) {
+  int pose = (timeUs / 1000 / scriptPoseMs) % SCRIPT_POSE_COUNT;
+  for (int finger = 0; finger < 5; finger++) {
+    if (FLEX_PINS[finger] == pin) {
+      float bend = SCRIPT_POSES[pose][finger] / 100.0F;
+      int adc = FLEX_STRAIGHT_ADC[finger] + (int)((FLEX_BENT_ADC[finger] - FLEX_STRAIGHT_ADC[finger]) * bend);
+      return adc + (rand() % 5) - 2;
+    }
+  }
+  return 0;
+}
+
+// Largest start delay of the sampling task accepted by --check-schedule
+#define SCHEDULE_JITTER_LIMIT_US (SAMPLING_INTERVAL_MS * 1000UL / 10)
+
+/**
+ * @brief Decode the \n, \r and \\ escapes of a --type argument
+ */
+static std::string decodeEscapes(const char* text) {
+  std::string decoded;
+  for (const char* p = text; *p; p++) {
+    if (p[0] == '\\' && p[1] == 'n') {
+      decoded += '\n';
+      p++;
+    } else if (p[0] == '\\' && p[1] == 'r') {
+      decoded += '\r';
+      p++;
+    } else if (p[0] == '\\' && p[1] == '\\') {
+      decoded += '\\';
+      p++;
+    } else {
+      decoded += *p;
+    }
+  }
+  return decoded;
+}
+
+int main(int argc, char** argv) {
+  unsigned long seconds = 60;
+  unsigned long stepUs = 1000;
+  bool checkAllocations = false;
+  bool checkSchedule = false;
+  std::vector<const char*> commands;
+  std::string typed;
+  unsigned long typeMs = 7;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      seconds = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--pose-ms") == 0 && i + 1 < argc) {
+      scriptPoseMs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--step-us") == 0 && i + 1 < argc) {
+      stepUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--command") == 0 && i + 1 < argc) {
+      commands.push_back(argv[++i]);
+    } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+      typed += decodeEscapes(argv[++i]);
+    } else if (strcmp(argv[i], "--type-ms") == 0 && i + 1 < argc) {
+      typeMs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--flash") == 0 && i + 1 < argc) {
+      hostFlashPath = argv[++i];
+    } else if (strcmp(argv[i], "--check-allocations") == 0) {
+      checkAllocations = true;
+    } else if (strcmp(argv[i], "--check-schedule") == 0) {
+      checkSchedule = true;
+    } else if (strcmp(argv[i], "--quiet") == 0) {
+      Serial.echo = false;
+    } else {
+      fprintf(stderr, "Usage: %s [--seconds N] [--pose-ms N] [--step-us N] [--command TEXT]... [--type TEXT]... "
+              "[--type-ms N] [--flash FILE] [--check-allocations] [--check-schedule] [--quiet]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  hostReset();
+  hostAdcScript = scriptedAdc;
+
+  auto wallStart = std::chrono::steady_clock::now();
+
+  setup();
+  unsigned long long setupUs = hostTimeUs;
+
+  // Serial commands arrive right after setup, as if typed in the serial monitor
+  for (const char* command : commands) {
+    Serial.hostInject(command);
+    Serial.hostInject("\n");
+  }
+
+  // Typed input starts with setup done, one fragment at a time
+  std::minstd_rand typing(1);
+  size_t typedPos = 0;
+  unsigned long long nextTypeUs = setupUs;
+
+  // Run loop(), moving the virtual clock to the next task release (at most stepUs at a time)
+  unsigned long long endUs = setupUs + (unsigned long long)seconds * 1000000ULL;
+  unsigned long iterations = 0;
+  unsigned long loopAllocations = 0, worstLoopAllocations = 0;
+  while (hostTimeUs < endUs) {
+#ifdef USE_ADC_SAMPLER
+    // Let the sampler thread deliver every block due by now
+    adcSamplerHostSync();
+#endif
+    if (typedPos < typed.size() && hostTimeUs >= nextTypeUs) {
+      size_t fragment = 1 + typing() % 3;
+      Serial.hostInject(typed.substr(typedPos, fragment).c_str());
+      typedPos += fragment;
+      nextTypeUs = hostTimeUs + 1000ULL * (1 + typing() % (2 * typeMs + 1));
+    }
+
+    unsigned long allocationsBefore = heapAllocations;
+    loop();
+    unsigned long allocations = heapAllocations - allocationsBefore;
+    loopAllocations += allocations;
+    if (allocations > worstLoopAllocations) worstLoopAllocations = allocations;
+
+    // Jump to the next task release, at most stepUs ahead
+    unsigned long idleUs = nextTaskDelayUs();
+    if (idleUs > stepUs) idleUs = stepUs;
+    if (typedPos < typed.size() && nextTypeUs > hostTimeUs && nextTypeUs - hostTimeUs < idleUs) {
+      idleUs = (unsigned long)(nextTypeUs - hostTimeUs);
+    }
+    hostAdvanceUs(idleUs);
+    iterations++;
+  }
+
+#ifdef USE_ADC_SAMPLER
+  adcSamplerEnd();
+#endif
+
+  // Scheduler timing on the virtual clock
+  bool echo = Serial.echo;
+  Serial.echo = true;
+  printSchedulerStats();
+  Serial.echo = echo;
+
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double virtualSeconds = hostTimeUs / 1e6;
+
+  fprintf(stderr, "\n--- host run summary ---\n");
+  fprintf(stderr, "virtual time      %.3f s (setup %.3f s)\n", virtualSeconds, setupUs / 1e6);
+  fprintf(stderr, "wall time         %.3f s (%.0fx real time)\n", wallSeconds,
+          wallSeconds > 0 ? virtualSeconds / wallSeconds : 0);
+  fprintf(stderr, "loop() calls      %lu\n", iterations);
+  fprintf(stderr, "analogRead calls  %lu\n", hostAnalogReadCount);
+#ifdef USE_ADC_SAMPLER
+  fprintf(stderr, "sampler scans     %lu, %lu blocks dropped\n",
+          (unsigned long)samplerScanCount.load(), (unsigned long)adcSamplerOverruns());
+#endif
+  fprintf(stderr, "run_classifier    %lu\n", hostClassifierCallCount);
+  fprintf(stderr, "heap allocations  %lu in loop() (%lu in the worst call)\n", loopAllocations, worstLoopAllocations);
+  fprintf(stderr, "serial typed      %zu of %zu bytes\n", typedPos < typed.size() ? typedPos : typed.size(), typed.size());
+  fprintf(stderr, "LCD chars sent    %lu\n", lcd.hostCharCount);
+  fprintf(stderr, "flash operations  %lu erases, %lu programs\n", hostFlashEraseCount, hostFlashProgramCount);
+  fprintf(stderr, "scripted poses    ");
+  for (int i = 0; i < SCRIPT_POSE_COUNT; i++) fprintf(stderr, "%s ", SCRIPT_POSE_NAMES[i]);
+  fprintf(stderr, "(%lu ms each)\n", scriptPoseMs);
+
+  if (checkAllocations && loopAllocations > 0) {
+    fprintf(stderr, "loop() allocated from the heap\n");
+    return 1;
+  }
+  if (checkSchedule) {
+    for (int i = 0; i < taskCount; i++) {
+      if (strcmp(tasks[i].name, "sampling") != 0) continue;
+      if (tasks[i].missed > 0 || tasks[i].maxJitterUs > SCHEDULE_JITTER_LIMIT_US) {
+        fprintf(stderr, "sampling schedule disturbed: %lu missed, %lu us max jitter (limit %lu us)\n",
+                tasks[i].missed, tasks[i].maxJitterUs, SCHEDULE_JITTER_LIMIT_US);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
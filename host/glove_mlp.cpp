@@ -0,0 +1,587 @@
+/*
+ * glove_mlp.cpp - Train, quantize and check the in-tree int8 network on recorded captures
+ *
+ * Computes the model input of every window of the captures (the feature
+ * spec's statistics of each window channel, as the sketch computes them),
+ * each capture preceded by WINDOW_SIZE readings of its first row - setup()
+ * fills the window with readings of the still hand before the first
+ * inference, a window the network must not mistake for another gesture -
+ * trains the Edge Impulse project's network on it - dense layers of 25, 15
+ * and 10 ReLU neurons and a softmax, Adam, 30 training cycles at a learning
+ * rate of 0.0005 by default - and quantizes it to int8 as the TensorFlow Lite
+ * converter does: per-tensor activation scales and zero points from the
+ * ranges seen on the captures, symmetric weights and int32 biases. It
+ * reports the accuracy of the float and the int8 network, how often their
+ * top labels agree, and checks that the kernel mlp_engine.h selects for
+ * this build gives the same bytes as the reference loops on every layer of
+ * every window. --write stores the int8 network as mlp_model.h.
+ *
+ * --check skips training and runs the same report on the network compiled
+ * into mlp_model.h.
+ *
+ * The captures are read with sessionFrames() (csv_session.h), as on the
+ * glove: flex readings go through the sketch's bend table, so the network
+ * is trained on the same ADC steps it classifies, and binary telemetry
+ * captures (.bin), which hold unfiltered readings, through the FLEX_FILTER
+ * and IMU_FILTER chains of config.h.
+ *
+ * Usage: glove_mlp [--rate HZ] [--step N] [--epochs N] [--learning-rate R] [--seed N] [--check] [--write FILE]
+ *                  file.bin|file.csv...
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "feature_spec.h"
+#include "mlp_engine.h"
+#include "csv_session.h"
+#include "telemetry_decoder.h"
+
+// Dense layers of the Edge Impulse project, before the output layer
+static const int HIDDEN_SIZES[] = {25, 15, 10};
+static const int BATCH_SIZE = 32;
+
+// One window's model input and its capture's label
+struct Example {
+  std::vector<float> features;
+  int label;
+};
+
+// Float dense layer, one row of weights per output
+struct FloatLayer {
+  int inputs, outputs;
+  std::vector<float> weights, bias;
+  std::vector<float> mWeights, vWeights, mBias, vBias;   // Adam moments
+};
+
+// int8 network built from a float one, and the storage its MlpModel points into
+struct QuantizedNetwork {
+  std::vector<std::vector<int8_t>> weights;
+  std::vector<std::vector<int32_t>> bias;
+  std::vector<MlpDenseLayer> layers;
+  std::vector<const char*> labels;
+  MlpModel model;
+};
+
+/**
+ * @brief Append the model input of every step-th window of a capture, starting from the window setup() fills
+ */
+static void appendExamples(const CsvSession& session, int label, int step, std::vector<Example>* examples) {
+  std::vector<std::vector<float>> frames = sessionFrames(session);
+  std::vector<float> channels[CSV_CHANNEL_COUNT];
+  // The first row as setup() reads it, then the capture
+  for (size_t n = 0; n < frames.size() + WINDOW_SIZE - 1; n++) {
+    size_t row = (n < WINDOW_SIZE - 1) ? 0 : n - (WINDOW_SIZE - 1);
+    for (int ch = 0; ch < CSV_CHANNEL_COUNT; ch++) {
+      channels[ch].push_back(frames[row][ch]);
+    }
+  }
+
+  for (size_t start = 0; start + WINDOW_SIZE <= channels[0].size(); start += step) {
+    Example example;
+    example.label = label;
+    for (int ch = 0; ch < WINDOW_CHANNEL_COUNT; ch++) {
+      const float* window = channels[WINDOW_CHANNELS[ch]].data() + start;
+      double sum = 0, sum2 = 0, minValue = window[0], maxValue = window[0];
+      for (int i = 0; i < WINDOW_SIZE; i++) {
+        sum += window[i];
+        sum2 += (double)window[i] * window[i];
+        minValue = std::min(minValue, (double)window[i]);
+        maxValue = std::max(maxValue, (double)window[i]);
+      }
+      double mean = sum / WINDOW_SIZE;
+      double m2 = 0, m3 = 0, m4 = 0;
+      for (int i = 0; i < WINDOW_SIZE; i++) {
+        double d = window[i] - mean;
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+      }
+      double variance = m2 / WINDOW_SIZE;
+      double stdev = sqrt(variance);
+
+      float all[STATISTIC_COUNT], stats[STATS_PER_SENSOR];
+      all[STAT_MEAN] = (float)mean;
+      all[STAT_MIN] = (float)minValue;
+      all[STAT_MAX] = (float)maxValue;
+      all[STAT_RMS] = (float)sqrt(sum2 / WINDOW_SIZE);
+      all[STAT_STDEV] = (float)stdev;
+      all[STAT_SKEWNESS] = (stdev > 0.0001) ? (float)(m3 / (WINDOW_SIZE * stdev * stdev * stdev)) : 0;
+      all[STAT_KURTOSIS] = (variance > 0.0001) ? (float)(m4 / (WINDOW_SIZE * variance * variance) - 3) : 0;
+      selectStatistics(all, stats);
+      example.features.insert(example.features.end(), stats, stats + STATS_PER_SENSOR);
+    }
+    examples->push_back(example);
+  }
+}
+
+/**
+ * @brief Forward pass, keeping the output of every layer - ReLU on the hidden layers, logits last
+ */
+static void forward(const std::vector<FloatLayer>& network, const std::vector<float>& input,
+                    std::vector<std::vector<float>>* outputs) {
+  outputs->resize(network.size());
+  const std::vector<float>* in = &input;
+  for (size_t l = 0; l < network.size(); l++) {
+    const FloatLayer& layer = network[l];
+    std::vector<float>& out = (*outputs)[l];
+    out.assign(layer.outputs, 0);
+    for (int o = 0; o < layer.outputs; o++) {
+      float acc = layer.bias[o];
+      for (int i = 0; i < layer.inputs; i++) acc += layer.weights[o * layer.inputs + i] * (*in)[i];
+      out[o] = (l + 1 < network.size()) ? std::max(acc, 0.0F) : acc;
+    }
+    in = &out;
+  }
+}
+
+static std::vector<float> softmax(const std::vector<float>& logits) {
+  float maxLogit = *std::max_element(logits.begin(), logits.end());
+  std::vector<float> p(logits.size());
+  float total = 0;
+  for (size_t i = 0; i < logits.size(); i++) total += (p[i] = expf(logits[i] - maxLogit));
+  for (float& value : p) value /= total;
+  return p;
+}
+
+template <class T>
+static int argmax(const T* values, int count) {
+  int best = 0;
+  for (int i = 1; i < count; i++) {
+    if (values[i] > values[best]) best = i;
+  }
+  return best;
+}
+
+/**
+ * @brief Train with Adam on mini-batches of softmax cross-entropy
+ */
+static std::vector<FloatLayer> train(const std::vector<Example>& examples, int labelCount, int epochs,
+                                     float learningRate, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::vector<FloatLayer> network;
+  int inputs = (int)examples[0].features.size();
+  std::vector<int> sizes(HIDDEN_SIZES, HIDDEN_SIZES + sizeof(HIDDEN_SIZES) / sizeof(HIDDEN_SIZES[0]));
+  sizes.push_back(labelCount);
+  for (int outputs : sizes) {
+    FloatLayer layer;
+    layer.inputs = inputs;
+    layer.outputs = outputs;
+    std::normal_distribution<float> init(0, sqrtf(2.0F / inputs));   // He initialization
+    for (int i = 0; i < inputs * outputs; i++) layer.weights.push_back(init(rng));
+    layer.bias.assign(outputs, 0);
+    layer.mWeights.assign(inputs * outputs, 0);
+    layer.vWeights.assign(inputs * outputs, 0);
+    layer.mBias.assign(outputs, 0);
+    layer.vBias.assign(outputs, 0);
+    network.push_back(layer);
+    inputs = outputs;
+  }
+
+  const float beta1 = 0.9F, beta2 = 0.999F, epsilon = 1e-7F;
+  std::vector<size_t> order(examples.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+  int t = 0;
+  for (int epoch = 0; epoch < epochs; epoch++) {
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t batchStart = 0; batchStart < order.size(); batchStart += BATCH_SIZE) {
+      size_t batchEnd = std::min(order.size(), batchStart + BATCH_SIZE);
+      std::vector<std::vector<float>> gradWeights(network.size()), gradBias(network.size());
+      for (size_t l = 0; l < network.size(); l++) {
+        gradWeights[l].assign(network[l].weights.size(), 0);
+        gradBias[l].assign(network[l].outputs, 0);
+      }
+
+      for (size_t b = batchStart; b < batchEnd; b++) {
+        const Example& example = examples[order[b]];
+        std::vector<std::vector<float>> outputs;
+        forward(network, example.features, &outputs);
+
+        // Cross-entropy gradient of the logits, then back through the layers
+        std::vector<float> delta = softmax(outputs.back());
+        delta[example.label] -= 1;
+        for (size_t l = network.size(); l-- > 0;) {
+          const FloatLayer& layer = network[l];
+          const std::vector<float>& in = l ? outputs[l - 1] : example.features;
+          std::vector<float> deltaIn(layer.inputs, 0);
+          for (int o = 0; o < layer.outputs; o++) {
+            gradBias[l][o] += delta[o];
+            for (int i = 0; i < layer.inputs; i++) {
+              gradWeights[l][o * layer.inputs + i] += delta[o] * in[i];
+              deltaIn[i] += delta[o] * layer.weights[o * layer.inputs + i];
+            }
+          }
+          if (l) {
+            for (int i = 0; i < layer.inputs; i++) {
+              if (in[i] <= 0) deltaIn[i] = 0;   // ReLU
+            }
+          }
+          delta.swap(deltaIn);
+        }
+      }
+
+      t++;
+      float batch = (float)(batchEnd - batchStart);
+      float correction1 = 1 - powf(beta1, (float)t), correction2 = 1 - powf(beta2, (float)t);
+      auto step = [&](float& value, float& m, float& v, float gradient) {
+        gradient /= batch;
+        m = beta1 * m + (1 - beta1) * gradient;
+        v = beta2 * v + (1 - beta2) * gradient * gradient;
+        value -= learningRate * (m / correction1) / (sqrtf(v / correction2) + epsilon);
+      };
+      for (size_t l = 0; l < network.size(); l++) {
+        FloatLayer& layer = network[l];
+        for (size_t i = 0; i < layer.weights.size(); i++) {
+          step(layer.weights[i], layer.mWeights[i], layer.vWeights[i], gradWeights[l][i]);
+        }
+        for (int o = 0; o < layer.outputs; o++) step(layer.bias[o], layer.mBias[o], layer.vBias[o], gradBias[l][o]);
+      }
+    }
+  }
+  return network;
+}
+
+/**
+ * @brief TensorFlow Lite QuantizeMultiplier - a real multiplier as a Q31 value and a power-of-two shift
+ */
+static void quantizeMultiplier(double real, int32_t* multiplier, int32_t* shift) {
+  if (real == 0) {
+    *multiplier = 0;
+    *shift = 0;
+    return;
+  }
+  int exponent;
+  double fraction = frexp(real, &exponent);
+  int64_t fixed = (int64_t)llround(fraction * (1LL << 31));
+  if (fixed == (1LL << 31)) {
+    fixed /= 2;
+    exponent++;
+  }
+  if (exponent < -31) {
+    exponent = 0;
+    fixed = 0;
+  }
+  *multiplier = (int32_t)fixed;
+  *shift = exponent;
+}
+
+/**
+ * @brief Asymmetric int8 scale and zero point covering [minValue, maxValue] and 0
+ */
+static void chooseQuantization(float minValue, float maxValue, float* scale, int32_t* zeroPoint) {
+  minValue = std::min(minValue, 0.0F);
+  maxValue = std::max(maxValue, 0.0F);
+  *scale = (maxValue > minValue) ? (maxValue - minValue) / 255.0F : 1.0F;
+  long zero = lroundf(-128 - minValue / *scale);
+  *zeroPoint = (int32_t)constrain(zero, -128L, 127L);
+}
+
+/**
+ * @brief Quantize a float network with activation ranges calibrated on the examples
+ */
+static void quantize(const std::vector<FloatLayer>& network, const std::vector<Example>& examples,
+                     const std::vector<std::string>& labels, QuantizedNetwork* q) {
+  // Range of the input and of every layer's output
+  std::vector<float> minValue(network.size() + 1, INFINITY), maxValue(network.size() + 1, -INFINITY);
+  for (const Example& example : examples) {
+    std::vector<std::vector<float>> outputs;
+    forward(network, example.features, &outputs);
+    for (size_t t = 0; t <= network.size(); t++) {
+      const std::vector<float>& values = t ? outputs[t - 1] : example.features;
+      for (float value : values) {
+        minValue[t] = std::min(minValue[t], value);
+        maxValue[t] = std::max(maxValue[t], value);
+      }
+    }
+  }
+  std::vector<float> scale(network.size() + 1);
+  std::vector<int32_t> zeroPoint(network.size() + 1);
+  for (size_t t = 0; t <= network.size(); t++) chooseQuantization(minValue[t], maxValue[t], &scale[t], &zeroPoint[t]);
+
+  q->weights.resize(network.size());
+  q->bias.resize(network.size());
+  q->layers.resize(network.size());
+  for (size_t l = 0; l < network.size(); l++) {
+    const FloatLayer& layer = network[l];
+    float maxWeight = 0;
+    for (float w : layer.weights) maxWeight = std::max(maxWeight, fabsf(w));
+    float weightScale = maxWeight > 0 ? maxWeight / 127 : 1;
+    for (float w : layer.weights) q->weights[l].push_back((int8_t)constrain(lroundf(w / weightScale), -127L, 127L));
+    double accScale = (double)scale[l] * weightScale;
+    for (float b : layer.bias) q->bias[l].push_back((int32_t)llround(b / accScale));
+
+    MlpDenseLayer& dense = q->layers[l];
+    dense.inputs = (uint16_t)layer.inputs;
+    dense.outputs = (uint16_t)layer.outputs;
+    dense.weights = q->weights[l].data();
+    dense.bias = q->bias[l].data();
+    dense.inputOffset = -zeroPoint[l];
+    dense.outputOffset = zeroPoint[l + 1];
+    quantizeMultiplier(accScale / scale[l + 1], &dense.multiplier, &dense.shift);
+    bool relu = l + 1 < network.size();
+    dense.activationMin = relu ? std::max(-128, zeroPoint[l + 1]) : -128;
+    dense.activationMax = 127;
+  }
+
+  // Softmax of the logits with beta 1, scaled into the Q5.26 differences of the int8 kernel
+  const int scaledDiffIntegerBits = 5;
+  double realMultiplier = std::min((double)scale[network.size()] * (1LL << (31 - scaledDiffIntegerBits)),
+                                   (double)((1LL << 31) - 1));
+  quantizeMultiplier(realMultiplier, &q->model.softmaxMultiplier, &q->model.softmaxShift);
+  double radius = ((1 << scaledDiffIntegerBits) - 1) * (double)(1LL << (31 - scaledDiffIntegerBits)) /
+                  (double)(1LL << q->model.softmaxShift);
+  q->model.softmaxDiffMin = -(int32_t)floor(radius);
+
+  for (const std::string& label : labels) q->labels.push_back(label.c_str());
+  q->model.layers = q->layers.data();
+  q->model.layerCount = (uint8_t)q->layers.size();
+  q->model.inputScale = scale[0];
+  q->model.inputZeroPoint = zeroPoint[0];
+  q->model.outputScale = 1.0F / 256;
+  q->model.outputZeroPoint = -128;
+  q->model.labels = q->labels.data();
+}
+
+static void quantizeInput(const MlpModel& model, const std::vector<float>& features, int8_t* input) {
+  for (size_t i = 0; i < features.size(); i++) {
+    long value = lroundf(features[i] / model.inputScale) + model.inputZeroPoint;
+    input[i] = (int8_t)constrain(value, -128L, 127L);
+  }
+}
+
+/**
+ * @brief Run the int8 network on every example, and check the selected kernel against the reference loops
+ * @param network Float network to compare with, or NULL
+ */
+static void evaluate(const MlpModel& model, const std::vector<Example>& examples,
+                     const std::vector<FloatLayer>* network) {
+  int labelCount = model.layers[model.layerCount - 1].outputs;
+
+  unsigned long floatCorrect = 0, intCorrect = 0, agree = 0, kernelMismatches = 0, layerCalls = 0;
+  double maxScoreError = 0;
+  for (const Example& example : examples) {
+    int8_t input[MLP_ARENA_WIDTH];
+    quantizeInput(model, example.features, input);
+
+    // Layer by layer through both kernels
+    int8_t a[MLP_ARENA_WIDTH], b[MLP_ARENA_WIDTH], reference[MLP_ARENA_WIDTH];
+    const int8_t* in = input;
+    for (int l = 0; l < model.layerCount; l++) {
+      int8_t* out = (l % 2) ? b : a;
+      mlpDense(&model.layers[l], in, out);
+      mlpDenseScalar(&model.layers[l], in, reference);
+      if (memcmp(out, reference, model.layers[l].outputs) != 0) kernelMismatches++;
+      layerCalls++;
+      in = out;
+    }
+
+    int8_t scores[MLP_ARENA_WIDTH];
+    mlpInvoke(&model, input, scores);
+    int intLabel = argmax(scores, labelCount);
+    if (intLabel == example.label) intCorrect++;
+
+    if (network) {
+      std::vector<std::vector<float>> outputs;
+      forward(*network, example.features, &outputs);
+      std::vector<float> p = softmax(outputs.back());
+      int floatLabel = argmax(p.data(), labelCount);
+      if (floatLabel == example.label) floatCorrect++;
+      if (floatLabel == intLabel) agree++;
+      for (int i = 0; i < labelCount; i++) {
+        double score = (scores[i] - model.outputZeroPoint) * model.outputScale;
+        maxScoreError = std::max(maxScoreError, fabs(score - p[i]));
+      }
+    }
+  }
+
+  size_t count = examples.size();
+  if (network) printf("float accuracy     %.2f%%\n", 100.0 * floatCorrect / count);
+  printf("int8 accuracy      %.2f%%\n", 100.0 * intCorrect / count);
+  if (network) {
+    printf("top label agrees   %lu of %zu windows, largest score difference %.4f\n", agree, count, maxScoreError);
+  }
+  printf("%-18s %lu of %lu layer runs differ from the reference loops\n", MLP_KERNEL_NAME " kernel", kernelMismatches,
+         layerCalls);
+  printf("footprint          %zu bytes of weights and biases, %zu bytes of arena\n", mlpModelBytes(&model),
+         sizeof(mlpArena));
+}
+
+static void writeArray(FILE* file, const char* type, const char* name, int index, const int32_t* values, size_t count,
+                       int perLine) {
+  fprintf(file, "const %s %s_%d[%zu] = {", type, name, index, count);
+  for (size_t i = 0; i < count; i++) {
+    fprintf(file, "%s%s%d", i ? "," : "", (i % perLine) ? " " : "\n  ", (int)values[i]);
+  }
+  fprintf(file, "\n};\n\n");
+}
+
+static bool writeModel(const char* path, const QuantizedNetwork& q, size_t examples, size_t files) {
+  FILE* file = fopen(path, "w");
+  if (!file) return false;
+
+  const MlpModel& model = q.model;
+  int maxWidth = 0;
+  for (const MlpDenseLayer& layer : q.layers) maxWidth = std::max(maxWidth, (int)std::max(layer.inputs, layer.outputs));
+
+  fprintf(file, "/*\n");
+  fprintf(file, " * mlp_model.h - int8 Gesture Network\n");
+  fprintf(file, " *\n");
+  fprintf(file, " * Generated by host/glove_mlp from %zu windows of %zu captures - do not edit.\n", examples, files);
+  fprintf(file, " *\n");
+  fprintf(file, " * Dense layers of");
+  for (size_t l = 0; l < q.layers.size(); l++) {
+    fprintf(file, "%s %d", l == 0 ? "" : (l + 1 < q.layers.size() ? "," : " and"), q.layers[l].outputs);
+  }
+  fprintf(file, " neurons and a softmax,\n * quantized to int8 as the TensorFlow Lite converter does.\n");
+  fprintf(file, " */\n\n");
+  fprintf(file, "#ifndef MLP_MODEL_H\n#define MLP_MODEL_H\n\n");
+  fprintf(file, "#define MLP_INPUT_COUNT %d\n", q.layers.front().inputs);
+  fprintf(file, "#define MLP_LABEL_COUNT %d\n", q.layers.back().outputs);
+  fprintf(file, "#define MLP_MAX_WIDTH %d\n\n", maxWidth);
+  fprintf(file, "const char* const MLP_LABELS[MLP_LABEL_COUNT] = {");
+  for (size_t i = 0; i < q.labels.size(); i++) fprintf(file, "%s\"%s\"", i ? ", " : "", q.labels[i]);
+  fprintf(file, "};\n\n");
+
+  for (size_t l = 0; l < q.layers.size(); l++) {
+    std::vector<int32_t> weights(q.weights[l].begin(), q.weights[l].end());
+    writeArray(file, "int8_t", "MLP_WEIGHTS", (int)l, weights.data(), weights.size(), 20);
+    writeArray(file, "int32_t", "MLP_BIAS", (int)l, q.bias[l].data(), q.bias[l].size(), 8);
+  }
+
+  fprintf(file, "const MlpDenseLayer MLP_LAYERS[] = {\n");
+  for (size_t l = 0; l < q.layers.size(); l++) {
+    const MlpDenseLayer& layer = q.layers[l];
+    fprintf(file, "  {%d, %d, MLP_WEIGHTS_%zu, MLP_BIAS_%zu, %d, %d, %d, %d, %d, %d},\n", layer.inputs, layer.outputs,
+            l, l, (int)layer.inputOffset, (int)layer.outputOffset, (int)layer.multiplier, (int)layer.shift,
+            (int)layer.activationMin, (int)layer.activationMax);
+  }
+  fprintf(file, "};\n\n");
+  fprintf(file, "const MlpModel MLP_MODEL = {\n");
+  fprintf(file, "  MLP_LAYERS, %d,\n", model.layerCount);
+  fprintf(file, "  %.9gF, %d,  // Input scale and zero point\n", model.inputScale, (int)model.inputZeroPoint);
+  fprintf(file, "  %d, %d, %d,  // Softmax multiplier, shift and smallest difference\n",
+          (int)model.softmaxMultiplier, (int)model.softmaxShift, (int)model.softmaxDiffMin);
+  fprintf(file, "  1.0F / 256, -128,  // Score scale and zero point\n");
+  fprintf(file, "  MLP_LABELS\n");
+  fprintf(file, "};\n\n");
+  fprintf(file, "#endif // MLP_MODEL_H\n");
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned long periodMs = SAMPLING_INTERVAL_MS;
+  int step = 5, epochs = 30;
+  float learningRate = 0.0005F;
+  unsigned seed = 1;
+  bool check = false;
+  const char* writePath = nullptr;
+  std::vector<const char*> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+      periodMs = 1000 / strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--step") == 0 && i + 1 < argc) {
+      step = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--epochs") == 0 && i + 1 < argc) {
+      epochs = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--learning-rate") == 0 && i + 1 < argc) {
+      learningRate = strtof(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--check") == 0) {
+      check = true;
+    } else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+      writePath = argv[++i];
+    } else if (argv[i][0] == '-') {
+      files.clear();
+      break;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+
+  if (files.empty()) {
+    fprintf(stderr, "Usage: %s [--rate HZ] [--step N] [--epochs N] [--learning-rate R] [--seed N] [--check] "
+            "[--write FILE] file.bin|file.csv...\n", argv[0]);
+    return 2;
+  }
+
+  // Labels in alphabetical order, as Edge Impulse exports them - or the compiled model's with --check
+  std::vector<CsvSession> sessions(files.size());
+  std::map<std::string, int> labelIndex;
+  for (size_t i = 0; i < files.size(); i++) {
+    size_t length = strlen(files[i]);
+    bool loaded = (length > 4 && strcmp(files[i] + length - 4, ".bin") == 0)
+                    ? loadTelemetrySession(files[i], &sessions[i])
+                    : loadCsvSession(files[i], periodMs, &sessions[i]);
+    if (!loaded) {
+      fprintf(stderr, "%s: could not be loaded\n", files[i]);
+      return 1;
+    }
+    labelIndex[sessions[i].label] = 0;
+  }
+  std::vector<std::string> labels;
+  if (check) {
+    labelIndex.clear();
+    for (int i = 0; i < MLP_LABEL_COUNT; i++) labelIndex[MLP_MODEL.labels[i]] = i;
+    for (int i = 0; i < MLP_LABEL_COUNT; i++) labels.push_back(MLP_MODEL.labels[i]);
+  } else {
+    for (auto& entry : labelIndex) {
+      entry.second = (int)labels.size();
+      labels.push_back(entry.first);
+    }
+  }
+
+  std::vector<Example> examples;
+  for (const CsvSession& session : sessions) {
+    auto label = labelIndex.find(session.label);
+    if (label == labelIndex.end()) {
+      fprintf(stderr, "%s: label '%s' is not in the model\n", session.path.c_str(), session.label.c_str());
+      return 1;
+    }
+    appendExamples(session, label->second, step, &examples);
+  }
+  if (examples.empty()) {
+    fprintf(stderr, "No capture is longer than a window (%d samples)\n", WINDOW_SIZE);
+    return 1;
+  }
+  printf("%zu captures, %zu windows of %d samples, %zu features, %zu labels\n", files.size(), examples.size(),
+         WINDOW_SIZE, examples[0].features.size(), labels.size());
+
+  if (check) {
+    if ((int)examples[0].features.size() != MLP_INPUT_COUNT) {
+      fprintf(stderr, "The compiled network takes %d features, the captures give %zu\n", MLP_INPUT_COUNT,
+              examples[0].features.size());
+      return 1;
+    }
+    printf("\n--- compiled network (mlp_model.h) ---\n");
+    evaluate(MLP_MODEL, examples, nullptr);
+    return 0;
+  }
+
+  std::vector<FloatLayer> network = train(examples, (int)labels.size(), epochs, learningRate, seed);
+  QuantizedNetwork quantized;
+  quantize(network, examples, labels, &quantized);
+  if (quantized.layers.front().inputs > MLP_ARENA_WIDTH) {
+    fprintf(stderr, "The network is wider than the compiled arena (%d) - write it and rebuild to check it\n",
+            MLP_ARENA_WIDTH);
+  } else {
+    printf("\n--- trained network (%d epochs, learning rate %g) ---\n", epochs, learningRate);
+    evaluate(quantized.model, examples, &network);
+  }
+
+  if (writePath) {
+    if (!writeModel(writePath, quantized, examples.size(), files.size())) {
+      fprintf(stderr, "Could not write %s\n", writePath);
+      return 1;
+    }
+    printf("\nNetwork written to %s\n", writePath);
+  }
+  return 0;
+}
@@ -0,0 +1,1070 @@
+/*
+ * glove_replay.cpp - Replay recorded sessions through the v0.2 recognition sketch
+ *
+ * Streams CSV captures from calibrated_data_collection.ino through the
+ * unchanged sketch on the virtual clock: each row becomes the ADC and IMU
+ * readings seen by readAllSensors() at its timestamp, and loop() runs
+ * sampling, statistics and inference as it would on the glove. Recognized
+ * gestures are reported with their time since the start of the recording.
+ *
+ * CSV captures are already low-pass filtered, so they are replayed with the
+ * filter as a pass-through (ALPHA = 1.0). Binary telemetry captures (.bin,
+ * see telemetry.h) hold raw ADC and IMU readings instead: they go through
+ * the sketch's own calibration, filter and features, with the sketch's
+ * DEFAULT_ALPHA or each coefficient given to --alpha. The replay targets are
+ * built with ALPHA as a run-time variable for this, and WINDOW_SIZE can be
+ * swept with the glove_replay_w<N> builds (GLOVE_REPLAY_WINDOWS in CMake).
+ *
+ * Each file runs in its own process so every replay starts from the sketch's
+ * power-on state, and several files can be replayed in parallel.
+ *
+ * --drift runs a long session instead: the files are played back to back,
+ * over and over for --hours, in a single run, while every flex reading is
+ * offset by a per-finger drift that grows at the given ADC steps per hour.
+ * Accuracy is reported per hour of the run, along with how far the sketch's
+ * calibration endpoints are from the drifted ones (CSV captures, which are
+ * converted to ADC with the config.h calibration). Compare glove_replay with
+ * glove_replay_adaptive (USE_ADAPTIVE_CALIBRATION) to see drift tracking.
+ *
+ * --sequence plays the files back to back once, without drift, to measure
+ * the decision layer on gesture changes: the time from each change to the
+ * recognition of the new gesture, and the recognitions of a gesture that is
+ * not being held (false decisions). The smoothing time constant is a
+ * run-time variable like ALPHA; --decision-ms runs the sequence once per
+ * value given (replays of single files take the first). Compare with
+ * glove_replay_debounce (USE_DEBOUNCE_DECISION).
+ *
+ * glove_replay_cascade (USE_CASCADE) compares every answer of the cascade's
+ * first stage with the top label run_classifier() gives the same window,
+ * and reports the share of run_classifier() calls it avoided. Both stages
+ * are trained on the same recordings, so agreement is not evidence that the
+ * first stage matches a classifier trained on real captures.
+ *
+ * glove_replay_mlp (USE_MLP_ENGINE) runs the in-tree int8 network of
+ * mlp_engine.h in place of run_classifier(); its inferences are the
+ * network's invocations.
+ *
+ * glove_replay_temporal (USE_TEMPORAL_MODEL) steps the streaming temporal
+ * model of temporal.h with every sample and blends its scores into the
+ * classifier's; use --sequence to compare the time to decision.
+ *
+ * Usage: glove_replay [--rate HZ] [--alpha A[,B...]] [--step-us N] [--jobs N] [--check-stats] [--quiet]
+ *                     [--drift ADC_PER_HOUR [--hours H] | --sequence] [--decision-ms T[,U...]]
+ *                     file.csv|file.bin...
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "config.h"
+
+// Filter coefficient and decision time constant of the current replay - the sketch's ALPHA and
+// DECISION_TIME_MS (see CMakeLists.txt)
+static float replayAlpha = 1.0F;
+static float replayDecisionMs = DEFAULT_DECISION_TIME_MS;
+
+#include "csv_session.h"
+#include "telemetry_decoder.h"
+
+#include "Sign_Language_Recognition_Split_EN_v0.2.ino"
+
+// Result of replaying one session
+struct ReplayResult {
+  unsigned long samples;
+  unsigned long durationMs;
+  unsigned long outputs;         // "Recognized gesture" lines
+  unsigned long decisions;       // Outputs of another gesture than the previous output, or after a release
+  unsigned long correct;         // Outputs matching the session label
+  long firstOutputMs;            // -1 if nothing was recognized
+  long firstCorrectMs;           // -1 if the session label was never recognized
+  unsigned long inferences;      // run_classifier() calls
+  unsigned long skipped;         // Inference task runs suppressed by the motion trigger
+  double statsMaxError;          // Largest feature path vs two-pass statistics difference
+  double simdMaxError;           // Largest vector kernel vs two-pass statistics difference
+  unsigned long viewMismatches;  // Model input reads that differ from the per-channel statistics
+  int sampleMaxSteps;            // Largest fixed-point window sample difference from the float pipeline's,
+                                 // in Q15 steps (USE_FIXED_POINT)
+  double pipelineMaxError;       // Largest fixed-point feature difference from the float pipeline's (USE_FIXED_POINT)
+  unsigned long fastHits;        // Windows answered by the cascade's first stage (USE_CASCADE)
+  unsigned long fastMismatches;  // First-stage answers that are not the classifier's top label for the window
+  unsigned long fastRight;       // Of those, answers naming the gesture being played
+  float alpha;                   // Filter coefficient the session was replayed with
+};
+
+static CsvSession replaySession;
+static unsigned long long replayStartUs = 0;
+static size_t replayCursor = 0;
+
+// Drift run (--drift): sensor drift in ADC steps per hour, and its sign and size per finger
+static float replayDriftPerHour = 0;
+static const float REPLAY_DRIFT_PATTERN[5] = {1.0F, -0.6F, 0.8F, -1.0F, 0.5F};
+
+// Outputs this long after a drift run moves to the next file still see the previous gesture in the window
+static const unsigned long REPLAY_SEGMENT_SETTLE_MS = 1500;
+
+// One file of a drift or sequence run
+struct DriftSegment {
+  unsigned long startMs;
+  std::string label;
+  std::string previousLabel;   // Label of the file before, "" for the first
+  bool recognized;
+  long decisionMs;             // Time from the start of the file to the first decision of its label, -1 if none
+};
+
+// Results of one hour of a drift or sequence run
+struct DriftHour {
+  unsigned long segments, labelledSegments, recognizedSegments;
+  unsigned long outputs, correct;
+  unsigned long decisions, falseDecisions;
+  double endpointError;            // Summed over the segment starts
+  unsigned long endpointSamples;
+};
+
+static std::vector<DriftSegment> driftSegments;
+static std::vector<DriftHour> driftHours;
+static size_t driftCursor = 0;
+
+/**
+ * @brief Drift added to a finger's reading at a virtual time
+ */
+static float replayDriftAdc(int finger, unsigned long long timeUs) {
+  if (replayDriftPerHour == 0 || timeUs <= replayStartUs) return 0;
+  return REPLAY_DRIFT_PATTERN[finger] * replayDriftPerHour * (timeUs - replayStartUs) / 3600e6F;
+}
+
+/**
+ * @brief Sample of the session that is current at a virtual time
+ */
+static const CsvSample& replaySampleAt(unsigned long timeUs) {
+  const std::vector<CsvSample>& samples = replaySession.samples;
+  unsigned long long elapsedUs = (timeUs > replayStartUs) ? timeUs - replayStartUs : 0;
+
+  // Time only moves forward, so the cursor never needs to go back
+  while (replayCursor + 1 < samples.size() && samples[replayCursor + 1].timeMs * 1000ULL <= elapsedUs) {
+    replayCursor++;
+  }
+  return samples[replayCursor];
+}
+
+static int replayAdc(int pin, unsigned long timeUs) {
+  const CsvSample& sample = replaySampleAt(timeUs);
+  for (int finger = 0; finger < 5; finger++) {
+    if (FLEX_PINS[finger] == pin) {
+      int adc = replaySession.raw ? (int)sample.values[finger]
+                                  : bendToAdc(sample.values[finger], FLEX_STRAIGHT_ADC[finger], FLEX_BENT_ADC[finger]);
+      if (replayDriftPerHour != 0) {
+        adc = constrain(adc + (int)lroundf(replayDriftAdc(finger, timeUs)), 0, FLEX_ADC_LEVELS - 1);
+      }
+      return adc;
+    }
+  }
+  return 0;
+}
+
+static bool replayImu(unsigned long timeUs, float* accel, float* gyro) {
+  const CsvSample& sample = replaySampleAt(timeUs);
+  memcpy(accel, &sample.values[5], 3 * sizeof(float));
+  memcpy(gyro, &sample.values[8], 3 * sizeof(float));
+  return true;
+}
+
+// Feature path checked by --check-stats, and the largest relative difference from
+// the double-precision two-pass reference it accepts
+#if defined(USE_FIXED_POINT)
+#define FEATURE_PATH_NAME "fixed-point"
+static const double STATS_TOLERANCE = 1e-4;
+#elif defined(USE_SIMD_STATISTICS)
+#define FEATURE_PATH_NAME "vector"
+static const double STATS_TOLERANCE = 1e-4;
+#else
+#define FEATURE_PATH_NAME "running"
+static const double STATS_TOLERANCE = 1e-4;
+#endif
+
+// Decision rule of the build
+#ifdef USE_DEBOUNCE_DECISION
+#define DECISION_RULE_NAME "debounce"
+#else
+#define DECISION_RULE_NAME "smoothing"
+#endif
+
+// Classifier calls so far - the in-tree network's with USE_MLP_ENGINE, the stub Edge Impulse classifier's otherwise
+#ifdef USE_MLP_ENGINE
+#define REPLAY_CLASSIFIER_CALLS mlpInvokeCount
+#else
+#define REPLAY_CLASSIFIER_CALLS hostClassifierCallCount
+#endif
+
+#ifdef USE_CASCADE
+/**
+ * @brief Whether the cascade's latest first-stage answer is the top label the classifier gives the window -
+ *        the int8 network with USE_MLP_ENGINE, the stub run_classifier() otherwise
+ * @note Calls the classifier directly, so the check is not counted as an inference
+ */
+static bool cascadeMatchesClassifier() {
+  ei_impulse_result_t reference = {};
+#ifdef USE_MLP_ENGINE
+  signal_t signal;
+  signal.total_length = FEATURE_COUNT;
+  signal.get_data = &get_signal_data;
+  runMlpClassifier(&signal, &reference);
+  mlpInvokeCount--;
+#else
+  float features[FEATURE_COUNT];
+  get_signal_data(0, FEATURE_COUNT, features);
+  hostClassifier(features, FEATURE_COUNT, &reference);
+#endif
+  int best = 0;
+  for (int i = 1; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+    if (reference.classification[i].value > reference.classification[best].value) best = i;
+  }
+  return best == cascade.lastLabel;
+}
+#endif
+
+/**
+ * @brief Print how many windows the cascade's first stage answered, how many of them the classifier would
+ *        have classified differently, and in how many of those the first stage named the gesture being played
+ */
+static void printCascadeSummary(unsigned long fastHits, unsigned long inferences, unsigned long fastMismatches,
+                                unsigned long fastRight) {
+#ifdef USE_CASCADE
+  unsigned long windows = fastHits + inferences;
+  printf("cascade            %lu of %lu windows answered by the first stage (%.1f%% of classifier calls avoided)\n",
+         fastHits, windows, windows ? 100.0 * fastHits / windows : 0);
+  printf("cascade agreement  %lu answers differ from the %s, the first stage right in %lu\n", fastMismatches,
+#ifdef USE_MLP_ENGINE
+         "int8 network (trained on the same recordings)",
+#else
+         "stub run_classifier()",
+#endif
+         fastRight);
+#else
+  (void)fastHits;
+  (void)inferences;
+  (void)fastMismatches;
+  (void)fastRight;
+#endif
+}
+
+// int8 input tensor parameters used to check get_signal_data_int8()
+static const float REPLAY_INPUT_SCALE = 0.75F;
+static const int REPLAY_INPUT_ZERO_POINT = -20;
+
+/**
+ * @brief Whether an int8 model input value is the quantization of a feature within the tolerance of its reference
+ */
+static bool int8MatchesReference(int8_t value, double reference) {
+  double exact = reference / REPLAY_INPUT_SCALE + REPLAY_INPUT_ZERO_POINT;
+  double slack = STATS_TOLERANCE * (1.0 + fabs(reference)) / REPLAY_INPUT_SCALE;
+  long low = std::max(-128L, std::min(127L, lround(exact - slack)));
+  long high = std::max(-128L, std::min(127L, lround(exact + slack)));
+  return value >= low && value <= high;
+}
+
+/**
+ * @brief Read the model input through get_signal_data() and get_signal_data_int8(), whole and in chunks that
+ *        split channels. The whole read is checked against the double-precision reference features - to
+ *        STATS_TOLERANCE, and int8 values to the quantization of a feature within it - and the chunked reads
+ *        against the whole read, byte for byte
+ * @param reference FEATURE_COUNT reference features, in model input order
+ * @return Number of reads that differ
+ */
+static unsigned long checkFeatureView(const double* reference) {
+  static const size_t chunks[] = {FEATURE_COUNT, 1, 3, 10};
+  float whole[FEATURE_COUNT];
+  int8_t wholeInt8[FEATURE_COUNT];
+  unsigned long mismatches = 0;
+
+  for (size_t chunk : chunks) {
+    float input[FEATURE_COUNT];
+    int8_t inputInt8[FEATURE_COUNT];
+    for (size_t offset = 0; offset < FEATURE_COUNT; offset += chunk) {
+      size_t length = std::min(chunk, (size_t)FEATURE_COUNT - offset);
+      get_signal_data(offset, length, input + offset);
+      get_signal_data_int8(offset, length, REPLAY_INPUT_SCALE, REPLAY_INPUT_ZERO_POINT, inputInt8 + offset);
+    }
+
+    if (chunk == FEATURE_COUNT) {
+      memcpy(whole, input, sizeof(whole));
+      memcpy(wholeInt8, inputInt8, sizeof(wholeInt8));
+      bool floatDiffers = false, int8Differs = false;
+      for (int i = 0; i < FEATURE_COUNT; i++) {
+        floatDiffers |= fabs(input[i] - reference[i]) > STATS_TOLERANCE * (1.0 + fabs(reference[i]));
+        int8Differs |= !int8MatchesReference(inputInt8[i], reference[i]);
+      }
+      mismatches += floatDiffers + int8Differs;
+    } else {
+      if (memcmp(input, whole, sizeof(input)) != 0) mismatches++;
+      if (memcmp(inputInt8, wholeInt8, sizeof(inputInt8)) != 0) mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+/**
+ * @brief Two-pass statistics of a window in double precision, with the thresholds of calculateStatistics()
+ * @note calculateStatistics() itself works in float, which loses the skewness and kurtosis of
+ *       low-variance windows far from zero - a filtered raw capture of a finger held still
+ */
+static void referenceStatistics(const float* window, double* stats) {
+  double sum = 0, minValue = window[0], maxValue = window[0], sum2 = 0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    sum += window[i];
+    sum2 += (double)window[i] * window[i];
+    minValue = std::min(minValue, (double)window[i]);
+    maxValue = std::max(maxValue, (double)window[i]);
+  }
+  double mean = sum / WINDOW_SIZE;
+
+  double m2 = 0, m3 = 0, m4 = 0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    double d = window[i] - mean;
+    m2 += d * d;
+    m3 += d * d * d;
+    m4 += d * d * d * d;
+  }
+  double variance = m2 / WINDOW_SIZE;
+  double stdev = sqrt(variance);
+
+  double all[STATISTIC_COUNT];
+  all[STAT_MEAN] = mean;
+  all[STAT_MIN] = minValue;
+  all[STAT_MAX] = maxValue;
+  all[STAT_RMS] = sqrt(sum2 / WINDOW_SIZE);
+  all[STAT_STDEV] = stdev;
+  all[STAT_SKEWNESS] = (stdev > 0.0001) ? m3 / (WINDOW_SIZE * stdev * stdev * stdev) : 0;
+  all[STAT_KURTOSIS] = (variance > 0.0001) ? m4 / (WINDOW_SIZE * variance * variance) - 3 : 0;
+  selectStatistics(all, stats);
+}
+
+#if defined(USE_FIXED_POINT)
+// Float pipeline fed the readings the fixed-point one takes - bend table, float low-pass and float window, as
+// in a build without USE_FIXED_POINT - so the check covers the quantized samples and filter state too
+struct FloatShadow {
+  FilterChain<LowPassStage<5>> flexFilter;
+  FilterChain<LowPassStage<6>> imuFilter;
+  float window[WINDOW_CHANNEL_COUNT][WINDOW_STRIDE];
+  int samples;   // Samples pushed since the reset
+};
+static FloatShadow floatShadow;
+
+/**
+ * @brief Start the float pipeline's filters from the fixed-point filter outputs
+ * @note Its window is compared only once it holds WINDOW_SIZE samples of its own
+ */
+static void resetFloatShadow() {
+  float imu[6];
+  for (int i = 0; i < 6; i++) imu[i] = *channelValues[CHANNEL_ACCEL_X + i];
+  floatShadow.flexFilter.reset(filteredFlexValues);
+  floatShadow.imuFilter.reset(imu);
+  floatShadow.samples = 0;
+}
+
+/**
+ * @brief Push the readings of the sample the fixed-point pipeline just took through the float pipeline
+ */
+static void pushFloatShadow() {
+  float values[SENSOR_CHANNEL_COUNT];
+  for (int i = 0; i < 5; i++) {
+    values[i] = calculateBendPercentage(flexCalibration.bendQ15[i], lastFlexRawValues[i]);
+  }
+  memcpy(&values[CHANNEL_ACCEL_X], IMU.accel, sizeof(IMU.accel));
+  memcpy(&values[CHANNEL_GYRO_X], IMU.gyro, sizeof(IMU.gyro));
+  floatShadow.flexFilter.process(values);
+  floatShadow.imuFilter.process(&values[CHANNEL_ACCEL_X]);
+
+  // The slot updateDataWindow() has just written
+  int index = (windowIndex + WINDOW_SIZE - 1) % WINDOW_SIZE;
+  for (int ch = 0; ch < WINDOW_CHANNEL_COUNT; ch++) {
+    floatShadow.window[ch][index] = values[WINDOW_CHANNELS[ch]];
+  }
+  floatShadow.samples++;
+}
+#endif
+
+/**
+ * @brief Compare the statistics of the configured feature path and the vector kernels against
+ *        the double-precision two-pass reference for every window channel, and check the model input view
+ *        against the reference too
+ * @note With USE_FIXED_POINT the window samples are checked against those of the float pipeline (FloatShadow)
+ *       rounded to the Q15 steps of the channel, the statistics against the reference of the Q15 window, and
+ *       the features against those of the float pipeline's window
+ */
+static void compareStatistics(ReplayResult* result) {
+  double references[FEATURE_COUNT];
+
+  for (int ch = 0; ch < WINDOW_CHANNEL_COUNT; ch++) {
+    float row[WINDOW_STRIDE], feature[STATS_PER_SENSOR], simd[STATS_PER_SENSOR];
+    double* reference = &references[ch * STATS_PER_SENSOR];
+#if defined(USE_FIXED_POINT)
+    uint8_t shift = CHANNEL_SCALE_SHIFT[WINDOW_CHANNELS[ch]];
+    int32_t fixed[STATS_PER_SENSOR];
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+      int steps = abs(sensorWindowQ15[ch][i] - toQ15(floatShadow.window[ch][i], shift));
+      result->sampleMaxSteps = std::max(result->sampleMaxSteps, steps);
+      row[i] = fromQ15(sensorWindowQ15[ch][i], shift);
+    }
+    calculateStatisticsQ15(sensorWindowQ15[ch], shift, fixed);
+    for (int i = 0; i < STATS_PER_SENSOR; i++) feature[i] = fromQ16(fixed[i]);
+    double pipeline[STATS_PER_SENSOR];
+    referenceStatistics(floatShadow.window[ch], pipeline);
+    for (int i = 0; i < STATS_PER_SENSOR; i++) {
+      double error = fabs(pipeline[i] - feature[i]) / (1.0 + fabs(pipeline[i]));
+      if (error > result->pipelineMaxError) result->pipelineMaxError = error;
+    }
+#else
+    memcpy(row, sensorWindow[ch], sizeof(row));
+#if defined(USE_SIMD_STATISTICS)
+    calculateStatisticsSimd(row, feature);
+#else
+    getRunningStatistics(&channelStats[ch], feature);
+#endif
+#endif
+    referenceStatistics(row, reference);
+    calculateStatisticsSimd(row, simd);
+    for (int i = 0; i < STATS_PER_SENSOR; i++) {
+      double scale = 1.0 + fabs(reference[i]);
+      double error = fabs(reference[i] - feature[i]) / scale;
+      if (error > result->statsMaxError) result->statsMaxError = error;
+      error = fabs(reference[i] - simd[i]) / scale;
+      if (error > result->simdMaxError) result->simdMaxError = error;
+    }
+  }
+
+  result->viewMismatches += checkFeatureView(references);
+}
+
+/**
+ * @brief Segment of the drift run playing at a time since its start
+ */
+static size_t driftSegmentAt(unsigned long elapsedMs) {
+  // Time only moves forward, so the cursor never needs to go back
+  while (driftCursor + 1 < driftSegments.size() && driftSegments[driftCursor + 1].startMs <= elapsedMs) {
+    driftCursor++;
+  }
+  return driftCursor;
+}
+
+static DriftHour& driftHourOf(const DriftSegment& segment) {
+  size_t hour = segment.startMs / 3600000UL;
+  if (driftHours.size() <= hour) driftHours.resize(hour + 1, DriftHour{});
+  return driftHours[hour];
+}
+
+/**
+ * @brief Count a segment of the drift run as it starts, with the distance of the sketch's calibration
+ *        endpoints from the drifted config.h ones (CSV captures only - raw captures have their own)
+ */
+static void recordDriftEndpoints(size_t segment) {
+  DriftHour& hour = driftHourOf(driftSegments[segment]);
+  hour.segments++;
+  if (replaySession.raw) return;
+
+  double error = 0;
+  for (int i = 0; i < 5; i++) {
+    float drift = replayDriftAdc(i, hostTimeUs);
+    error += fabs(flexCalibration.straightAdc[i] - (FLEX_STRAIGHT_ADC[i] + drift));
+    error += fabs(flexCalibration.bentAdc[i] - (FLEX_BENT_ADC[i] + drift));
+  }
+  hour.endpointError += error / 10;
+  hour.endpointSamples++;
+}
+
+/**
+ * @brief Score an output of the drift run against the segment that produced it
+ * @param decision Whether the output recognized a gesture, rather than repeating the recognized one
+ */
+static void recordDriftOutput(long elapsedMs, const std::string& label, bool decision) {
+  DriftSegment& segment = driftSegments[driftSegmentAt(elapsedMs)];
+  DriftHour& hour = driftHourOf(segment);
+  bool settling = (unsigned long)elapsedMs - segment.startMs < REPLAY_SEGMENT_SETTLE_MS;
+
+  // A late decision of the previous file's gesture is not false, any other gesture not held is
+  if (decision) {
+    hour.decisions++;
+    if (label == segment.label) {
+      if (segment.decisionMs < 0) segment.decisionMs = (long)(elapsedMs - segment.startMs);
+    } else if (!settling || label != segment.previousLabel) {
+      hour.falseDecisions++;
+    }
+  }
+
+  if (settling) return;
+  hour.outputs++;
+  if (label == segment.label) {
+    hour.correct++;
+    segment.recognized = true;
+  }
+}
+
+/**
+ * @brief Replay one session from the sketch's power-on state
+ * @param report Receives one line per recognized gesture
+ */
+static ReplayResult replay(unsigned long stepUs, bool checkStats, std::string* report) {
+  ReplayResult result = {};
+  result.firstOutputMs = -1;
+  result.firstCorrectMs = -1;
+  result.samples = replaySession.samples.size();
+
+  hostReset();
+  hostAdcScript = replayAdc;
+  IMU.script = replayImu;
+  Serial.echo = false;
+  Serial.capture = true;
+
+  // setup() fills the window from the first row of the recording
+  replayStartUs = ~0ULL;
+  setup();
+  Serial.hostTakeOutput();
+#if defined(USE_FIXED_POINT)
+  if (checkStats) resetFloatShadow();
+#endif
+
+  replayStartUs = hostTimeUs;
+  replayCursor = 0;
+  unsigned long long lastSampleUs = replaySession.samples.back().timeMs * 1000ULL;
+  unsigned long long endUs = replayStartUs + lastSampleUs + SAMPLING_INTERVAL_MS * 1000ULL;
+  unsigned long classifierCallsBefore = REPLAY_CLASSIFIER_CALLS;
+#ifdef USE_CASCADE
+  unsigned long fastHitsBefore = cascade.fastHits;
+  unsigned long lastFastHits = cascade.fastHits;
+#endif
+  uint32_t lastSequence = sampleSequence;
+  driftCursor = 0;
+  size_t lastSegment = SIZE_MAX;
+  std::string decidedLabel;   // Label of the latest output, "" after a release
+
+  while (hostTimeUs < endUs) {
+    loop();
+
+    if (!driftSegments.empty()) {
+      size_t segment = driftSegmentAt((unsigned long)((hostTimeUs - replayStartUs) / 1000ULL));
+      if (segment != lastSegment) recordDriftEndpoints(segment);
+      lastSegment = segment;
+    }
+
+#if defined(USE_FIXED_POINT)
+    if (checkStats && sampleSequence != lastSequence) {
+      pushFloatShadow();
+      if (floatShadow.samples >= WINDOW_SIZE) {
+        compareStatistics(&result);
+      }
+    }
+#else
+    if (checkStats && sampleSequence != lastSequence && windowFilled) {
+      compareStatistics(&result);
+    }
+#endif
+    lastSequence = sampleSequence;
+
+#ifdef USE_CASCADE
+    // loop() runs one task, so the window is still the one the first stage answered for
+    if (cascade.fastHits != lastFastHits && !cascadeMatchesClassifier()) {
+      unsigned long elapsedMs = (unsigned long)((hostTimeUs - replayStartUs) / 1000ULL);
+      const std::string& playing = driftSegments.empty() ? replaySession.label
+                                                         : driftSegments[driftSegmentAt(elapsedMs)].label;
+      result.fastMismatches++;
+      if (playing == ei_classifier_inferencing_categories[cascade.lastLabel]) result.fastRight++;
+    }
+    lastFastHits = cascade.fastHits;
+#endif
+
+    // Timestamp every line the sketch printed during this iteration
+    std::string output = Serial.hostTakeOutput();
+    long elapsedMs = (long)((hostTimeUs - replayStartUs) / 1000ULL);
+    if (output.find("Gesture released") != std::string::npos) decidedLabel.clear();
+    const char* prefix = "Recognized gesture: ";
+    for (size_t pos = output.find(prefix); pos != std::string::npos; pos = output.find(prefix, pos + 1)) {
+      size_t start = pos + strlen(prefix);
+      size_t end = output.find_first_of(" \r\n", start);
+      std::string label = output.substr(start, end - start);
+      size_t lineEnd = output.find('\n', start);
+      std::string line = output.substr(start, lineEnd == std::string::npos ? std::string::npos : lineEnd - start);
+      while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) line.pop_back();
+
+      char buf[160];
+      snprintf(buf, sizeof(buf), "  %8ld ms  %s\n", elapsedMs, line.c_str());
+      *report += buf;
+
+      bool decision = label != decidedLabel;
+      decidedLabel = label;
+      if (!driftSegments.empty()) recordDriftOutput(elapsedMs, label, decision);
+      result.outputs++;
+      if (decision) result.decisions++;
+      if (result.firstOutputMs < 0) result.firstOutputMs = elapsedMs;
+      if (label == replaySession.label) {
+        result.correct++;
+        if (result.firstCorrectMs < 0) result.firstCorrectMs = elapsedMs;
+      }
+    }
+
+    // Jump to the next task release, at most stepUs ahead
+    unsigned long idleUs = nextTaskDelayUs();
+    hostAdvanceUs(idleUs < stepUs ? idleUs : stepUs);
+  }
+
+  result.durationMs = (unsigned long)((endUs - replayStartUs) / 1000ULL);
+  result.inferences = REPLAY_CLASSIFIER_CALLS - classifierCallsBefore;
+#ifdef USE_CASCADE
+  result.fastHits = cascade.fastHits - fastHitsBefore;
+#endif
+#ifdef USE_MOTION_TRIGGER
+  result.skipped = motion.inferencesSkipped;
+#endif
+  return result;
+}
+
+/**
+ * @brief Load a CSV capture, or a binary telemetry capture if the file name ends in .bin
+ */
+static bool loadSession(const char* path, unsigned long periodMs, CsvSession* session) {
+  size_t length = strlen(path);
+  if (length > 4 && strcmp(path + length - 4, ".bin") == 0) {
+    return loadTelemetrySession(path, session);
+  }
+  return loadCsvSession(path, periodMs, session);
+}
+
+// Gesture changes of a drift or sequence run and how the decision layer followed them
+struct DecisionTotals {
+  unsigned long changes, decided;     // Files whose gesture differs from the previous file's
+  unsigned long latencySumMs, latencyMaxMs;
+  unsigned long decisions, falseDecisions;
+};
+
+static DecisionTotals sumDecisions() {
+  DecisionTotals totals = {};
+  for (const DriftSegment& segment : driftSegments) {
+    if (segment.previousLabel.empty() || segment.label == segment.previousLabel) continue;
+    totals.changes++;
+    if (segment.decisionMs < 0) continue;
+    totals.decided++;
+    totals.latencySumMs += segment.decisionMs;
+    totals.latencyMaxMs = std::max(totals.latencyMaxMs, (unsigned long)segment.decisionMs);
+  }
+  for (const DriftHour& hour : driftHours) {
+    totals.decisions += hour.decisions;
+    totals.falseDecisions += hour.falseDecisions;
+  }
+  return totals;
+}
+
+/**
+ * @brief Play the files back to back until the run is hours long (once for a sequence run), with growing
+ *        sensor drift, and report accuracy and decisions per hour
+ * @param decisionTimes Decision time constants to run with - with more than one, each runs in a child
+ *        process and only its summary line is printed
+ * @return Process exit code
+ */
+static int runDrift(const std::vector<const char*>& files, float hours, unsigned long periodMs,
+                    unsigned long stepUs, const std::vector<float>& decisionTimes, bool quiet) {
+  std::vector<CsvSession> sessions(files.size());
+  for (size_t i = 0; i < files.size(); i++) {
+    if (!loadSession(files[i], periodMs, &sessions[i])) {
+      fprintf(stderr, "%s: could not be loaded\n", files[i]);
+      return 1;
+    }
+    if (sessions[i].raw != sessions[0].raw) {
+      fprintf(stderr, "%s: a drift run takes either CSV or raw captures, not both\n", files[i]);
+      return 2;
+    }
+  }
+
+  // One continuous session, each file starting a sample period after the previous one ended
+  replaySession = CsvSession();
+  replaySession.path = "drift run";
+  replaySession.raw = sessions[0].raw;
+  driftSegments.clear();
+  driftHours.clear();
+  unsigned long startMs = 0;
+  unsigned long runMs = (unsigned long)(hours * 3600000.0F);
+  std::string previousLabel;
+  do {
+    for (const CsvSession& session : sessions) {
+      driftSegments.push_back({startMs, session.label, previousLabel, false, -1});
+      previousLabel = session.label;
+      for (CsvSample sample : session.samples) {
+        sample.timeMs += startMs;
+        replaySession.samples.push_back(sample);
+      }
+      startMs = replaySession.samples.back().timeMs + periodMs;
+    }
+  } while (startMs < runMs);
+  replayAlpha = replaySession.raw ? DEFAULT_ALPHA : 1.0F;
+
+  if (decisionTimes.size() > 1) {
+    printf("--- decision sweep (%s, %zu files, %.1f s, alpha %.2f) ---\n", DECISION_RULE_NAME, files.size(),
+           startMs / 1000.0, replayAlpha);
+    printf("  time(ms)  changes decided  decision mean(ms)  max(ms)  decisions  false\n");
+    for (float decisionMs : decisionTimes) {
+      fflush(stdout);
+      pid_t pid = fork();
+      if (pid < 0) return 1;
+      if (pid == 0) {
+        replayDecisionMs = decisionMs;
+        std::string report;
+        replay(stepUs, false, &report);
+        DecisionTotals totals = sumDecisions();
+        printf("  %8.0f %8lu/%-6lu %17.1f %8lu %10lu %6lu\n", decisionMs, totals.decided, totals.changes,
+               totals.decided ? (double)totals.latencySumMs / totals.decided : 0, totals.latencyMaxMs,
+               totals.decisions, totals.falseDecisions);
+        fflush(stdout);
+        _exit(0);
+      }
+      waitpid(pid, nullptr, 0);
+    }
+    return 0;
+  }
+  if (!decisionTimes.empty()) replayDecisionMs = decisionTimes[0];
+
+  auto wallStart = std::chrono::steady_clock::now();
+  std::string report;
+  ReplayResult result = replay(stepUs, false, &report);
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+  for (const DriftSegment& segment : driftSegments) {
+    bool knownLabel = false;
+    for (size_t i = 0; i < sizeof(GESTURE_LABELS) / sizeof(GESTURE_LABELS[0]); i++) {
+      if (segment.label == GESTURE_LABELS[i]) knownLabel = true;
+    }
+    if (!knownLabel) continue;
+    DriftHour& hour = driftHourOf(segment);
+    hour.labelledSegments++;
+    if (segment.recognized) hour.recognizedSegments++;
+  }
+
+  printf("--- %s run (%.1f ADC steps/hour, %zu files, %.1f h, alpha %.2f, %s) ---\n",
+         hours > 0 ? "drift" : "sequence", replayDriftPerHour, files.size(), result.durationMs / 3600000.0,
+         replayAlpha, DECISION_RULE_NAME);
+  printf("  hour  segments  recognized  outputs  correct  decisions  false  endpoint error (ADC)\n");
+  unsigned long outputs = 0, correct = 0, labelled = 0, recognized = 0;
+  for (size_t i = 0; i < driftHours.size(); i++) {
+    const DriftHour& hour = driftHours[i];
+    printf("  %4zu %9lu %5lu/%-5lu %8lu %7.1f%% %10lu %6lu", i + 1, hour.segments, hour.recognizedSegments,
+           hour.labelledSegments, hour.outputs, hour.outputs ? 100.0 * hour.correct / hour.outputs : 0,
+           hour.decisions, hour.falseDecisions);
+    if (hour.endpointSamples) printf(" %12.2f", hour.endpointError / hour.endpointSamples);
+    printf("\n");
+    outputs += hour.outputs;
+    correct += hour.correct;
+    labelled += hour.labelledSegments;
+    recognized += hour.recognizedSegments;
+  }
+  DecisionTotals totals = sumDecisions();
+  printf("\n--- replay summary ---\n");
+  printf("recorded time      %.1f s, %lu samples\n", result.durationMs / 1000.0, result.samples);
+  printf("wall time          %.3f s (%.0fx real time)\n", wallSeconds,
+         wallSeconds > 0 ? result.durationMs / 1000.0 / wallSeconds : 0);
+  printf("inferences         %lu\n", result.inferences);
+  printf("outputs            %lu after the first %lu ms of a file, %lu matching its label (%.1f%%)\n", outputs,
+         REPLAY_SEGMENT_SETTLE_MS, correct, outputs ? 100.0 * correct / outputs : 0);
+  printf("recognized files   %lu of %lu labelled\n", recognized, labelled);
+  printf("gesture changes    %lu, %lu recognized, time to decision mean %.1f ms, max %lu ms\n", totals.changes,
+         totals.decided, totals.decided ? (double)totals.latencySumMs / totals.decided : 0, totals.latencyMaxMs);
+  printf("decisions          %lu, %lu false\n", totals.decisions, totals.falseDecisions);
+  printCascadeSummary(result.fastHits, result.inferences, result.fastMismatches, result.fastRight);
+
+  if (!quiet) {
+    // Calibration and decision counters as the sketch reports them at the end of the run
+    printCalibration();
+    printDecisionStats();
+    fputs(Serial.hostTakeOutput().c_str(), stdout);
+  }
+  return 0;
+}
+
+/**
+ * @brief Replay a file in a child process, writing its report and result to a pipe
+ * @param alpha Filter coefficient, or negative for the default of the capture type
+ * @return Child pid, or -1 on failure
+ */
+static pid_t startReplay(const char* path, float alpha, unsigned long periodMs, unsigned long stepUs, bool checkStats,
+                         int* readFd) {
+  int fds[2];
+  if (pipe(fds) != 0) return -1;
+
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return -1;
+  }
+
+  if (pid == 0) {
+    close(fds[0]);
+    std::string report;
+    ReplayResult result = {};
+    bool loaded = loadSession(path, periodMs, &replaySession);
+    if (loaded) {
+      // Recorded CSV is filtered already, raw captures get the sketch's filter
+      replayAlpha = alpha >= 0 ? alpha : (replaySession.raw ? DEFAULT_ALPHA : 1.0F);
+      result = replay(stepUs, checkStats, &report);
+      result.alpha = replayAlpha;
+    }
+
+    char header[512];
+    snprintf(header, sizeof(header), "%d\n", loaded ? 1 : 0);
+    std::string message = header;
+    message.append((const char*)&result, sizeof(result));
+    message += report;
+
+    const char* p = message.data();
+    size_t left = message.size();
+    while (left > 0) {
+      ssize_t written = write(fds[1], p, left);
+      if (written <= 0) break;
+      p += written;
+      left -= written;
+    }
+    _exit(0);
+  }
+
+  close(fds[1]);
+  *readFd = fds[0];
+  return pid;
+}
+
+int main(int argc, char** argv) {
+  unsigned long periodMs = SAMPLING_INTERVAL_MS;
+  unsigned long stepUs = 1000;
+  int jobs = 1;
+  bool checkStats = false;
+  bool quiet = false;
+  std::vector<const char*> files;
+  std::vector<float> alphas;
+  std::vector<float> decisionTimes;
+  float hours = 4;
+  bool sequence = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+      periodMs = 1000 / strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+      const char* p = argv[++i];
+      while (*p) {
+        char* end;
+        float alpha = strtof(p, &end);
+        if (end == p || alpha <= 0 || alpha > 1) break;
+        alphas.push_back(alpha);
+        p = (*end == ',') ? end + 1 : end;
+      }
+      if (*p) {
+        files.clear();
+        break;
+      }
+    } else if (strcmp(argv[i], "--step-us") == 0 && i + 1 < argc) {
+      stepUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+      jobs = atoi(argv[++i]);
+      if (jobs < 1) jobs = 1;
+    } else if (strcmp(argv[i], "--check-stats") == 0) {
+      checkStats = true;
+    } else if (strcmp(argv[i], "--quiet") == 0) {
+      quiet = true;
+    } else if (strcmp(argv[i], "--drift") == 0 && i + 1 < argc) {
+      replayDriftPerHour = strtof(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc) {
+      hours = strtof(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--sequence") == 0) {
+      sequence = true;
+    } else if (strcmp(argv[i], "--decision-ms") == 0 && i + 1 < argc) {
+      const char* p = argv[++i];
+      while (*p) {
+        char* end;
+        float decisionMs = strtof(p, &end);
+        if (end == p || decisionMs <= 0) break;
+        decisionTimes.push_back(decisionMs);
+        p = (*end == ',') ? end + 1 : end;
+      }
+      if (*p) {
+        files.clear();
+        break;
+      }
+    } else if (argv[i][0] == '-') {
+      files.clear();
+      break;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+
+  if (files.empty()) {
+    fprintf(stderr, "Usage: %s [--rate HZ] [--alpha A[,B...]] [--step-us N] [--jobs N] [--check-stats] [--quiet] "
+            "[--drift ADC_PER_HOUR [--hours H] | --sequence] [--decision-ms T[,U...]] file.csv|file.bin...\n",
+            argv[0]);
+    return 2;
+  }
+
+  if (replayDriftPerHour != 0 || sequence) {
+    return runDrift(files, sequence ? 0 : hours, periodMs, stepUs, decisionTimes, quiet);
+  }
+  if (!decisionTimes.empty()) replayDecisionMs = decisionTimes[0];
+
+  auto wallStart = std::chrono::steady_clock::now();
+
+  // Every file is replayed once per filter coefficient, one coefficient after the other
+  struct Running { pid_t pid; int fd; const char* path; int alphaIndex; };
+  size_t runCount = files.size() * (alphas.empty() ? 1 : alphas.size());
+
+  // Per-coefficient results of an --alpha sweep
+  struct SweepTotals { unsigned long outputs, correct, inferences, recognizedFiles, labelledFiles; double latencySum; };
+  std::vector<SweepTotals> sweep(alphas.size(), SweepTotals{});
+
+  std::vector<Running> running;
+  size_t next = 0;
+  int failures = 0;
+  unsigned long totalSamples = 0, totalMs = 0, totalOutputs = 0, totalCorrect = 0, totalInferences = 0;
+  unsigned long totalSkipped = 0, totalFastHits = 0, totalFastMismatches = 0, totalFastRight = 0;
+  unsigned long recognizedFiles = 0, labelledFiles = 0;
+  double latencySum = 0, statsMaxError = 0, simdMaxError = 0;
+  unsigned long viewMismatches = 0;
+  int sampleMaxSteps = 0;
+  double pipelineMaxError = 0;
+
+  while (next < runCount || !running.empty()) {
+    // Keep up to 'jobs' replays in flight, collecting them in file order
+    while (next < runCount && (int)running.size() < jobs) {
+      const char* path = files[next % files.size()];
+      int alphaIndex = alphas.empty() ? -1 : (int)(next / files.size());
+      int fd;
+      pid_t pid = startReplay(path, alphaIndex < 0 ? -1.0F : alphas[alphaIndex], periodMs, stepUs, checkStats, &fd);
+      if (pid < 0) {
+        fprintf(stderr, "%s: could not start replay\n", path);
+        failures++;
+      } else {
+        running.push_back({pid, fd, path, alphaIndex});
+      }
+      next++;
+    }
+    if (running.empty()) break;
+
+    Running job = running.front();
+    running.erase(running.begin());
+
+    std::string message;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(job.fd, buf, sizeof(buf))) > 0) message.append(buf, n);
+    close(job.fd);
+    waitpid(job.pid, nullptr, 0);
+
+    size_t newline = message.find('\n');
+    if (newline == std::string::npos || message[0] != '1' || message.size() < newline + 1 + sizeof(ReplayResult)) {
+      fprintf(stderr, "%s: could not be replayed\n", job.path);
+      failures++;
+      continue;
+    }
+
+    ReplayResult result;
+    memcpy(&result, message.data() + newline + 1, sizeof(result));
+    std::string report = message.substr(newline + 1 + sizeof(result));
+    std::string label = csvLabelFromPath(job.path);
+
+    printf("%s (label '%s', %lu samples, %.1f s, alpha %.2f)\n", job.path, label.c_str(), result.samples,
+           result.durationMs / 1000.0, result.alpha);
+    if (!quiet) fputs(report.c_str(), stdout);
+    printf("  outputs %lu, correct %lu, first output %ld ms, first correct %ld ms, inferences %lu",
+           result.outputs, result.correct, result.firstOutputMs, result.firstCorrectMs, result.inferences);
+    if (checkStats) printf(", stats error %.2e, simd error %.2e", result.statsMaxError, result.simdMaxError);
+#ifdef USE_CASCADE
+    printf(", first stage %lu", result.fastHits);
+#endif
+    printf("\n");
+
+    totalSamples += result.samples;
+    totalMs += result.durationMs;
+    totalOutputs += result.outputs;
+    totalCorrect += result.correct;
+    totalInferences += result.inferences;
+    totalSkipped += result.skipped;
+    totalFastHits += result.fastHits;
+    totalFastMismatches += result.fastMismatches;
+    totalFastRight += result.fastRight;
+    if (result.statsMaxError > statsMaxError) statsMaxError = result.statsMaxError;
+    if (result.simdMaxError > simdMaxError) simdMaxError = result.simdMaxError;
+    viewMismatches += result.viewMismatches;
+    sampleMaxSteps = std::max(sampleMaxSteps, result.sampleMaxSteps);
+    pipelineMaxError = std::max(pipelineMaxError, result.pipelineMaxError);
+    bool knownLabel = false;
+    for (size_t i = 0; i < sizeof(GESTURE_LABELS) / sizeof(GESTURE_LABELS[0]); i++) {
+      if (label == GESTURE_LABELS[i]) knownLabel = true;
+    }
+    if (knownLabel) {
+      labelledFiles++;
+      if (result.firstCorrectMs >= 0) {
+        recognizedFiles++;
+        latencySum += result.firstCorrectMs;
+      }
+    }
+
+    if (job.alphaIndex >= 0) {
+      SweepTotals& totals = sweep[job.alphaIndex];
+      totals.outputs += result.outputs;
+      totals.correct += result.correct;
+      totals.inferences += result.inferences;
+      if (knownLabel) {
+        totals.labelledFiles++;
+        if (result.firstCorrectMs >= 0) {
+          totals.recognizedFiles++;
+          totals.latencySum += result.firstCorrectMs;
+        }
+      }
+    }
+  }
+
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+  if (sweep.size() > 1) {
+    printf("\n--- alpha sweep (window %d samples) ---\n", WINDOW_SIZE);
+    printf("  alpha  recognized  first correct(ms)  outputs  correct  inferences\n");
+    for (size_t i = 0; i < sweep.size(); i++) {
+      const SweepTotals& totals = sweep[i];
+      printf("  %5.2f  %5lu/%-5lu %17.1f %8lu %7.1f%% %11lu\n", alphas[i], totals.recognizedFiles, totals.labelledFiles,
+             totals.recognizedFiles ? totals.latencySum / totals.recognizedFiles : 0, totals.outputs,
+             totals.outputs ? 100.0 * totals.correct / totals.outputs : 0, totals.inferences);
+    }
+  }
+
+  printf("\n--- replay summary ---\n");
+  printf("files              %zu (%d failed), %zu replays\n", files.size(), failures, runCount);
+  printf("window             %d samples\n", WINDOW_SIZE);
+  printf("recorded time      %.1f s, %lu samples\n", totalMs / 1000.0, totalSamples);
+  printf("wall time          %.3f s (%.0fx real time)\n", wallSeconds, wallSeconds > 0 ? totalMs / 1000.0 / wallSeconds : 0);
+#ifdef USE_MOTION_TRIGGER
+  printf("inferences         %lu (%lu skipped by the motion trigger)\n", totalInferences, totalSkipped);
+#else
+  printf("inferences         %lu\n", totalInferences);
+#endif
+  printf("outputs            %lu, %lu matching the file label (%.1f%%)\n", totalOutputs, totalCorrect,
+         totalOutputs ? 100.0 * totalCorrect / totalOutputs : 0);
+  printf("recognized files   %lu of %lu labelled\n", recognizedFiles, labelledFiles);
+  printf("mean first correct %.1f ms\n", recognizedFiles ? latencySum / recognizedFiles : 0);
+  printCascadeSummary(totalFastHits, totalInferences, totalFastMismatches, totalFastRight);
+  if (checkStats) {
+#if defined(USE_FIXED_POINT)
+    // The Q31 filter state rounds to the nearest Q15 step, where the float filter keeps every bit - exact with
+    // ALPHA = 1.0, as the bend table holds Q15 steps. A step moves the skewness and kurtosis of a window that
+    // barely varies a long way, so the features are only compared with the float pipeline's, not checked
+    printf("window samples     %d Q15 steps at most from the float pipeline's\n", sampleMaxSteps);
+    printf("float pipeline     %.2e largest feature difference\n", pipelineMaxError);
+    if (sampleMaxSteps > 1) failures++;
+#else
+    (void)sampleMaxSteps;
+    (void)pipelineMaxError;
+#endif
+    printf("stats max error    %.2e (%s vs two-pass)\n", statsMaxError, FEATURE_PATH_NAME);
+    printf("simd max error     %.2e (%s kernels vs two-pass)\n", simdMaxError, WINDOW_SIMD_NAME);
+    if (statsMaxError > STATS_TOLERANCE || simdMaxError > STATS_TOLERANCE) {
+      printf("statistics differ from the reference by more than %.0e\n", STATS_TOLERANCE);
+      failures++;
+    }
+    printf("model input view   %lu mismatching reads (float and int8)\n", viewMismatches);
+    if (viewMismatches > 0) failures++;
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,577 @@
+/*
+ * glove_temporal.cpp - Train and benchmark the streaming temporal model on recorded captures
+ *
+ * Trains the dilated causal convolution stack of temporal.h on the filtered
+ * sample stream of the captures - every sensor channel, as the sketch
+ * filters it - to give the capture's label at every sample. Besides each
+ * capture on its own, it learns from streams where a capture follows the
+ * tail of one with another label, since a gesture is always entered from
+ * somewhere; the first TRANSITION_GRACE samples after the change are left
+ * out of the loss. The network is trained with Adam on chunks of the
+ * streams, the loss at every sample of a chunk after the receptive field.
+ * --write stores it as temporal_model.h.
+ *
+ * --check runs the network compiled into temporal_model.h over the files
+ * played back to back, in the order given, and reports:
+ *   per sample   time of stepTemporalModel() (the cached layer state) and
+ *                of temporalWindowScores() (the receptive field recomputed),
+ *                and the largest score difference between the two once
+ *                the first receptive field has passed
+ *   accuracy     samples whose top label is the playing file's, all and
+ *                after the first 1500 ms of a file
+ *   latency      time from each change of file to the first sample whose
+ *                top label is the new one
+ *
+ * The captures are read with sessionFrames() (csv_session.h): flex readings
+ * go through the sketch's bend table, and binary telemetry captures (.bin),
+ * which hold unfiltered readings, through the FLEX_FILTER and IMU_FILTER
+ * chains of config.h.
+ *
+ * Usage: glove_temporal [--rate HZ] [--epochs N] [--learning-rate R] [--seed N] [--check] [--write FILE]
+ *                       file.bin|file.csv...
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "temporal.h"
+#include "csv_session.h"
+#include "telemetry_decoder.h"
+
+// Convolution stack: width, kernel and the dilation of each layer
+static const int CONV_WIDTH = 12;
+static const int CONV_KERNEL = 3;
+static const int CONV_DILATIONS[] = {1, 2, 4, 8, 16};
+static const int CONV_LAYERS = sizeof(CONV_DILATIONS) / sizeof(CONV_DILATIONS[0]);
+
+// Samples of a training chunk the loss is taken at, after the receptive field
+static const int CHUNK_TARGETS = 64;
+
+// Transition streams per capture, samples of the previous capture they start with, and the samples
+// after the change left out of the loss
+static const int TRANSITIONS_PER_CAPTURE = 3;
+static const int TRANSITION_TAIL = 100;
+static const int TRANSITION_GRACE = 10;
+
+// Time into a file before its samples count as settled
+static const unsigned long SETTLE_MS = 1500;
+
+// Filtered channel values of a capture, as the sketch sees them
+struct Capture {
+  std::vector<std::vector<float>> frames;
+  int label;
+};
+
+// Frames to learn from, with the label of each (-1: left out of the loss)
+struct Stream {
+  std::vector<const std::vector<float>*> frames;
+  std::vector<int> labels;
+};
+
+// Float convolution layer, [outputs][kernel][inputs] like TemporalConvLayer, with its Adam moments
+struct FloatConv {
+  int inputs, outputs, dilation, span;
+  std::vector<float> weights, bias;
+  std::vector<float> mWeights, vWeights, mBias, vBias;
+};
+
+struct FloatNetwork {
+  std::vector<float> inputMean, inputScale;
+  std::vector<FloatConv> layers;
+  FloatConv head;   // Kernel 1 over the last layer's newest output, no ReLU
+};
+
+static void initLayer(FloatConv* layer, int inputs, int outputs, int kernel, int dilation, std::mt19937* rng) {
+  layer->inputs = inputs;
+  layer->outputs = outputs;
+  layer->dilation = dilation;
+  layer->span = (kernel - 1) * dilation + 1;
+  std::normal_distribution<float> init(0, sqrtf(2.0F / (inputs * kernel)));   // He initialization
+  for (int i = 0; i < outputs * kernel * inputs; i++) layer->weights.push_back(init(*rng));
+  layer->bias.assign(outputs, 0);
+  layer->mWeights.assign(layer->weights.size(), 0);
+  layer->vWeights.assign(layer->weights.size(), 0);
+  layer->mBias.assign(outputs, 0);
+  layer->vBias.assign(outputs, 0);
+}
+
+static int kernelOf(const FloatConv& layer) {
+  return (int)layer.weights.size() / (layer.outputs * layer.inputs);
+}
+
+/**
+ * @brief Valid causal convolution over a sequence of length rows: output row t is input row t + span - 1
+ */
+static void convForward(const FloatConv& layer, const std::vector<float>& in, int length, bool relu,
+                        std::vector<float>* out) {
+  int kernel = kernelOf(layer);
+  int outLength = length - (layer.span - 1);
+  out->assign((size_t)outLength * layer.outputs, 0);
+  for (int t = 0; t < outLength; t++) {
+    int newest = t + layer.span - 1;
+    for (int o = 0; o < layer.outputs; o++) {
+      float acc = layer.bias[o];
+      const float* w = &layer.weights[(size_t)o * kernel * layer.inputs];
+      for (int tap = 0; tap < kernel; tap++) {
+        const float* x = &in[(size_t)(newest - tap * layer.dilation) * layer.inputs];
+        for (int i = 0; i < layer.inputs; i++) acc += w[i] * x[i];
+        w += layer.inputs;
+      }
+      (*out)[(size_t)t * layer.outputs + o] = (relu && acc < 0) ? 0 : acc;
+    }
+  }
+}
+
+/**
+ * @brief Gradients of a convolution from the gradient of its output, adding to the layer's gradients
+ */
+static void convBackward(const FloatConv& layer, const std::vector<float>& in, const std::vector<float>& out,
+                         std::vector<float>& gradOut, bool relu, std::vector<float>* gradIn,
+                         std::vector<float>* gradWeights, std::vector<float>* gradBias) {
+  int kernel = kernelOf(layer);
+  int outLength = (int)(out.size() / layer.outputs);
+  gradIn->assign(in.size(), 0);
+  for (int t = 0; t < outLength; t++) {
+    int newest = t + layer.span - 1;
+    for (int o = 0; o < layer.outputs; o++) {
+      float g = gradOut[(size_t)t * layer.outputs + o];
+      if (relu && out[(size_t)t * layer.outputs + o] <= 0) g = 0;
+      if (g == 0) continue;
+      (*gradBias)[o] += g;
+      size_t w = (size_t)o * kernel * layer.inputs;
+      for (int tap = 0; tap < kernel; tap++) {
+        size_t x = (size_t)(newest - tap * layer.dilation) * layer.inputs;
+        for (int i = 0; i < layer.inputs; i++) {
+          (*gradWeights)[w + i] += g * in[x + i];
+          (*gradIn)[x + i] += g * layer.weights[w + i];
+        }
+        w += layer.inputs;
+      }
+    }
+  }
+}
+
+static int receptiveField(const FloatNetwork& network) {
+  int field = 1;
+  for (const FloatConv& layer : network.layers) field += layer.span - 1;
+  return field;
+}
+
+static void adamStep(FloatConv* layer, const std::vector<float>& gradWeights, const std::vector<float>& gradBias,
+                     float learningRate, int t, float batch) {
+  const float beta1 = 0.9F, beta2 = 0.999F, epsilon = 1e-7F;
+  float correction1 = 1 - powf(beta1, (float)t), correction2 = 1 - powf(beta2, (float)t);
+  auto step = [&](float& value, float& m, float& v, float gradient) {
+    gradient /= batch;
+    m = beta1 * m + (1 - beta1) * gradient;
+    v = beta2 * v + (1 - beta2) * gradient * gradient;
+    value -= learningRate * (m / correction1) / (sqrtf(v / correction2) + epsilon);
+  };
+  for (size_t i = 0; i < layer->weights.size(); i++) {
+    step(layer->weights[i], layer->mWeights[i], layer->vWeights[i], gradWeights[i]);
+  }
+  for (size_t i = 0; i < layer->bias.size(); i++) step(layer->bias[i], layer->mBias[i], layer->vBias[i], gradBias[i]);
+}
+
+/**
+ * @brief Train on chunks of the streams, returning the share of the scored samples classified right in the last epoch
+ */
+static double train(FloatNetwork* network, const std::vector<Stream>& streams, int labelCount, int epochs,
+                    float learningRate, std::mt19937* rng) {
+  int field = receptiveField(*network);
+
+  // Chunk starts: the receptive field before CHUNK_TARGETS scored positions
+  std::vector<std::pair<size_t, size_t>> chunks;
+  for (size_t s = 0; s < streams.size(); s++) {
+    for (size_t start = 0; start + field < streams[s].frames.size(); start += CHUNK_TARGETS) {
+      chunks.push_back(std::make_pair(s, start));
+    }
+  }
+
+  double accuracy = 0;
+  int t = 0;
+  size_t layerCount = network->layers.size();
+  for (int epoch = 0; epoch < epochs; epoch++) {
+    std::shuffle(chunks.begin(), chunks.end(), *rng);
+    unsigned long scored = 0, correct = 0;
+    for (const auto& chunk : chunks) {
+      const Stream& stream = streams[chunk.first];
+      int length = (int)std::min(stream.frames.size() - chunk.second, (size_t)(field - 1 + CHUNK_TARGETS));
+
+      // Forward, keeping every layer's output
+      std::vector<std::vector<float>> activations(layerCount + 2);
+      std::vector<float>& input = activations[0];
+      for (int i = 0; i < length; i++) {
+        const std::vector<float>& frame = *stream.frames[chunk.second + i];
+        for (int ch = 0; ch < TEMPORAL_INPUT_COUNT; ch++) {
+          input.push_back((frame[ch] - network->inputMean[ch]) * network->inputScale[ch]);
+        }
+      }
+      int rows = length;
+      for (size_t l = 0; l < layerCount; l++) {
+        convForward(network->layers[l], activations[l], rows, true, &activations[l + 1]);
+        rows -= network->layers[l].span - 1;
+      }
+      convForward(network->head, activations[layerCount], rows, false, &activations[layerCount + 1]);
+
+      // Softmax cross-entropy at every scored position
+      std::vector<float>& logits = activations[layerCount + 1];
+      std::vector<float> gradient(logits.size(), 0);
+      float batch = 0;
+      for (int r = 0; r < rows; r++) {
+        int label = stream.labels[chunk.second + r + field - 1];
+        if (label < 0) continue;
+        float* z = &logits[(size_t)r * labelCount];
+        float maxLogit = *std::max_element(z, z + labelCount), total = 0;
+        int best = 0;
+        for (int i = 0; i < labelCount; i++) {
+          total += expf(z[i] - maxLogit);
+          if (z[i] > z[best]) best = i;
+        }
+        for (int i = 0; i < labelCount; i++) {
+          gradient[(size_t)r * labelCount + i] = expf(z[i] - maxLogit) / total - (i == label ? 1 : 0);
+        }
+        batch++;
+        scored++;
+        if (best == label) correct++;
+      }
+      if (batch == 0) continue;
+
+      // Back through the head and the stack
+      t++;
+      std::vector<float> gradIn, gradWeights(network->head.weights.size(), 0), gradBias(labelCount, 0);
+      convBackward(network->head, activations[layerCount], logits, gradient, false, &gradIn, &gradWeights, &gradBias);
+      adamStep(&network->head, gradWeights, gradBias, learningRate, t, batch);
+      for (size_t l = layerCount; l-- > 0;) {
+        FloatConv& layer = network->layers[l];
+        std::vector<float> gradOut;
+        gradOut.swap(gradIn);
+        std::vector<float> layerGradWeights(layer.weights.size(), 0), layerGradBias(layer.outputs, 0);
+        convBackward(layer, activations[l], activations[l + 1], gradOut, true, &gradIn, &layerGradWeights,
+                     &layerGradBias);
+        adamStep(&layer, layerGradWeights, layerGradBias, learningRate, t, batch);
+      }
+    }
+    accuracy = scored ? (double)correct / scored : 0;
+  }
+  return accuracy;
+}
+
+static void writeArray(FILE* file, const char* name, const std::vector<float>& values, int perLine) {
+  fprintf(file, "const float %s[%zu] = {", name, values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    // Always a floating literal, so the F suffix is valid
+    char literal[32];
+    snprintf(literal, sizeof(literal), "%.7g", values[i]);
+    if (!strpbrk(literal, ".en")) strcat(literal, ".0");
+    fprintf(file, "%s%s%sF", i ? "," : "", (i % perLine) ? " " : "\n  ", literal);
+  }
+  fprintf(file, "\n};\n\n");
+}
+
+static bool writeModel(const char* path, const FloatNetwork& network, const std::vector<std::string>& labels,
+                       size_t files) {
+  FILE* file = fopen(path, "w");
+  if (!file) return false;
+
+  int maxWidth = TEMPORAL_INPUT_COUNT, stateFloats = 0;
+  for (const FloatConv& layer : network.layers) {
+    maxWidth = std::max(maxWidth, layer.outputs);
+    stateFloats += layer.span * layer.inputs;
+  }
+
+  fprintf(file, "/*\n");
+  fprintf(file, " * temporal_model.h - Streaming Temporal Model Weights\n");
+  fprintf(file, " *\n");
+  fprintf(file, " * Generated by host/glove_temporal from %zu captures - do not edit. Causal\n", files);
+  fprintf(file, " * convolutions of width %d and kernel %d with dilations", CONV_WIDTH, CONV_KERNEL);
+  for (int l = 0; l < CONV_LAYERS; l++) fprintf(file, "%s %d", l == 0 ? "" : (l + 1 < CONV_LAYERS ? "," : " and"),
+                                                 CONV_DILATIONS[l]);
+  fprintf(file, ",\n * a receptive field of %d samples.\n", receptiveField(network));
+  fprintf(file, " */\n\n");
+  fprintf(file, "#ifndef TEMPORAL_MODEL_H\n#define TEMPORAL_MODEL_H\n\n");
+  fprintf(file, "#define TEMPORAL_INPUT_COUNT %d\n", TEMPORAL_INPUT_COUNT);
+  fprintf(file, "#define TEMPORAL_LABEL_COUNT %zu\n", labels.size());
+  fprintf(file, "#define TEMPORAL_MAX_WIDTH %d\n", maxWidth);
+  fprintf(file, "#define TEMPORAL_RECEPTIVE_FIELD %d\n", receptiveField(network));
+  fprintf(file, "#define TEMPORAL_STATE_FLOATS %d   // Input rings of the layers\n\n", stateFloats);
+  fprintf(file, "const char* const TEMPORAL_LABELS[TEMPORAL_LABEL_COUNT] = {");
+  for (size_t i = 0; i < labels.size(); i++) fprintf(file, "%s\"%s\"", i ? ", " : "", labels[i].c_str());
+  fprintf(file, "};\n\n");
+
+  writeArray(file, "TEMPORAL_INPUT_MEAN", network.inputMean, 6);
+  writeArray(file, "TEMPORAL_INPUT_SCALE", network.inputScale, 6);
+  for (size_t l = 0; l < network.layers.size(); l++) {
+    char name[48];
+    snprintf(name, sizeof(name), "TEMPORAL_WEIGHTS_%zu", l);
+    writeArray(file, name, network.layers[l].weights, 8);
+    snprintf(name, sizeof(name), "TEMPORAL_BIAS_%zu", l);
+    writeArray(file, name, network.layers[l].bias, 8);
+  }
+  writeArray(file, "TEMPORAL_HEAD_WEIGHTS", network.head.weights, 8);
+  writeArray(file, "TEMPORAL_HEAD_BIAS", network.head.bias, 8);
+
+  fprintf(file, "const TemporalConvLayer TEMPORAL_LAYERS[] = {\n");
+  int offset = 0;
+  for (size_t l = 0; l < network.layers.size(); l++) {
+    const FloatConv& layer = network.layers[l];
+    fprintf(file, "  {%d, %d, %d, %d, %d, %d, TEMPORAL_WEIGHTS_%zu, TEMPORAL_BIAS_%zu},\n", layer.inputs, layer.outputs,
+            kernelOf(layer), layer.dilation, layer.span, offset, l, l);
+    offset += layer.span * layer.inputs;
+  }
+  fprintf(file, "};\n\n");
+  fprintf(file, "const TemporalModel TEMPORAL_MODEL = {\n");
+  fprintf(file, "  TEMPORAL_LAYERS, %zu,\n", network.layers.size());
+  fprintf(file, "  TEMPORAL_INPUT_MEAN, TEMPORAL_INPUT_SCALE,\n");
+  fprintf(file, "  TEMPORAL_HEAD_WEIGHTS, TEMPORAL_HEAD_BIAS,\n");
+  fprintf(file, "  TEMPORAL_LABELS\n");
+  fprintf(file, "};\n\n");
+  fprintf(file, "#endif // TEMPORAL_MODEL_H\n");
+  fclose(file);
+  return true;
+}
+
+/**
+ * @brief Run the compiled model over the captures back to back and print cost, accuracy and latency
+ */
+static void checkModel(const std::vector<Capture>& captures, unsigned long periodMs) {
+  typedef std::chrono::steady_clock Clock;
+  const int field = TEMPORAL_RECEPTIVE_FIELD;
+
+  // Input history of the recompute, starting out at the channel means as the streaming state does
+  std::vector<float> history((size_t)field * TEMPORAL_INPUT_COUNT);
+  for (int t = 0; t < field; t++) {
+    for (int ch = 0; ch < TEMPORAL_INPUT_COUNT; ch++) history[(size_t)t * TEMPORAL_INPUT_COUNT + ch] = TEMPORAL_MODEL.inputMean[ch];
+  }
+
+  initTemporalModel();
+  double streamNs = 0, recomputeNs = 0, maxDifference = 0, latencySumMs = 0;
+  unsigned long samples = 0, correct = 0, settledSamples = 0, settledCorrect = 0, changes = 0, recognized = 0;
+  unsigned long latencyMaxMs = 0;
+  float values[TEMPORAL_INPUT_COUNT], scores[TEMPORAL_LABEL_COUNT];
+  const float* pointers[TEMPORAL_INPUT_COUNT];
+  for (int ch = 0; ch < TEMPORAL_INPUT_COUNT; ch++) pointers[ch] = &values[ch];
+
+  for (size_t c = 0; c < captures.size(); c++) {
+    const Capture& capture = captures[c];
+    bool change = c > 0 && capture.label != captures[c - 1].label;
+    bool found = false;
+    if (change) changes++;
+
+    for (size_t n = 0; n < capture.frames.size(); n++) {
+      memcpy(values, capture.frames[n].data(), sizeof(values));
+
+      Clock::time_point start = Clock::now();
+      stepTemporalModel(pointers);
+      Clock::time_point stepped = Clock::now();
+      memmove(history.data(), history.data() + TEMPORAL_INPUT_COUNT, (field - 1) * TEMPORAL_INPUT_COUNT * sizeof(float));
+      memcpy(history.data() + (size_t)(field - 1) * TEMPORAL_INPUT_COUNT, values, sizeof(values));
+      temporalWindowScores(history.data(), scores);
+      Clock::time_point recomputed = Clock::now();
+      streamNs += std::chrono::duration<double, std::nano>(stepped - start).count();
+      recomputeNs += std::chrono::duration<double, std::nano>(recomputed - stepped).count();
+
+      // The deeper rings start out empty rather than holding the layers' response to the channel means,
+      // so the two agree once the first receptive field has passed
+      int best = 0;
+      for (int i = 0; i < TEMPORAL_LABEL_COUNT; i++) {
+        if (temporal.steps >= (uint32_t)field) {
+          maxDifference = std::max(maxDifference, (double)fabsf(scores[i] - temporal.scores[i]));
+        }
+        if (temporal.scores[i] > temporal.scores[best]) best = i;
+      }
+      samples++;
+      if (best == capture.label) correct++;
+      if (n * periodMs >= SETTLE_MS) {
+        settledSamples++;
+        if (best == capture.label) settledCorrect++;
+      }
+      if (change && !found && best == capture.label) {
+        found = true;
+        recognized++;
+        unsigned long latencyMs = n * periodMs;
+        latencySumMs += latencyMs;
+        latencyMaxMs = std::max(latencyMaxMs, latencyMs);
+      }
+    }
+  }
+
+  printf("per sample         stepTemporalModel %.1f ns, temporalWindowScores (%d samples) %.1f ns, %.1fx\n",
+         streamNs / samples, field, recomputeNs / samples, recomputeNs / streamNs);
+  printf("state              %zu bytes, largest score difference from the recompute %.2e\n",
+         sizeof(temporal.history), maxDifference);
+  printf("accuracy           %.1f%% of %lu samples, %.1f%% of %lu after the first %lu ms of a file\n",
+         100.0 * correct / samples, samples, settledSamples ? 100.0 * settledCorrect / settledSamples : 0,
+         settledSamples, SETTLE_MS);
+  printf("latency            %lu of %lu gesture changes, top label after mean %.0f ms, max %lu ms\n", recognized,
+         changes, recognized ? latencySumMs / recognized : 0, latencyMaxMs);
+}
+
+int main(int argc, char** argv) {
+  unsigned long periodMs = SAMPLING_INTERVAL_MS;
+  int epochs = 30;
+  float learningRate = 0.002F;
+  unsigned seed = 1;
+  bool check = false;
+  const char* writePath = nullptr;
+  std::vector<const char*> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+      periodMs = 1000 / strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--epochs") == 0 && i + 1 < argc) {
+      epochs = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--learning-rate") == 0 && i + 1 < argc) {
+      learningRate = strtof(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--check") == 0) {
+      check = true;
+    } else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+      writePath = argv[++i];
+    } else if (argv[i][0] == '-') {
+      files.clear();
+      break;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+
+  if (files.empty()) {
+    fprintf(stderr, "Usage: %s [--rate HZ] [--epochs N] [--learning-rate R] [--seed N] [--check] [--write FILE] "
+            "file.bin|file.csv...\n", argv[0]);
+    return 2;
+  }
+
+  // Labels in alphabetical order - or the compiled model's with --check
+  std::vector<CsvSession> sessions(files.size());
+  std::map<std::string, int> labelIndex;
+  for (size_t i = 0; i < files.size(); i++) {
+    size_t length = strlen(files[i]);
+    bool loaded = (length > 4 && strcmp(files[i] + length - 4, ".bin") == 0)
+                    ? loadTelemetrySession(files[i], &sessions[i])
+                    : loadCsvSession(files[i], periodMs, &sessions[i]);
+    if (!loaded || sessions[i].samples.empty()) {
+      fprintf(stderr, "%s: could not be loaded\n", files[i]);
+      return 1;
+    }
+    labelIndex[sessions[i].label] = 0;
+  }
+  std::vector<std::string> labels;
+  if (check) {
+    labelIndex.clear();
+    for (int i = 0; i < TEMPORAL_LABEL_COUNT; i++) {
+      labelIndex[TEMPORAL_MODEL.labels[i]] = i;
+      labels.push_back(TEMPORAL_MODEL.labels[i]);
+    }
+  } else {
+    for (auto& entry : labelIndex) {
+      entry.second = (int)labels.size();
+      labels.push_back(entry.first);
+    }
+  }
+
+  std::vector<Capture> captures;
+  size_t frameCount = 0;
+  for (const CsvSession& session : sessions) {
+    auto label = labelIndex.find(session.label);
+    if (label == labelIndex.end()) {
+      fprintf(stderr, "%s: label '%s' is not in the model\n", session.path.c_str(), session.label.c_str());
+      return 1;
+    }
+    Capture capture;
+    capture.frames = sessionFrames(session);
+    capture.label = label->second;
+    captures.push_back(capture);
+    frameCount += session.samples.size();
+  }
+  printf("%zu captures, %zu samples, %d channels, %zu labels\n", captures.size(), frameCount, TEMPORAL_INPUT_COUNT,
+         labels.size());
+
+  if (check) {
+    printf("\n--- compiled model (temporal_model.h, receptive field %d samples) ---\n", TEMPORAL_RECEPTIVE_FIELD);
+    checkModel(captures, periodMs);
+    return 0;
+  }
+
+  std::mt19937 rng(seed);
+  FloatNetwork network;
+  network.inputMean.assign(TEMPORAL_INPUT_COUNT, 0);
+  network.inputScale.assign(TEMPORAL_INPUT_COUNT, 1);
+  for (int ch = 0; ch < TEMPORAL_INPUT_COUNT; ch++) {
+    double sum = 0, sum2 = 0;
+    for (const Capture& capture : captures) {
+      for (const std::vector<float>& frame : capture.frames) {
+        sum += frame[ch];
+        sum2 += (double)frame[ch] * frame[ch];
+      }
+    }
+    double mean = sum / frameCount;
+    double stdev = sqrt(std::max(sum2 / frameCount - mean * mean, 0.0));
+    network.inputMean[ch] = (float)mean;
+    network.inputScale[ch] = stdev > 1e-6 ? (float)(1 / stdev) : 1;
+  }
+  int inputs = TEMPORAL_INPUT_COUNT;
+  for (int dilation : CONV_DILATIONS) {
+    network.layers.push_back(FloatConv());
+    initLayer(&network.layers.back(), inputs, CONV_WIDTH, CONV_KERNEL, dilation, &rng);
+    inputs = CONV_WIDTH;
+  }
+  initLayer(&network.head, inputs, (int)labels.size(), 1, 1, &rng);
+  int field = receptiveField(network);
+
+  // Each capture from a still start, as after setup(), and entered from the tail of captures with other labels
+  std::vector<Stream> streams;
+  for (size_t c = 0; c < captures.size(); c++) {
+    const Capture& capture = captures[c];
+    Stream alone;
+    for (int i = 0; i < field - 1; i++) {
+      alone.frames.push_back(&capture.frames[0]);
+      alone.labels.push_back(capture.label);
+    }
+    for (const std::vector<float>& frame : capture.frames) {
+      alone.frames.push_back(&frame);
+      alone.labels.push_back(capture.label);
+    }
+    streams.push_back(alone);
+
+    std::vector<size_t> others;
+    for (size_t o = 0; o < captures.size(); o++) {
+      if (captures[o].label != capture.label && captures[o].frames.size() >= (size_t)TRANSITION_TAIL) others.push_back(o);
+    }
+    for (int k = 0; k < TRANSITIONS_PER_CAPTURE && !others.empty(); k++) {
+      const Capture& previous = captures[others[rng() % others.size()]];
+      Stream transition;
+      for (size_t n = previous.frames.size() - TRANSITION_TAIL; n < previous.frames.size(); n++) {
+        transition.frames.push_back(&previous.frames[n]);
+        transition.labels.push_back(previous.label);
+      }
+      for (size_t n = 0; n < capture.frames.size(); n++) {
+        transition.frames.push_back(&capture.frames[n]);
+        transition.labels.push_back(n < (size_t)TRANSITION_GRACE ? -1 : capture.label);
+      }
+      streams.push_back(transition);
+    }
+  }
+
+  double accuracy = train(&network, streams, (int)labels.size(), epochs, learningRate, &rng);
+  printf("\n--- trained model (%d epochs, learning rate %g, receptive field %d samples) ---\n", epochs, learningRate,
+         field);
+  printf("training accuracy  %.2f%% of the scored samples of %zu streams in the last epoch\n", 100.0 * accuracy,
+         streams.size());
+
+  if (writePath) {
+    if (!writeModel(writePath, network, labels, files.size())) {
+      fprintf(stderr, "Could not write %s\n", writePath);
+      return 1;
+    }
+    printf("\nModel written to %s - rebuild and run with --check\n", writePath);
+  }
+  return 0;
+}
@@ -0,0 +1,280 @@
+/*
+ * Arduino.h - Host shim of the Arduino core API
+ *
+ * Provides the subset of the Arduino API used by the sketches (pins, timing,
+ * String, Print and Serial) on top of host_hal.h so they build on Linux
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+#include "host_hal.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define PI 3.1415926535897932384626433832795
+
+// Nano 33 BLE analog pins and built-in LED
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+#define LED_BUILTIN 13
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+template <class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+  return (b < a) ? b : a;
+}
+
+template <class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+  return (a < b) ? b : a;
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// Timing ---------------------------------------------------
+
+inline unsigned long millis() {
+  return (unsigned long)(hostTimeUs / 1000ULL);
+}
+
+inline unsigned long micros() {
+  return (unsigned long)hostTimeUs;
+}
+
+inline void delay(unsigned long ms) {
+  hostDelayCount++;
+  hostAdvanceMs(ms);
+}
+
+inline void delayMicroseconds(unsigned int us) {
+  hostAdvanceUs(us);
+}
+
+// Pins -----------------------------------------------------
+
+inline void pinMode(int pin, int mode) {
+  if (pin >= 0 && pin < HOST_PIN_COUNT) hostPinModes[pin] = mode;
+}
+
+inline void digitalWrite(int pin, int value) {
+  if (pin >= 0 && pin < HOST_PIN_COUNT) hostDigitalValues[pin] = value ? HIGH : LOW;
+}
+
+inline int digitalRead(int pin) {
+  return (pin >= 0 && pin < HOST_PIN_COUNT) ? hostDigitalValues[pin] : LOW;
+}
+
+inline void analogReadResolution(int) {}
+
+inline int analogRead(int pin) {
+  hostAnalogReadCount++;
+  if (hostAdcScript) return hostAdcScript(pin, micros());
+  return (pin >= 0 && pin < HOST_PIN_COUNT) ? hostAnalogValues[pin] : 0;
+}
+
+// String ---------------------------------------------------
+
+// Like Arduino's String, every non-empty value lives in a heap buffer (never in the small-string
+// buffer of std::string), so host allocation counts match the board
+class String {
+public:
+  String() {}
+  String(const char* s) : str(s ? s : "") { keepOnHeap(); }
+  String(const std::string& s) : str(s) { keepOnHeap(); }
+  String(char c) : str(1, c) { keepOnHeap(); }
+  String(int v) : str(std::to_string(v)) { keepOnHeap(); }
+  String(unsigned int v) : str(std::to_string(v)) { keepOnHeap(); }
+  String(long v) : str(std::to_string(v)) { keepOnHeap(); }
+  String(unsigned long v) : str(std::to_string(v)) { keepOnHeap(); }
+  String(float v, int digits = 2) { format(v, digits); }
+  String(double v, int digits = 2) { format(v, digits); }
+  String(const String& s) : str(s.str) { keepOnHeap(); }
+  String(String&& s) noexcept : str(std::move(s.str)) {}
+
+  String& operator=(const String& s) { str = s.str; keepOnHeap(); return *this; }
+  String& operator=(String&& s) noexcept { str.swap(s.str); return *this; }
+
+  const char* c_str() const { return str.c_str(); }
+  unsigned int length() const { return str.length(); }
+  char operator[](unsigned int i) const { return i < str.length() ? str[i] : 0; }
+  char charAt(unsigned int i) const { return (*this)[i]; }
+
+  void trim() {
+    size_t start = str.find_first_not_of(" \t\r\n");
+    size_t end = str.find_last_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+      str.clear();
+    } else {
+      str.erase(end + 1);
+      str.erase(0, start);
+    }
+  }
+
+  bool startsWith(const String& s) const { return str.compare(0, s.str.length(), s.str) == 0; }
+  bool equals(const String& s) const { return str == s.str; }
+  bool equalsIgnoreCase(const String& s) const { return strcasecmp(str.c_str(), s.str.c_str()) == 0; }
+  int indexOf(char c) const { size_t i = str.find(c); return i == std::string::npos ? -1 : (int)i; }
+  String substring(unsigned int from) const { return from < str.length() ? String(str.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    return from < str.length() ? String(str.substr(from, to - from)) : String();
+  }
+  long toInt() const { return atol(str.c_str()); }
+  float toFloat() const { return atof(str.c_str()); }
+
+  String& operator+=(const String& s) { str += s.str; keepOnHeap(); return *this; }
+  friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+  friend String operator+(const String& a, const char* b) { return String(a.str + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.str); }
+  bool operator==(const String& s) const { return str == s.str; }
+  bool operator==(const char* s) const { return str == s; }
+  bool operator!=(const String& s) const { return str != s.str; }
+  bool operator!=(const char* s) const { return str != s; }
+
+private:
+  void format(double v, int digits) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    str = buf;
+    keepOnHeap();
+  }
+
+  void keepOnHeap() {
+    const size_t smallStringCapacity = std::string().capacity();
+    if (!str.empty() && str.capacity() <= smallStringCapacity) str.reserve(smallStringCapacity + 1);
+  }
+
+  std::string str;
+};
+
+// Print ----------------------------------------------------
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t write(const uint8_t* buf, size_t size) {
+    for (size_t i = 0; i < size; i++) write(buf[i]);
+    return size;
+  }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC) {
+    if (base == DEC) return printFormatted("%ld", v);
+    return print((unsigned long)v, base);
+  }
+  size_t print(unsigned long v, int base = DEC) {
+    if (base == HEX) return printFormatted("%lX", v);
+    if (base == BIN) {
+      char buf[8 * sizeof(long) + 1];
+      char* p = &buf[sizeof(buf) - 1];
+      *p = '\0';
+      do { *--p = '0' + (v & 1); v >>= 1; } while (v);
+      return write(p);
+    }
+    return printFormatted("%lu", v);
+  }
+  size_t print(double v, int digits = 2) { return printFormatted("%.*f", digits, v); }
+
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(const T& v, int f) { size_t n = print(v, f); return n + println(); }
+
+private:
+  template <class... Args> size_t printFormatted(const char* fmt, Args... args) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), fmt, args...);
+    return write(buf);
+  }
+};
+
+// Serial ---------------------------------------------------
+
+/**
+ * @brief In-memory serial port - RX is fed by the host, TX is echoed and/or captured
+ */
+class HostSerial : public Print {
+public:
+  void begin(unsigned long baud) { baudRate = baud; }
+  void end() {}
+  operator bool() const { return true; }
+
+  using Print::write;
+  size_t write(uint8_t c) override {
+    if (capture) output += (char)c;
+    if (echo) fputc(c, stdout);
+    return 1;
+  }
+
+  int available() { return (int)(input.size() - inputPos); }
+  int peek() { return available() ? (uint8_t)input[inputPos] : -1; }
+  int read() { return available() ? (uint8_t)input[inputPos++] : -1; }
+  void flush() {}
+  void setTimeout(unsigned long ms) { timeoutMs = ms; }
+
+  // Reads until the terminator; with no more RX data the Stream timeout elapses on the virtual clock
+  String readStringUntil(char terminator) {
+    std::string s;
+    while (true) {
+      if (!available()) {
+        hostAdvanceMs(timeoutMs);
+        break;
+      }
+      char c = (char)read();
+      if (c == terminator) break;
+      s += c;
+    }
+    return String(s);
+  }
+
+  // Host side ------------------------------------------------
+  void hostInject(const char* data) { input.append(data); }
+  std::string hostTakeOutput() { std::string s; s.swap(output); return s; }
+
+  unsigned long baudRate = 0;
+  unsigned long timeoutMs = 1000;
+  bool echo = true;      // Copy TX to stdout
+  bool capture = false;  // Keep TX in memory for hostTakeOutput()
+
+private:
+  std::string input;
+  size_t inputPos = 0;
+  std::string output;
+};
+
+inline HostSerial Serial;
+
+#endif // ARDUINO_H
@@ -0,0 +1,67 @@
+/*
+ * Arduino_LSM9DS1.h - Host shim of the Nano 33 BLE IMU library
+ *
+ * Scripted accelerometer and gyroscope - the host sets the values the
+ * sketch will read next, either directly or through a script callback
+ */
+
+#ifndef ARDUINO_LSM9DS1_H
+#define ARDUINO_LSM9DS1_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Script callback for the IMU - fills acceleration (g) and gyroscope (dps) at a virtual time
+ * @return Whether a new sample is available
+ */
+typedef bool (*HostImuScript)(unsigned long timeUs, float* accel, float* gyro);
+
+class LSM9DS1Class {
+public:
+  int begin() { return beginResult; }
+  void end() {}
+
+  int accelerationAvailable() { return poll(); }
+  int gyroscopeAvailable() { return poll(); }
+  int magneticFieldAvailable() { return 0; }
+
+  int readAcceleration(float& x, float& y, float& z) {
+    poll();
+    x = accel[0]; y = accel[1]; z = accel[2];
+    return 1;
+  }
+
+  int readGyroscope(float& x, float& y, float& z) {
+    poll();
+    x = gyro[0]; y = gyro[1]; z = gyro[2];
+    hostReadCount++;
+    return 1;
+  }
+
+  int readMagneticField(float& x, float& y, float& z) {
+    x = y = z = 0;
+    return 0;
+  }
+
+  float accelerationSampleRate() { return 119.0F; }
+  float gyroscopeSampleRate() { return 119.0F; }
+  float magneticFieldSampleRate() { return 20.0F; }
+
+  // Host side ------------------------------------------------
+  int beginResult = 1;
+  bool available = true;
+  float accel[3] = {0, 0, 1};
+  float gyro[3] = {0, 0, 0};
+  HostImuScript script = nullptr;
+  unsigned long hostReadCount = 0;
+
+private:
+  int poll() {
+    if (script) available = script(micros(), accel, gyro);
+    return available ? 1 : 0;
+  }
+};
+
+inline LSM9DS1Class IMU;
+
+#endif // ARDUINO_LSM9DS1_H
@@ -0,0 +1,66 @@
+/*
+ * LiquidCrystal_I2C.h - Host shim of the I2C character LCD library
+ *
+ * Fake LCD that keeps the displayed characters in memory and counts the
+ * characters sent over the bus, so LCD traffic can be measured on the host
+ */
+
+#ifndef LIQUIDCRYSTAL_I2C_H
+#define LIQUIDCRYSTAL_I2C_H
+
+#include <Arduino.h>
+
+#define HOST_LCD_MAX_COLS 20
+#define HOST_LCD_MAX_ROWS 4
+
+class LiquidCrystal_I2C : public Print {
+public:
+  LiquidCrystal_I2C(uint8_t address, uint8_t cols, uint8_t rows)
+    : address(address), cols(cols), rows(rows) {
+    clear();
+  }
+
+  void init() { clear(); }
+  void begin(uint8_t, uint8_t) { clear(); }
+  void backlight() { backlightOn = true; }
+  void noBacklight() { backlightOn = false; }
+  void display() {}
+  void noDisplay() {}
+
+  void clear() {
+    for (int r = 0; r < HOST_LCD_MAX_ROWS; r++) {
+      memset(frame[r], ' ', HOST_LCD_MAX_COLS);
+      frame[r][HOST_LCD_MAX_COLS] = '\0';
+    }
+    row = col = 0;
+  }
+
+  void setCursor(uint8_t c, uint8_t r) {
+    col = c;
+    row = r;
+    hostCommandCount++;
+  }
+
+  using Print::write;
+  size_t write(uint8_t c) override {
+    if (row < rows && col < cols) frame[row][col] = (char)c;
+    col++;
+    hostCharCount++;
+    return 1;
+  }
+
+  // Host side ------------------------------------------------
+  const char* hostLine(int r) const { return (r >= 0 && r < HOST_LCD_MAX_ROWS) ? frame[r] : ""; }
+
+  uint8_t address;
+  uint8_t cols, rows;
+  bool backlightOn = false;
+  unsigned long hostCharCount = 0;
+  unsigned long hostCommandCount = 0;
+
+private:
+  char frame[HOST_LCD_MAX_ROWS][HOST_LCD_MAX_COLS + 1];
+  uint8_t row = 0, col = 0;
+};
+
+#endif // LIQUIDCRYSTAL_I2C_H
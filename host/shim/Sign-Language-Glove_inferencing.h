@@ -0,0 +1,139 @@
+/*
+ * Sign-Language-Glove_inferencing.h - Host stub of the Edge Impulse library
+ *
+ * Mirrors the types and macros the sketch uses from the exported Edge Impulse
+ * library. run_classifier() is a stand-in: by default a nearest-centroid
+ * classifier over the mean bend of each finger, replaceable by the host. The
+ * mean is found in the input through the sketch's feature spec.
+ */
+
+#ifndef SIGN_LANGUAGE_GLOVE_INFERENCING_H
+#define SIGN_LANGUAGE_GLOVE_INFERENCING_H
+
+#include <Arduino.h>
+#include <functional>
+#include "feature_spec.h"
+
+#define EI_CLASSIFIER_PROJECT_NAME "Sign-Language-Glove"
+#define EI_CLASSIFIER_PROJECT_ID 0
+// Input size of the stand-in model - override to match a non-default window channel list
+#ifndef EI_CLASSIFIER_NN_INPUT_FRAME_SIZE
+#define EI_CLASSIFIER_NN_INPUT_FRAME_SIZE 35
+#endif
+#define EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE EI_CLASSIFIER_NN_INPUT_FRAME_SIZE
+#define EI_CLASSIFIER_LABEL_COUNT 6
+#define EI_CLASSIFIER_HAS_ANOMALY 0
+
+typedef enum {
+  EI_IMPULSE_OK = 0,
+  EI_IMPULSE_ERROR_SHAPES_DONT_MATCH = -1,
+  EI_IMPULSE_CANCELED = -2,
+  EI_IMPULSE_TFLITE_ERROR = -3,
+  EI_IMPULSE_DSP_ERROR = -5,
+  EI_IMPULSE_OUT_OF_MEMORY = -8
+} EI_IMPULSE_ERROR;
+
+typedef struct {
+  const char* label;
+  float value;
+} ei_impulse_result_classification_t;
+
+typedef struct {
+  int sampling;
+  int dsp;
+  int classification;
+  int anomaly;
+} ei_impulse_result_timing_t;
+
+typedef struct {
+  ei_impulse_result_classification_t classification[EI_CLASSIFIER_LABEL_COUNT];
+  float anomaly;
+  ei_impulse_result_timing_t timing;
+} ei_impulse_result_t;
+
+typedef struct {
+  std::function<int(size_t offset, size_t length, float* out_ptr)> get_data;
+  size_t total_length;
+} signal_t;
+
+// Labels in the order Edge Impulse exports them (alphabetical)
+inline const char* ei_classifier_inferencing_categories[EI_CLASSIFIER_LABEL_COUNT] = {
+  "five", "four", "love", "one", "three", "two"
+};
+
+/**
+ * @brief Host classifier hook - fills result->classification[i].value from the feature vector
+ */
+typedef EI_IMPULSE_ERROR (*HostClassifier)(const float* features, size_t count, ei_impulse_result_t* result);
+
+/**
+ * @brief Position of a statistic in the feature spec, -1 if it is not listed
+ */
+constexpr int hostStatisticOffset(Statistic stat, int i = 0) {
+  return i == WindowFeatures::COUNT ? -1 : WindowFeatures::ORDER[i] == stat ? i : hostStatisticOffset(stat, i + 1);
+}
+
+/**
+ * @brief Default stand-in model: softmax over distances to per-label mean bend poses
+ */
+inline EI_IMPULSE_ERROR hostCentroidClassifier(const float* features, size_t count, ei_impulse_result_t* result) {
+  // Mean bend (%) per finger {thumb, index, middle, ring, pinky} for each label
+  static const float poses[EI_CLASSIFIER_LABEL_COUNT][5] = {
+    {0, 0, 0, 0, 0},           // five
+    {100, 0, 0, 0, 0},         // four
+    {0, 100, 100, 100, 0},     // love
+    {100, 0, 100, 100, 100},   // one
+    {0, 0, 0, 100, 100},       // three
+    {100, 0, 0, 100, 100}      // two
+  };
+  const float sigma = 20.0F;
+  // Features are grouped by channel, the statistics of the feature spec each, with the five fingers first
+  constexpr int statsPerSensor = EI_CLASSIFIER_NN_INPUT_FRAME_SIZE / WINDOW_CHANNEL_COUNT;
+  constexpr int meanOffset = hostStatisticOffset(STAT_MEAN);
+  static_assert(statsPerSensor == WindowFeatures::COUNT,
+                "EI_CLASSIFIER_NN_INPUT_FRAME_SIZE must be the window channels times the statistics of the feature spec");
+  static_assert(meanOffset >= 0, "the stand-in classifier needs STAT_MEAN in WINDOW_STATISTICS");
+  if (count != EI_CLASSIFIER_NN_INPUT_FRAME_SIZE) return EI_IMPULSE_ERROR_SHAPES_DONT_MATCH;
+
+  float scores[EI_CLASSIFIER_LABEL_COUNT];
+  float total = 0;
+  for (int label = 0; label < EI_CLASSIFIER_LABEL_COUNT; label++) {
+    float dist2 = 0;
+    for (int finger = 0; finger < 5; finger++) {
+      float d = features[finger * statsPerSensor + meanOffset] - poses[label][finger];
+      dist2 += d * d;
+    }
+    scores[label] = expf(-dist2 / (2 * sigma * sigma));
+    total += scores[label];
+  }
+
+  for (int label = 0; label < EI_CLASSIFIER_LABEL_COUNT; label++) {
+    result->classification[label].value = total > 0 ? scores[label] / total : 0;
+  }
+  return EI_IMPULSE_OK;
+}
+
+inline HostClassifier hostClassifier = hostCentroidClassifier;
+inline unsigned long hostClassifierCallCount = 0;
+
+inline EI_IMPULSE_ERROR run_classifier(signal_t* signal, ei_impulse_result_t* result, bool debug = false) {
+  (void)debug;
+  hostClassifierCallCount++;
+
+  if (signal->total_length != EI_CLASSIFIER_NN_INPUT_FRAME_SIZE) {
+    return EI_IMPULSE_ERROR_SHAPES_DONT_MATCH;
+  }
+
+  float features[EI_CLASSIFIER_NN_INPUT_FRAME_SIZE];
+  if (signal->get_data(0, signal->total_length, features) != 0) {
+    return EI_IMPULSE_DSP_ERROR;
+  }
+
+  memset(result, 0, sizeof(*result));
+  for (int i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+    result->classification[i].label = ei_classifier_inferencing_categories[i];
+  }
+  return hostClassifier(features, signal->total_length, result);
+}
+
+#endif // SIGN_LANGUAGE_GLOVE_INFERENCING_H
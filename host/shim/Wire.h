@@ -0,0 +1,18 @@
+/*
+ * Wire.h - Host shim of the Arduino I2C library
+ */
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  void begin() {}
+  void setClock(uint32_t) {}
+};
+
+inline TwoWire Wire;
+
+#endif // WIRE_H
@@ -0,0 +1,78 @@
+/*
+ * host_hal.h - Host Hardware Abstraction Layer
+ *
+ * Virtual clock, scripted ADC and digital pin state used by the Arduino
+ * shim headers when the sketch is built natively on Linux
+ */
+
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Number of emulated analog/digital pins
+#define HOST_PIN_COUNT 32
+
+/**
+ * @brief Script callback for analogRead - returns the ADC value of a pin at a virtual time
+ */
+typedef int (*HostAdcScript)(int pin, unsigned long timeUs);
+
+// Virtual clock in microseconds - only advances through delay() or hostAdvance*()
+// Atomic so the ADC sampler thread can follow it
+inline std::atomic<unsigned long long> hostTimeUs(0);
+
+// Static ADC values, used when no script is installed
+inline int hostAnalogValues[HOST_PIN_COUNT] = {0};
+
+// Optional ADC script, takes precedence over hostAnalogValues
+inline HostAdcScript hostAdcScript = nullptr;
+
+// Digital pin state and modes
+inline int hostDigitalValues[HOST_PIN_COUNT] = {0};
+inline int hostPinModes[HOST_PIN_COUNT] = {0};
+
+// Call counters, useful when profiling the sketch
+inline unsigned long hostAnalogReadCount = 0;
+inline unsigned long hostDelayCount = 0;
+
+/**
+ * @brief Advance the virtual clock by a number of milliseconds
+ */
+inline void hostAdvanceMs(unsigned long ms) {
+  hostTimeUs += (unsigned long long)ms * 1000ULL;
+}
+
+/**
+ * @brief Advance the virtual clock by a number of microseconds
+ */
+inline void hostAdvanceUs(unsigned long us) {
+  hostTimeUs += us;
+}
+
+/**
+ * @brief Set the static ADC value of a pin
+ */
+inline void hostSetAnalog(int pin, int value) {
+  if (pin >= 0 && pin < HOST_PIN_COUNT) {
+    hostAnalogValues[pin] = value;
+  }
+}
+
+/**
+ * @brief Reset clock, pins and counters to their power-on state
+ */
+inline void hostReset() {
+  hostTimeUs = 0;
+  hostAdcScript = nullptr;
+  for (int i = 0; i < HOST_PIN_COUNT; i++) {
+    hostAnalogValues[i] = 0;
+    hostDigitalValues[i] = 0;
+    hostPinModes[i] = 0;
+  }
+  hostAnalogReadCount = 0;
+  hostDelayCount = 0;
+}
+
+#endif // HOST_HAL_H
@@ -0,0 +1,101 @@
+/*
+ * mbed.h - Host shim of the Mbed OS internal flash API (mbed::FlashIAP)
+ *
+ * The flash is an in-memory image of HOST_FLASH_SIZE bytes in sectors of
+ * HOST_FLASH_SECTOR_SIZE. It behaves like NOR flash: erasing sets a whole
+ * sector to 0xFF and programming can only clear bits. When hostFlashPath is
+ * set, the image is loaded from that file on first use and written back
+ * after every erase or program, so stored data survives across runs as it
+ * survives a reset on the board. hostReset() leaves the flash alone.
+ */
+
+#ifndef MBED_H
+#define MBED_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HOST_FLASH_SIZE (64 * 1024)
+#define HOST_FLASH_SECTOR_SIZE 4096
+#define HOST_FLASH_PAGE_SIZE 4
+
+// File backing the flash image, nullptr to keep it in memory only
+inline const char* hostFlashPath = nullptr;
+
+// Flash image and whether it has been initialized (erased, then loaded from hostFlashPath)
+inline uint8_t hostFlashImage[HOST_FLASH_SIZE];
+inline bool hostFlashLoaded = false;
+
+// Operation counters
+inline unsigned long hostFlashEraseCount = 0;
+inline unsigned long hostFlashProgramCount = 0;
+
+/**
+ * @brief Write the flash image to hostFlashPath, if set
+ */
+inline bool hostFlashSave() {
+  if (!hostFlashPath) return true;
+  FILE* file = fopen(hostFlashPath, "wb");
+  if (!file) return false;
+  bool written = fwrite(hostFlashImage, 1, HOST_FLASH_SIZE, file) == HOST_FLASH_SIZE;
+  return fclose(file) == 0 && written;
+}
+
+namespace mbed {
+
+class FlashIAP {
+public:
+  int init() {
+    if (!hostFlashLoaded) {
+      memset(hostFlashImage, 0xFF, HOST_FLASH_SIZE);
+      if (hostFlashPath) {
+        if (FILE* file = fopen(hostFlashPath, "rb")) {
+          size_t length = fread(hostFlashImage, 1, HOST_FLASH_SIZE, file);
+          (void)length;
+          fclose(file);
+        }
+      }
+      hostFlashLoaded = true;
+    }
+    return 0;
+  }
+
+  int deinit() { return 0; }
+
+  int read(void* buffer, uint32_t addr, uint32_t size) {
+    if (!inRange(addr, size)) return -1;
+    memcpy(buffer, hostFlashImage + addr, size);
+    return 0;
+  }
+
+  int program(const void* buffer, uint32_t addr, uint32_t size) {
+    if (!inRange(addr, size) || addr % HOST_FLASH_PAGE_SIZE || size % HOST_FLASH_PAGE_SIZE) return -1;
+    const uint8_t* bytes = (const uint8_t*)buffer;
+    for (uint32_t i = 0; i < size; i++) hostFlashImage[addr + i] &= bytes[i];
+    hostFlashProgramCount++;
+    return hostFlashSave() ? 0 : -1;
+  }
+
+  int erase(uint32_t addr, uint32_t size) {
+    if (!inRange(addr, size) || addr % HOST_FLASH_SECTOR_SIZE || size % HOST_FLASH_SECTOR_SIZE) return -1;
+    memset(hostFlashImage + addr, 0xFF, size);
+    hostFlashEraseCount++;
+    return hostFlashSave() ? 0 : -1;
+  }
+
+  uint32_t get_page_size() const { return HOST_FLASH_PAGE_SIZE; }
+  uint32_t get_sector_size(uint32_t) const { return HOST_FLASH_SECTOR_SIZE; }
+  uint32_t get_flash_start() const { return 0; }
+  uint32_t get_flash_size() const { return HOST_FLASH_SIZE; }
+  uint8_t get_erase_value() const { return 0xFF; }
+
+private:
+  static bool inRange(uint32_t addr, uint32_t size) {
+    return addr <= HOST_FLASH_SIZE && size <= HOST_FLASH_SIZE - addr;
+  }
+};
+
+} // namespace mbed
+
+#endif // MBED_H
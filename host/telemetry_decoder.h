@@ -0,0 +1,224 @@
+/*
+ * telemetry_decoder.h - Binary Telemetry Decoding
+ *
+ * Turns the binary capture stream of calibrated_data_collection.ino
+ * (USE_BINARY_TELEMETRY, frame format in telemetry.h) back into samples.
+ * Bytes between frames - text printed by the sketch, or the remains of a
+ * corrupted frame - are skipped by resynchronizing on the next valid frame.
+ * A gap in the sequence numbers counts as lost frames, and delta frames are
+ * dropped until the next key frame restores absolute values.
+ *
+ * The samples can then be calibrated and filtered exactly as the sketch
+ * does for its CSV output, giving the 11-column Edge Impulse CSV, or
+ * loaded as a raw session for replay through the recognition sketch.
+ */
+
+#ifndef TELEMETRY_DECODER_H
+#define TELEMETRY_DECODER_H
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "csv_session.h"
+#include "telemetry.h"
+
+// Stream decoder state and counters
+struct TelemetryDecoder {
+  std::vector<uint8_t> pending;   // Received bytes not yet decoded
+  bool haveInfo = false;
+  TelemetryInfo info = {};        // Latest capture settings
+  bool haveBase = false;          // previous holds absolute values, so delta frames can be decoded
+  TelemetrySample previous = {};
+  bool haveSequence = false;
+  uint16_t nextSequence = 0;
+
+  unsigned long frames = 0;          // Valid frames
+  unsigned long samples = 0;         // Decoded samples
+  unsigned long crcErrors = 0;       // Frame candidates rejected by their CRC
+  unsigned long skippedBytes = 0;    // Bytes outside valid frames
+  unsigned long lostFrames = 0;      // Sequence numbers never received
+  unsigned long droppedDeltas = 0;   // Delta frames without a base sample
+};
+
+// Low-pass filter state for the CSV conversion
+struct TelemetryFilter {
+  bool primed = false;
+  float values[TELEMETRY_CHANNELS] = {};
+};
+
+inline uint16_t getU16(const uint8_t* in) {
+  return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+inline uint32_t getU32(const uint8_t* in) {
+  return getU16(in) | ((uint32_t)getU16(in + 2) << 16);
+}
+
+/**
+ * @brief Decode the payload of a valid frame
+ * @return Whether it produced a sample
+ */
+inline bool decodeTelemetryPayload(TelemetryDecoder* decoder, uint8_t type, const uint8_t* payload,
+                                   size_t length, TelemetrySample* sample) {
+  const uint8_t* end = payload + length;
+
+  if (type == TELEMETRY_FRAME_INFO) {
+    if (length < 27 || payload[0] != TELEMETRY_VERSION) return false;
+    decoder->info.sampleRateHz = getU16(payload + 1);
+    decoder->info.alphaQ16 = getU32(payload + 3);
+    for (int i = 0; i < 5; i++) {
+      decoder->info.straightAdc[i] = (int16_t)getU16(payload + 7 + 2 * i);
+      decoder->info.bentAdc[i] = (int16_t)getU16(payload + 17 + 2 * i);
+    }
+    decoder->haveInfo = true;
+    return false;
+  }
+
+  if (type == TELEMETRY_FRAME_KEY) {
+    if (length < 4 + 2 * TELEMETRY_CHANNELS) return false;
+    sample->timeUs = getU32(payload);
+    for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+      sample->values[i] = (int16_t)getU16(payload + 4 + 2 * i);
+    }
+  } else if (type == TELEMETRY_FRAME_DELTA) {
+    if (!decoder->haveBase) {
+      decoder->droppedDeltas++;
+      return false;
+    }
+    uint32_t value;
+    size_t used = getVarint(payload, end, &value);
+    if (used == 0) return false;
+    payload += used;
+    sample->timeUs = decoder->previous.timeUs + value;
+    for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+      used = getVarint(payload, end, &value);
+      if (used == 0) return false;
+      payload += used;
+      sample->values[i] = (int16_t)(decoder->previous.values[i] + zigzagDecode(value));
+    }
+  } else {
+    return false;
+  }
+
+  decoder->previous = *sample;
+  decoder->haveBase = true;
+  decoder->samples++;
+  return true;
+}
+
+/**
+ * @brief Feed received bytes to the decoder
+ * @param samples Receives the samples of every complete frame
+ */
+inline void feedTelemetry(TelemetryDecoder* decoder, const uint8_t* data, size_t length,
+                          std::vector<TelemetrySample>* samples) {
+  std::vector<uint8_t>& pending = decoder->pending;
+  pending.insert(pending.end(), data, data + length);
+
+  size_t pos = 0;
+  while (pending.size() - pos >= TELEMETRY_HEADER_SIZE) {
+    const uint8_t* frame = pending.data() + pos;
+    size_t payloadLength = frame[3];
+    if (frame[0] != TELEMETRY_SYNC_0 || frame[1] != TELEMETRY_SYNC_1 || payloadLength > TELEMETRY_MAX_PAYLOAD) {
+      decoder->skippedBytes++;
+      pos++;
+      continue;
+    }
+
+    size_t frameLength = TELEMETRY_HEADER_SIZE + payloadLength + 2;
+    if (pending.size() - pos < frameLength) break;
+
+    uint16_t crc = getU16(frame + TELEMETRY_HEADER_SIZE + payloadLength);
+    if (crc != telemetryCrc16(frame + 2, TELEMETRY_HEADER_SIZE - 2 + payloadLength)) {
+      // Not a frame after all, or a corrupted one - look for the next sync from the following byte
+      decoder->crcErrors++;
+      decoder->skippedBytes++;
+      pos++;
+      continue;
+    }
+
+    uint16_t sequence = getU16(frame + 4);
+    if (decoder->haveSequence && sequence != decoder->nextSequence) {
+      decoder->lostFrames += (uint16_t)(sequence - decoder->nextSequence);
+      decoder->haveBase = false;
+    }
+    decoder->haveSequence = true;
+    decoder->nextSequence = sequence + 1;
+    decoder->frames++;
+
+    TelemetrySample sample;
+    if (decodeTelemetryPayload(decoder, frame[2], frame + TELEMETRY_HEADER_SIZE, payloadLength, &sample)) {
+      samples->push_back(sample);
+    }
+    pos += frameLength;
+  }
+
+  pending.erase(pending.begin(), pending.begin() + pos);
+}
+
+/**
+ * @brief Convert a sample to the sketch's CSV values: filtered bend (%), acceleration (g) and rate (dps)
+ * @note Uses the same integer map() and float filter as calibrated_data_collection.ino; the
+ *       filter starts from the first sample instead of from zero
+ */
+inline void telemetryToCsvValues(const TelemetryInfo& info, const TelemetrySample& sample,
+                                 TelemetryFilter* filter, float* values) {
+  float input[TELEMETRY_CHANNELS];
+  for (int i = 0; i < 5; i++) {
+    long lo = info.straightAdc[i] < info.bentAdc[i] ? info.straightAdc[i] : info.bentAdc[i];
+    long hi = info.straightAdc[i] < info.bentAdc[i] ? info.bentAdc[i] : info.straightAdc[i];
+    long adc = sample.values[i] < lo ? lo : (sample.values[i] > hi ? hi : sample.values[i]);
+    long range = info.bentAdc[i] - info.straightAdc[i];
+    long bend = range != 0 ? (adc - info.straightAdc[i]) * 100 / range : 0;
+    input[i] = (float)(bend < 0 ? 0 : (bend > 100 ? 100 : bend));
+  }
+  for (int i = 0; i < 3; i++) {
+    input[5 + i] = sample.values[5 + i] / TELEMETRY_ACCEL_LSB_PER_G;
+    input[8 + i] = sample.values[8 + i] / TELEMETRY_GYRO_LSB_PER_DPS;
+  }
+
+  float alpha = info.alphaQ16 / 65536.0F;
+  for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+    if (!filter->primed) filter->values[i] = input[i];
+    filter->values[i] = filter->values[i] + alpha * (input[i] - filter->values[i]);
+    values[i] = filter->values[i];
+  }
+  filter->primed = true;
+}
+
+/**
+ * @brief Load a binary telemetry capture as a raw session (flex ADC readings, IMU in g and dps)
+ * @return Whether the file could be read and contained at least one sample
+ */
+inline bool loadTelemetrySession(const char* path, CsvSession* session) {
+  FILE* file = fopen(path, "rb");
+  if (!file) return false;
+
+  TelemetryDecoder decoder;
+  std::vector<TelemetrySample> samples;
+  uint8_t buffer[4096];
+  size_t length;
+  while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    feedTelemetry(&decoder, buffer, length, &samples);
+  }
+  fclose(file);
+
+  session->path = path;
+  session->label = csvLabelFromPath(path);
+  session->raw = true;
+  session->samples.clear();
+  for (const TelemetrySample& sample : samples) {
+    CsvSample row;
+    row.timeMs = (sample.timeUs - samples[0].timeUs) / 1000;
+    for (int i = 0; i < 5; i++) row.values[i] = sample.values[i];
+    for (int i = 0; i < 3; i++) {
+      row.values[5 + i] = sample.values[5 + i] / TELEMETRY_ACCEL_LSB_PER_G;
+      row.values[8 + i] = sample.values[8 + i] / TELEMETRY_GYRO_LSB_PER_DPS;
+    }
+    session->samples.push_back(row);
+  }
+  return !session->samples.empty();
+}
+
+#endif // TELEMETRY_DECODER_H